@@ -0,0 +1,72 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark.h"
+
+// Replaces the global allocation functions to count allocations. Sized and
+// array forms forward to these.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+std::atomic<std::uint64_t> allocation_count{0};
+std::atomic<std::uint64_t> allocated_bytes{0};
+
+} // namespace
+
+// AllocationCount
+//
+std::uint64_t AllocationCount() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+// AllocatedBytes
+//
+std::uint64_t AllocatedBytes() {
+  return allocated_bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
+
+void* operator new(std::size_t size) {
+  using namespace arg_parse_convert::benchmark;
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {std::free(pointer);}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
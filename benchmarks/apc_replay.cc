@@ -0,0 +1,241 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Replays inputs captured by `TraceWriter` against a serialized schema and
+// reports throughput, latency percentiles and allocations.
+//
+// Usage: apc-replay [--schema=FILE] [--repeat=N] [--convert] TRACE...
+//
+// The schema is the first schema record of FILE, or else of the traces.
+// Conversion functions cannot be serialized, so parameters convert to
+// strings; `--convert` additionally converts all arguments after parsing.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+struct Options {
+  std::string schema_path;
+  std::vector<std::string> trace_paths;
+  int repeat{1};
+  bool convert{false};
+};
+
+// An input ready to be parsed.
+//
+struct Input {
+  TraceRecordKind kind;
+  std::vector<std::string> arguments;
+  std::vector<const char*> argv;
+  std::string file;
+  std::size_t bytes{0};
+};
+
+struct Measurement {
+  std::chrono::nanoseconds elapsed;
+  std::uint64_t allocations;
+  std::uint64_t allocated_bytes;
+  bool failed;
+};
+
+// Appends the schema and inputs recorded in the trace at `path`.
+//
+void ReadTrace(const std::string& path, std::vector<std::string>& schema,
+               std::vector<Input>& inputs) {
+  std::ifstream ifs{path, std::ios::binary};
+  if (!ifs.is_open()) {
+    throw std::runtime_error("Unable to open trace: " + path);
+  }
+  TraceReader reader{ifs};
+  TraceRecord record;
+  while (reader.Next(record)) {
+    if (record.kind == TraceRecordKind::kSchema) {
+      if (schema.empty()) {
+        schema = std::move(record.tokens);
+      }
+      continue;
+    }
+    Input& input{inputs.emplace_back()};
+    input.kind = record.kind;
+    for (const std::string& token : record.tokens) {
+      input.bytes += token.size();
+    }
+    if (record.kind == TraceRecordKind::kArguments) {
+      input.arguments = std::move(record.tokens);
+      for (const std::string& argument : input.arguments) {
+        input.argv.push_back(argument.c_str());
+      }
+    } else {
+      for (const std::string& line : record.tokens) {
+        input.file.append(line).push_back('\n');
+      }
+    }
+  }
+}
+
+Measurement Replay(const std::shared_ptr<const ParameterMap>& schema,
+                   Input& input, bool convert) {
+  std::istringstream iss{input.file};
+  Measurement result{};
+  std::uint64_t allocations{AllocationCount()};
+  std::uint64_t allocated_bytes{AllocatedBytes()};
+  auto start = std::chrono::steady_clock::now();
+  try {
+    ArgumentMap argument_map{schema};
+    if (input.kind == TraceRecordKind::kArguments) {
+      ParseArgs(input.argv.size(), input.argv.data(), argument_map);
+    } else {
+      ParseFile(iss, argument_map);
+    }
+    if (convert) {
+      argument_map.ConvertAll();
+    }
+  } catch (const exceptions::BaseError&) {
+    result.failed = true;
+  }
+  result.elapsed = std::chrono::steady_clock::now() - start;
+  result.allocations = AllocationCount() - allocations;
+  result.allocated_bytes = AllocatedBytes() - allocated_bytes;
+  return result;
+}
+
+// Returns the `fraction` quantile of sorted `latencies`.
+//
+std::chrono::nanoseconds Percentile(
+    const std::vector<std::chrono::nanoseconds>& latencies, double fraction) {
+  std::size_t index{static_cast<std::size_t>(fraction * latencies.size())};
+  return latencies[std::min(index, latencies.size() - 1)];
+}
+
+int Run(const Options& options) {
+  std::vector<std::string> schema_tokens;
+  std::vector<Input> inputs;
+  if (!options.schema_path.empty()) {
+    std::vector<Input> ignored;
+    ReadTrace(options.schema_path, schema_tokens, ignored);
+  }
+  for (const std::string& path : options.trace_paths) {
+    ReadTrace(path, schema_tokens, inputs);
+  }
+  if (schema_tokens.empty()) {
+    std::cerr << "No schema record found." << std::endl;
+    return 1;
+  }
+  if (inputs.empty()) {
+    std::cerr << "No inputs found." << std::endl;
+    return 1;
+  }
+  auto schema = std::make_shared<const ParameterMap>(
+      DeserializeSchema(schema_tokens));
+
+  std::vector<std::chrono::nanoseconds> latencies;
+  latencies.reserve(inputs.size() * options.repeat);
+  std::chrono::nanoseconds total{0};
+  std::uint64_t allocations{0}, allocated_bytes{0}, failures{0};
+  std::uint64_t tokens{0}, bytes{0};
+  for (int i = 0; i < options.repeat; ++i) {
+    for (Input& input : inputs) {
+      Measurement measurement{Replay(schema, input, options.convert)};
+      latencies.push_back(measurement.elapsed);
+      total += measurement.elapsed;
+      allocations += measurement.allocations;
+      allocated_bytes += measurement.allocated_bytes;
+      failures += measurement.failed;
+      tokens += (input.kind == TraceRecordKind::kArguments
+                     ? input.arguments.size()
+                     : std::count(input.file.begin(), input.file.end(), '\n'));
+      bytes += input.bytes;
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  double records{static_cast<double>(latencies.size())};
+  double seconds{total.count() / 1e9};
+  std::cout << std::fixed << std::setprecision(1)
+            << "schema parameters:  " << schema->size() << '\n'
+            << "records replayed:   " << latencies.size() << " ("
+            << failures << " failed)\n"
+            << "records/s:          " << records / seconds << '\n'
+            << "tokens/s:           " << tokens / seconds << '\n'
+            << "MB/s:               " << bytes / seconds / 1e6 << '\n'
+            << "latency p50 (ns):   " << Percentile(latencies, 0.5).count()
+            << '\n'
+            << "latency p90 (ns):   " << Percentile(latencies, 0.9).count()
+            << '\n'
+            << "latency p99 (ns):   " << Percentile(latencies, 0.99).count()
+            << '\n'
+            << "latency p99.9 (ns): " << Percentile(latencies, 0.999).count()
+            << '\n'
+            << "latency max (ns):   " << latencies.back().count() << '\n'
+            << "allocs/record:      " << allocations / records << '\n'
+            << "bytes/record:       " << allocated_bytes / records
+            << std::endl;
+  return 0;
+}
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
+
+int main(int argc, const char** argv) {
+  using namespace arg_parse_convert::benchmark;
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--schema=", 9) == 0) {
+      options.schema_path = argv[i] + 9;
+    } else if (std::strncmp(argv[i], "--repeat=", 9) == 0) {
+      options.repeat = std::max(1, std::atoi(argv[i] + 9));
+    } else if (std::strcmp(argv[i], "--convert") == 0) {
+      options.convert = true;
+    } else {
+      options.trace_paths.push_back(argv[i]);
+    }
+  }
+  if (options.trace_paths.empty()) {
+    std::cerr << "Usage: apc-replay [--schema=FILE] [--repeat=N] [--convert]"
+                 " TRACE..." << std::endl;
+    return 1;
+  }
+  try {
+    return Run(options);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_BENCHMARKS_BENCHMARK_H_
+#define ARG_PARSE_CONVERT_BENCHMARKS_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+/// @brief Returns the number of allocations made through the global
+///  `operator new` since program start, by all threads.
+///
+std::uint64_t AllocationCount();
+
+/// @brief Returns the number of bytes allocated through the global
+///  `operator new` since program start, by all threads.
+///
+std::uint64_t AllocatedBytes();
+
+/// @brief Controls the timed loop of a benchmark and collects its results.
+///
+/// @details Benchmark functions run their measured code inside
+///  `while (state.KeepRunning())`. Setup that should not be measured can be
+///  excluded with `PauseTiming` and `ResumeTiming`. Allocations are counted
+///  only while the timer runs.
+///
+class State {
+ public:
+  State(std::int64_t max_iterations, std::int64_t arg)
+      : max_iterations_{max_iterations}, arg_{arg} {}
+
+  /// @brief Returns true while more iterations should be run.
+  ///
+  inline bool KeepRunning() {
+    if (iterations_ == 0) {
+      ResumeTiming();
+    }
+    if (iterations_ < max_iterations_) {
+      ++iterations_;
+      return true;
+    }
+    PauseTiming();
+    return false;
+  }
+
+  /// @brief Stops the timer.
+  ///
+  inline void PauseTiming() {
+    elapsed_ += std::chrono::steady_clock::now() - start_;
+    allocations_ += AllocationCount() - start_allocations_;
+    allocated_bytes_ += AllocatedBytes() - start_allocated_bytes_;
+  }
+
+  /// @brief Restarts the timer.
+  ///
+  inline void ResumeTiming() {
+    start_allocations_ = AllocationCount();
+    start_allocated_bytes_ = AllocatedBytes();
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  /// @brief Returns the argument the benchmark was registered with.
+  ///
+  inline std::int64_t arg() const {return arg_;}
+
+  /// @brief Returns the number of iterations run so far.
+  ///
+  inline std::int64_t iterations() const {return iterations_;}
+
+  /// @brief Returns the measured time.
+  ///
+  inline std::chrono::nanoseconds elapsed() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed_);
+  }
+
+  /// @brief Sets the total number of items processed over all iterations, for
+  ///  reporting throughput.
+  ///
+  inline void SetItemsProcessed(std::int64_t items) {items_ = items;}
+
+  /// @brief Returns the total number of items processed.
+  ///
+  inline std::int64_t items_processed() const {return items_;}
+
+  /// @brief Returns the number of allocations made while the timer ran.
+  ///
+  inline std::uint64_t allocations() const {return allocations_;}
+
+  /// @brief Returns the number of bytes allocated while the timer ran.
+  ///
+  inline std::uint64_t allocated_bytes() const {return allocated_bytes_;}
+
+ private:
+  std::int64_t max_iterations_;
+  std::int64_t arg_;
+  std::int64_t iterations_{0};
+  std::int64_t items_{0};
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::duration elapsed_{0};
+  std::uint64_t start_allocations_{0};
+  std::uint64_t start_allocated_bytes_{0};
+  std::uint64_t allocations_{0};
+  std::uint64_t allocated_bytes_{0};
+};
+
+using BenchmarkFunction = void (*)(State&);
+
+/// @brief Registers `function` to be run once for each of `args`.
+///
+/// @details Returns a dummy value so registration can happen during static
+///  initialization.
+///
+int RegisterBenchmark(const char* name, BenchmarkFunction function,
+                      std::vector<std::int64_t> args = {0});
+
+/// @brief Prevents the compiler from optimizing away the computation of
+///  `value`.
+///
+template <class T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
+
+/// @brief Registers a benchmark function, optionally with a list of arguments.
+///
+#define ARG_PARSE_CONVERT_BENCHMARK(function, ...) \
+  static int function##_registration{ \
+      ::arg_parse_convert::benchmark::RegisterBenchmark( \
+          #function, function, {__VA_ARGS__})}
+
+#endif // ARG_PARSE_CONVERT_BENCHMARKS_BENCHMARK_H_
\ No newline at end of file
@@ -0,0 +1,193 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+struct Registration {
+  const char* name;
+  BenchmarkFunction function;
+  std::vector<std::int64_t> args;
+};
+
+// Function-local static avoids depending on static initialization order of
+// the translation units registering benchmarks.
+//
+std::vector<Registration>& Registry() {
+  static std::vector<Registration> registry;
+  return registry;
+}
+
+// Runs `function` with increasing iteration counts until a run takes at least
+// `min_time`, and returns the state of the last run.
+//
+State Run(BenchmarkFunction function, std::int64_t arg,
+          std::chrono::nanoseconds min_time) {
+  std::int64_t iterations{1};
+  while (true) {
+    State state{iterations, arg};
+    function(state);
+    if (state.elapsed() >= min_time || iterations >= 1000000000) {
+      return state;
+    }
+    // Aim for 1.5 times the minimum time, growing at most 100-fold per round.
+    double factor{state.elapsed().count() > 0
+                  ? 1.5 * min_time.count() / state.elapsed().count()
+                  : 100.0};
+    iterations = std::max(iterations + 1, static_cast<std::int64_t>(
+        iterations * std::min(factor, 100.0)));
+  }
+}
+
+// Results of a benchmark run, per operation.
+//
+struct Result {
+  std::string name;
+  std::int64_t iterations;
+  double ns_per_op;
+  double allocations_per_op;
+  double bytes_per_op;
+  double items_per_second;
+};
+
+Result Summarize(const std::string& name, const State& state) {
+  double iterations{static_cast<double>(state.iterations())};
+  double elapsed{static_cast<double>(state.elapsed().count())};
+  return Result{name, state.iterations(), elapsed / iterations,
+                state.allocations() / iterations,
+                state.allocated_bytes() / iterations,
+                elapsed > 0 ? state.items_processed() * 1e9 / elapsed : 0.0};
+}
+
+// Writes `results` as a JSON object which can be compared between runs.
+//
+void WriteJson(std::ostream& os, const std::vector<Result>& results,
+               std::chrono::nanoseconds min_time) {
+  os << "{\n  \"context\": {\"min_time_ns\": " << min_time.count()
+     << ", \"unix_time\": "
+     << std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()
+     << "},\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& result{results[i]};
+    os << (i > 0 ? "," : "") << "\n    {\"name\": \"" << result.name
+       << "\", \"iterations\": " << result.iterations
+       << std::setprecision(17)
+       << ", \"ns_per_op\": " << result.ns_per_op
+       << ", \"allocs_per_op\": " << result.allocations_per_op
+       << ", \"bytes_per_op\": " << result.bytes_per_op
+       << ", \"items_per_second\": " << result.items_per_second << '}';
+  }
+  os << "\n  ]\n}\n";
+}
+
+} // namespace
+
+// RegisterBenchmark
+//
+int RegisterBenchmark(const char* name, BenchmarkFunction function,
+                      std::vector<std::int64_t> args) {
+  if (args.empty()) {
+    args.push_back(0);
+  }
+  Registry().push_back(Registration{name, function, std::move(args)});
+  return 0;
+}
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
+
+// Usage: arg_parse_convert_benchmarks [--min_time=SECONDS] [--json=FILE]
+//                                     [FILTER]
+//
+// Runs all benchmarks whose name contains FILTER, prints a table, and, if
+// requested, writes the results as JSON to FILE ("-" for standard output,
+// in which case the table is omitted).
+//
+int main(int argc, const char** argv) {
+  using namespace arg_parse_convert::benchmark;
+  std::chrono::nanoseconds min_time{std::chrono::milliseconds{500}};
+  std::string filter, json_path;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--min_time=", 11) == 0) {
+      min_time = std::chrono::nanoseconds{
+          static_cast<std::int64_t>(std::atof(argv[i] + 11) * 1e9)};
+    } else if (std::strncmp(argv[i], "--json=", 7) == 0) {
+      json_path = argv[i] + 7;
+    } else {
+      filter = argv[i];
+    }
+  }
+  bool print_table{json_path != "-"};
+
+  if (print_table) {
+    std::cout << std::left << std::setw(48) << "benchmark" << std::right
+              << std::setw(12) << "iterations" << std::setw(14) << "ns/op"
+              << std::setw(12) << "allocs/op" << std::setw(14) << "bytes/op"
+              << std::setw(16) << "items/s" << std::endl;
+  }
+  std::vector<Result> results;
+  for (const Registration& registration : Registry()) {
+    if (std::string{registration.name}.find(filter) == std::string::npos) {
+      continue;
+    }
+    for (std::int64_t arg : registration.args) {
+      State state{Run(registration.function, arg, min_time)};
+      results.push_back(Summarize(
+          std::string{registration.name} + '/' + std::to_string(arg), state));
+      const Result& result{results.back()};
+      if (print_table) {
+        std::cout << std::left << std::setw(48) << result.name << std::right
+                  << std::setw(12) << result.iterations << std::fixed
+                  << std::setprecision(1) << std::setw(14) << result.ns_per_op
+                  << std::setw(12) << result.allocations_per_op
+                  << std::setw(14) << result.bytes_per_op
+                  << std::setprecision(0) << std::setw(16)
+                  << result.items_per_second << std::endl;
+      }
+    }
+  }
+  if (json_path == "-") {
+    WriteJson(std::cout, results, min_time);
+  } else if (!json_path.empty()) {
+    std::ofstream ofs{json_path};
+    if (!ofs.is_open()) {
+      std::cerr << "Unable to open JSON output file: " << json_path
+                << std::endl;
+      return 1;
+    }
+    WriteJson(ofs, results, min_time);
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures read throughput of `ArgumentMap::GetValue` when 1 to 64 threads
+// share one `ArgumentMap` object.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+constexpr int kNumParameters{64};
+constexpr int kNumArguments{64};
+constexpr int kReadsPerThread{1 << 14};
+
+ArgumentMap MakeArgumentMap() {
+  ParameterMap parameter_map;
+  for (int i = 0; i < kNumParameters; ++i) {
+    parameter_map(Parameter<int>::Keyword(converters::stoi,
+                                          {"param" + std::to_string(i)}));
+  }
+  ArgumentMap argument_map{std::move(parameter_map)};
+  for (int i = 0; i < kNumParameters; ++i) {
+    for (int j = 0; j < kNumArguments; ++j) {
+      argument_map.AddArgument("param" + std::to_string(i),
+                               std::to_string(i * j));
+    }
+  }
+  return argument_map;
+}
+
+// Each thread reads `kReadsPerThread` values, walking the parameters in a
+// different order than the other threads.
+//
+void ReadConcurrently(const ArgumentMap& argument_map, int num_threads) {
+  std::vector<std::string> names;
+  for (int i = 0; i < kNumParameters; ++i) {
+    names.push_back("param" + std::to_string(i));
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&argument_map, &names, t] {
+      long sum{0};
+      for (int i = 0; i < kReadsPerThread; ++i) {
+        sum += argument_map.GetValue<int>(names[(i + t) % kNumParameters],
+                                          (i * 7 + t) % kNumArguments);
+      }
+      DoNotOptimize(sum);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+// Values are cached before timing starts; readers never contend.
+//
+void BM_ConcurrentCachedReads(State& state) {
+  ArgumentMap argument_map{MakeArgumentMap()};
+  argument_map.ConvertAll();
+  while (state.KeepRunning()) {
+    ReadConcurrently(argument_map, state.arg());
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg() * kReadsPerThread);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ConcurrentCachedReads,
+                            1, 2, 4, 8, 16, 32, 64);
+
+// Every iteration starts from an empty cache, so readers race to compute
+// each value first.
+//
+void BM_ConcurrentFirstReads(State& state) {
+  ArgumentMap prototype{MakeArgumentMap()};
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ArgumentMap argument_map{prototype};
+    state.ResumeTiming();
+    ReadConcurrently(argument_map, state.arg());
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg() * kReadsPerThread);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ConcurrentFirstReads,
+                            1, 2, 4, 8, 16, 32, 64);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
\ No newline at end of file
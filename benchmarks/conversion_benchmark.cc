@@ -0,0 +1,252 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Compares the `std::from_chars`-based converters with the `std::sto*`-based
+// converters on lists of a million arguments, conversion functions bound at
+// runtime with those bound at compile time, and splitting a delimited list into
+// strings with converting it in bulk.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+constexpr int kNumValues{1000000};
+
+const std::vector<std::string>& IntegerStrings() {
+  static const std::vector<std::string> strings{[] {
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution;
+    std::vector<std::string> result;
+    result.reserve(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) {
+      result.push_back(std::to_string(distribution(generator)));
+    }
+    return result;
+  }()};
+  return strings;
+}
+
+const std::vector<std::string>& FloatingPointStrings() {
+  static const std::vector<std::string> strings{[] {
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> distribution{-1e6, 1e6};
+    std::vector<std::string> result;
+    result.reserve(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) {
+      result.push_back(std::to_string(distribution(generator)));
+    }
+    return result;
+  }()};
+  return strings;
+}
+
+template <class NumberType, NumberType (*kConverter)(const std::string&)>
+void ConvertAllStrings(State& state, const std::vector<std::string>& strings) {
+  while (state.KeepRunning()) {
+    NumberType sum{0};
+    for (const std::string& s : strings) {
+      sum += kConverter(s);
+    }
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+void BM_StoiMillion(State& state) {
+  ConvertAllStrings<int, converters::stoi>(state, IntegerStrings());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StoiMillion);
+
+void BM_FromCharsIntMillion(State& state) {
+  ConvertAllStrings<int, converters::FromChars<int>>(state, IntegerStrings());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_FromCharsIntMillion);
+
+void BM_StollMillion(State& state) {
+  ConvertAllStrings<long long, converters::stoll>(state, IntegerStrings());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StollMillion);
+
+void BM_FromCharsLongLongMillion(State& state) {
+  ConvertAllStrings<long long, converters::FromChars<long long>>(
+      state, IntegerStrings());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_FromCharsLongLongMillion);
+
+void BM_StodMillion(State& state) {
+  ConvertAllStrings<double, converters::stod>(state, FloatingPointStrings());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StodMillion);
+
+void BM_FromCharsDoubleMillion(State& state) {
+  ConvertAllStrings<double, converters::FromChars<double>>(
+      state, FloatingPointStrings());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_FromCharsDoubleMillion);
+
+// Conversion through the type-erased function stored by `ParameterMap`, which
+// is what `ArgumentMap::GetValue` and `ArgumentMap::ConvertAll` call.
+//
+void ConvertThroughArgumentMap(State& state, ParameterMap parameter_map) {
+  ArgumentMap argument_map{std::move(parameter_map)};
+  for (const std::string& s : IntegerStrings()) {
+    argument_map.AddArgument("values", s);
+  }
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ArgumentMap copy{argument_map};
+    state.ResumeTiming();
+    copy.ConvertAll();
+    DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * IntegerStrings().size());
+}
+
+void BM_RuntimeBoundConverter(State& state) {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                        {"values"}));
+  ConvertThroughArgumentMap(state, std::move(parameter_map));
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_RuntimeBoundConverter);
+
+void BM_CompileTimeBoundConverter(State& state) {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<int>::Keyword<converters::FromChars<int>>(
+      {"values"}));
+  ConvertThroughArgumentMap(state, std::move(parameter_map));
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_CompileTimeBoundConverter);
+
+// Conversion by `ArgumentMap::GetValue` of each value, through the stored
+// conversion function or `kConverter` itself.
+//
+template <class GetValue>
+void ConvertByGetValue(State& state, GetValue get_value) {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<int>::Keyword<converters::FromChars<int>>(
+      {"values"}));
+  ArgumentMap argument_map{std::move(parameter_map)};
+  for (const std::string& s : IntegerStrings()) {
+    argument_map.AddArgument("values", s);
+  }
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ArgumentMap copy{argument_map};
+    state.ResumeTiming();
+    long sum{0};
+    for (int pos = 0; pos < kNumValues; ++pos) {
+      sum += get_value(copy, pos);
+    }
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * IntegerStrings().size());
+}
+
+void BM_GetValueStoredConverter(State& state) {
+  ConvertByGetValue(state, [](const ArgumentMap& arguments, int pos) {
+    return arguments.GetValue<int>(ArgumentMap::size_type{0}, pos);
+  });
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_GetValueStoredConverter);
+
+void BM_GetValueBoundConverter(State& state) {
+  ConvertByGetValue(state, [](const ArgumentMap& arguments, int pos) {
+    return arguments.GetValue<converters::FromChars<int>>(
+        ArgumentMap::size_type{0}, pos);
+  });
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_GetValueBoundConverter);
+
+const std::string& DelimitedIntegers() {
+  static const std::string list{[] {
+    std::string result;
+    for (const std::string& s : IntegerStrings()) {
+      result.append(s).push_back(',');
+    }
+    result.pop_back();
+    return result;
+  }()};
+  return list;
+}
+
+// Splits into one string per element, then converts each element.
+//
+void BM_SplitThenStoiMillion(State& state) {
+  while (state.KeepRunning()) {
+    std::vector<int> values;
+    std::istringstream stream{DelimitedIntegers()};
+    std::string element;
+    while (std::getline(stream, element, ',')) {
+      values.push_back(converters::stoi(element));
+    }
+    DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_SplitThenStoiMillion);
+
+void BM_DelimitedListMillion(State& state) {
+  while (state.KeepRunning()) {
+    DoNotOptimize(converters::DelimitedList<int>(DelimitedIntegers()).data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_DelimitedListMillion);
+
+// Rejecting malformed input: the standard converters throw, `ParseNumber`
+// returns an error code.
+//
+void BM_StoiInvalid(State& state) {
+  std::string invalid{"not a number"};
+  while (state.KeepRunning()) {
+    try {
+      DoNotOptimize(converters::stoi(invalid));
+    } catch (const std::invalid_argument& e) {
+      DoNotOptimize(e);
+    }
+  }
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StoiInvalid);
+
+void BM_ParseNumberInvalid(State& state) {
+  std::string invalid{"not a number"};
+  int value;
+  while (state.KeepRunning()) {
+    DoNotOptimize(converters::ParseNumber(invalid, value));
+  }
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ParseNumberInvalid);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
\ No newline at end of file
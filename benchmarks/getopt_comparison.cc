@@ -0,0 +1,335 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Runs identical option sets and command lines through `ParseArgs` followed
+// by `GetValue`, and through `getopt_long` followed by manual conversion.
+//
+// Usage: getopt_comparison [--min_time=SECONDS]
+//
+// Reports the cost of a complete program startup (schema construction,
+// parsing, and reading every value), and the cost per token for growing
+// command lines. Scenarios in which the cost relative to `getopt_long` grows
+// with the command line length are flagged.
+//
+// Both parsers see the same option set: flags `-a` to `-h` (`--flag_a`, ...),
+// keywords `--threads`/`-t` and `--level`/`-l` taking integers,
+// `--output`/`-o` taking a string, and positional input files. Options
+// precede positional arguments so `getopt_long` is run without permuting
+// `argv` ("+" prefix). A repeated keyword keeps its first argument with
+// `ParseArgs` and its last with `getopt_long`; only the cost is compared.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+constexpr char kFlags[]{"abcdefgh"};
+constexpr int kNumFlags{sizeof(kFlags) - 1};
+
+// Values read by the program after parsing.
+//
+struct ProgramOptions {
+  bool flags[kNumFlags]{};
+  int threads{0};
+  int level{0};
+  std::string output;
+  std::vector<std::string> inputs;
+};
+
+std::shared_ptr<const ParameterMap> MakeSchema() {
+  ParameterMap parameter_map;
+  for (int i = 0; i < kNumFlags; ++i) {
+    parameter_map(Parameter<bool>::Flag(
+        {std::string(1, kFlags[i]), std::string{"flag_"} + kFlags[i]}));
+  }
+  parameter_map(Parameter<int>::Keyword(converters::stoi, {"threads", "t"}))
+               (Parameter<int>::Keyword(converters::stoi, {"level", "l"}))
+               (Parameter<std::string>::Keyword(converters::StringIdentity,
+                                                {"output", "o"}))
+               (Parameter<std::string>::Positional(converters::StringIdentity,
+                                                   "inputs", 0).MaxArgs(0));
+  return std::make_shared<const ParameterMap>(std::move(parameter_map));
+}
+
+ProgramOptions RunLibrary(const std::shared_ptr<const ParameterMap>& schema,
+                          const std::vector<const char*>& argv) {
+  ArgumentMap argument_map{schema};
+  ParseArgs(argv.size(), const_cast<const char**>(argv.data()),
+            argument_map);
+  ProgramOptions options;
+  for (int i = 0; i < kNumFlags; ++i) {
+    options.flags[i] = argument_map.IsSet(std::string(1, kFlags[i]));
+  }
+  if (!argument_map.ArgumentsOf("threads").empty()) {
+    options.threads = argument_map.GetValue<int>("threads");
+  }
+  if (!argument_map.ArgumentsOf("level").empty()) {
+    options.level = argument_map.GetValue<int>("level");
+  }
+  if (!argument_map.ArgumentsOf("output").empty()) {
+    options.output = argument_map.GetValue<std::string>("output");
+  }
+  options.inputs = argument_map.GetAllValues<std::string>("inputs");
+  return options;
+}
+
+const option kLongOptions[]{
+    {"flag_a", no_argument, nullptr, 'a'},
+    {"flag_b", no_argument, nullptr, 'b'},
+    {"flag_c", no_argument, nullptr, 'c'},
+    {"flag_d", no_argument, nullptr, 'd'},
+    {"flag_e", no_argument, nullptr, 'e'},
+    {"flag_f", no_argument, nullptr, 'f'},
+    {"flag_g", no_argument, nullptr, 'g'},
+    {"flag_h", no_argument, nullptr, 'h'},
+    {"threads", required_argument, nullptr, 't'},
+    {"level", required_argument, nullptr, 'l'},
+    {"output", required_argument, nullptr, 'o'},
+    {nullptr, 0, nullptr, 0}};
+
+ProgramOptions RunGetopt(const std::vector<const char*>& argv) {
+  ProgramOptions options;
+  int argc{static_cast<int>(argv.size())};
+  char* const* args{const_cast<char* const*>(argv.data())};
+  // Reinitializes getopt's global state.
+  optind = 0;
+  opterr = 0;
+  int c;
+  while ((c = getopt_long(argc, args, "+abcdefght:l:o:", kLongOptions,
+                          nullptr)) != -1) {
+    const char* flag{std::strchr(kFlags, c)};
+    if (flag != nullptr) {
+      options.flags[flag - kFlags] = true;
+    } else if (c == 't') {
+      options.threads = std::stoi(optarg);
+    } else if (c == 'l') {
+      options.level = std::stoi(optarg);
+    } else if (c == 'o') {
+      options.output = optarg;
+    } else {
+      std::abort();
+    }
+  }
+  options.inputs.assign(argv.begin() + optind, argv.end());
+  return options;
+}
+
+struct Scenario {
+  const char* name;
+  const char* description;
+  std::vector<std::string> (*make_arguments)(int size);
+};
+
+// Keywords with one argument each, in long and short form.
+//
+std::vector<std::string> MakeKeywords(int size) {
+  const char* keywords[]{"--threads", "-t", "--level", "-l"};
+  std::vector<std::string> result{"command"};
+  for (int i = 0; static_cast<int>(result.size()) + 1 < size; ++i) {
+    result.emplace_back(keywords[i % 4]);
+    result.push_back(std::to_string(i));
+  }
+  return result;
+}
+
+// Clusters of all short flags, e.g. `-abcdefgh`.
+//
+std::vector<std::string> MakeShortClusters(int size) {
+  std::vector<std::string> result{"command"};
+  while (static_cast<int>(result.size()) < size) {
+    result.push_back(std::string{"-"} + kFlags);
+  }
+  return result;
+}
+
+// A few options followed by many positional arguments.
+//
+std::vector<std::string> MakePositionalTail(int size) {
+  std::vector<std::string> result{"command", "-a", "--output", "out.txt"};
+  for (int i = 0; static_cast<int>(result.size()) < size; ++i) {
+    result.push_back("input_" + std::to_string(i) + ".txt");
+  }
+  return result;
+}
+
+const Scenario kScenarios[]{
+    {"keywords", "keyword options with one argument", MakeKeywords},
+    {"short_clusters", "clusters of short flags", MakeShortClusters},
+    {"positional_tail", "long tail of positional arguments",
+     MakePositionalTail}};
+
+const int kSizes[]{10, 1000, 100000};
+
+// Costs per run.
+//
+struct Measurement {
+  double ns;
+  double allocations;
+};
+
+// Runs `function` with increasing iteration counts until a run takes at least
+// `min_time`.
+//
+template <class Function>
+Measurement Measure(Function&& function, std::chrono::nanoseconds min_time) {
+  for (std::int64_t iterations = 1; ; iterations *= 2) {
+    std::uint64_t allocations{AllocationCount()};
+    auto start = std::chrono::steady_clock::now();
+    for (std::int64_t i = 0; i < iterations; ++i) {
+      ProgramOptions options{function()};
+      DoNotOptimize(options);
+    }
+    std::chrono::nanoseconds elapsed{std::chrono::steady_clock::now() - start};
+    if (elapsed >= min_time) {
+      return Measurement{
+          static_cast<double>(elapsed.count()) / iterations,
+          static_cast<double>(AllocationCount() - allocations) / iterations};
+    }
+  }
+}
+
+std::vector<const char*> Pointers(const std::vector<std::string>& arguments) {
+  std::vector<const char*> result;
+  for (const std::string& argument : arguments) {
+    result.push_back(argument.c_str());
+  }
+  return result;
+}
+
+void ReportStartup(std::chrono::nanoseconds min_time) {
+  std::vector<std::string> arguments{
+      "command", "-ab", "--output", "out.txt", "--threads", "8", "-l", "3",
+      "input.txt"};
+  std::vector<const char*> argv{Pointers(arguments)};
+  Measurement library{Measure([&argv]() {
+    return RunLibrary(MakeSchema(), argv);
+  }, min_time)};
+  Measurement getopt{Measure([&argv]() {return RunGetopt(argv);}, min_time)};
+  std::cout << std::fixed << std::setprecision(1)
+            << "Program startup (" << argv.size() << " tokens, including"
+            << " schema construction):\n"
+            << "  ParseArgs:   " << std::setw(10) << library.ns << " ns  "
+            << std::setw(8) << library.allocations << " allocs\n"
+            << "  getopt_long: " << std::setw(10) << getopt.ns << " ns  "
+            << std::setw(8) << getopt.allocations << " allocs\n"
+            << "  relative cost: " << library.ns / getopt.ns << "x\n\n";
+}
+
+void ReportScenarios(std::chrono::nanoseconds min_time) {
+  std::shared_ptr<const ParameterMap> schema{MakeSchema()};
+  std::cout << "Cost per token (schema constructed once):\n"
+            << std::left << std::setw(18) << "scenario" << std::right
+            << std::setw(8) << "tokens" << std::setw(16) << "ParseArgs ns"
+            << std::setw(14) << "getopt ns" << std::setw(10) << "relative"
+            << std::setw(18) << "ParseArgs allocs" << std::setw(14)
+            << "getopt allocs" << '\n';
+  std::vector<std::string> warnings;
+  for (const Scenario& scenario : kScenarios) {
+    double base_ratio{0.0}, base_ns{0.0}, ratio{0.0}, ns{0.0};
+    for (int size : kSizes) {
+      std::vector<std::string> arguments{scenario.make_arguments(size)};
+      std::vector<const char*> argv{Pointers(arguments)};
+      Measurement library{Measure([&schema, &argv]() {
+        return RunLibrary(schema, argv);
+      }, min_time)};
+      Measurement getopt{Measure([&argv]() {
+        return RunGetopt(argv);
+      }, min_time)};
+      double tokens{static_cast<double>(argv.size() - 1)};
+      ratio = library.ns / getopt.ns;
+      ns = library.ns / tokens;
+      if (size == kSizes[1]) {
+        base_ratio = ratio;
+        base_ns = ns;
+      }
+      std::cout << std::left << std::setw(18) << scenario.name << std::right
+                << std::setw(8) << argv.size() - 1 << std::fixed
+                << std::setprecision(1) << std::setw(16) << ns
+                << std::setw(14) << getopt.ns / tokens << std::setw(9)
+                << ratio << 'x' << std::setprecision(2) << std::setw(18)
+                << library.allocations / tokens << std::setw(14)
+                << getopt.allocations / tokens << '\n';
+    }
+    // Per-token costs of the smallest command lines are dominated by fixed
+    // overhead, so growth is measured from the second size on, and only
+    // growth beyond a factor of two is reported.
+    std::ostringstream warning;
+    warning << std::fixed << std::setprecision(1);
+    if (ratio > 2.0 * base_ratio) {
+      warning << "  " << scenario.name << " (" << scenario.description
+              << "): relative cost grows from " << base_ratio << "x to "
+              << ratio << "x\n";
+    }
+    if (ns > 2.0 * base_ns) {
+      warning << "  " << scenario.name << " (" << scenario.description
+              << "): ParseArgs cost per token grows from " << base_ns
+              << " ns to " << ns << " ns\n";
+    }
+    if (!warning.str().empty()) {
+      warnings.push_back(warning.str());
+    }
+  }
+  std::cout << "\nScenarios scaling worse than getopt_long: "
+            << (warnings.empty() ? "none" : "") << '\n';
+  for (const std::string& warning : warnings) {
+    std::cout << warning;
+  }
+}
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
+
+int main(int argc, const char** argv) {
+  using namespace arg_parse_convert::benchmark;
+  std::chrono::nanoseconds min_time{std::chrono::milliseconds{200}};
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--min_time=", 11) == 0) {
+      min_time = std::chrono::nanoseconds{
+          static_cast<std::int64_t>(std::atof(argv[i] + 11) * 1e9)};
+    } else {
+      std::cerr << "Usage: getopt_comparison [--min_time=SECONDS]"
+                << std::endl;
+      return 1;
+    }
+  }
+  ReportStartup(min_time);
+  ReportScenarios(min_time);
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures starting a tool with `state.arg()` documented parameters, i.e.
+// building its parameters and parsing a command line that does not ask for
+// help, with descriptions copied into each parameter compared to descriptions
+// viewed in static storage or returned by a provider. Bytes allocated per
+// iteration are the heap memory a run keeps resident for help text it never
+// prints.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+constexpr const char* kDescription{
+    "Sets the number of worker threads used while processing the input. The"
+    " default uses one thread per available core; values larger than the"
+    " number of cores are accepted but rarely help."};
+
+std::string OptionName(int i) {return "option-" + std::to_string(i);}
+
+void ParseCommandLine(ParameterMap parameter_map) {
+  const char* argv[]{"tool", "--option-7", "5"};
+  ArgumentMap arguments{std::move(parameter_map)};
+  DoNotOptimize(ParseArgs(3, argv, arguments));
+  DoNotOptimize(arguments.GetValue<int>("option-7"));
+}
+
+void BM_StartupOwnedDescriptions(State& state) {
+  while (state.KeepRunning()) {
+    ParameterMap parameter_map;
+    for (int i = 0; i < state.arg(); ++i) {
+      parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                            {OptionName(i)})
+                        .Description(kDescription));
+    }
+    ParseCommandLine(std::move(parameter_map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StartupOwnedDescriptions, 100, 1000);
+
+void BM_StartupStaticDescriptions(State& state) {
+  while (state.KeepRunning()) {
+    ParameterMap parameter_map;
+    for (int i = 0; i < state.arg(); ++i) {
+      parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                            {OptionName(i)})
+                        .StaticDescription(kDescription));
+    }
+    ParseCommandLine(std::move(parameter_map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StartupStaticDescriptions, 100, 1000);
+
+void BM_StartupProvidedDescriptions(State& state) {
+  while (state.KeepRunning()) {
+    ParameterMap parameter_map;
+    for (int i = 0; i < state.arg(); ++i) {
+      parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                            {OptionName(i)})
+                        .Description([i]() {
+                          return "Option " + std::to_string(i) + ". "
+                                 + kDescription;
+                        }));
+    }
+    ParseCommandLine(std::move(parameter_map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StartupProvidedDescriptions, 100, 1000);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
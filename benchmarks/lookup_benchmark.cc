@@ -0,0 +1,185 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures looking up names in a `ParameterMap` for streams of tokens of
+// which a given percentage are parameter names, as `ParseArgs` does for every
+// token, compared to a node-based `std::unordered_map`, resolving
+// abbreviated names and suggesting names for misspelled ones.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+constexpr int kNumParameters{200};
+constexpr int kNumTokens{4096};
+
+// Short and long names of the parameters, as a typical command line has both.
+//
+std::vector<std::string> MakeNames() {
+  std::vector<std::string> result;
+  for (int i = 0; i < kNumParameters; ++i) {
+    result.push_back(std::string(1, 'a' + i % 26) + std::to_string(i / 26));
+    result.push_back("option-with-a-long-name-" + std::to_string(i));
+  }
+  return result;
+}
+
+ParameterMap MakeSchema(const std::vector<std::string>& names) {
+  ParameterMap parameter_map;
+  for (int i = 0; i < kNumParameters; ++i) {
+    parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                          {names.at(2 * i),
+                                           names.at(2 * i + 1)}));
+  }
+  return parameter_map;
+}
+
+// Returns `kNumTokens` tokens, `hit_percentage` percent of which are names;
+// the others are values such as numbers and paths.
+//
+std::vector<std::string> MakeTokens(const std::vector<std::string>& names,
+                                    int hit_percentage) {
+  std::vector<std::string> result;
+  unsigned state{12345};
+  for (int i = 0; i < kNumTokens; ++i) {
+    state = state * 1103515245 + 12345;
+    if (static_cast<int>(state >> 16) % 100 < hit_percentage) {
+      result.push_back(names.at((state >> 8) % names.size()));
+    } else if (i % 2 == 0) {
+      result.push_back(std::to_string(state % 100000));
+    } else {
+      result.push_back("/path/to/input_file_" + std::to_string(i) + ".txt");
+    }
+  }
+  return result;
+}
+
+void BM_NameLookup(State& state) {
+  std::vector<std::string> names{MakeNames()};
+  ParameterMap parameter_map{MakeSchema(names)};
+  std::vector<std::string> tokens{MakeTokens(names, state.arg())};
+  while (state.KeepRunning()) {
+    int found{0};
+    for (const std::string& token : tokens) {
+      found += parameter_map.Contains(token);
+    }
+    DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumTokens);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_NameLookup, 10, 30, 50, 90);
+
+void BM_UnorderedMapNameLookup(State& state) {
+  std::vector<std::string> names{MakeNames()};
+  std::unordered_map<std::string, int> name_to_id;
+  for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+    name_to_id.emplace(names.at(i), i / 2);
+  }
+  std::vector<std::string> tokens{MakeTokens(names, state.arg())};
+  while (state.KeepRunning()) {
+    int found{0};
+    for (const std::string& token : tokens) {
+      found += name_to_id.count(token);
+    }
+    DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumTokens);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_UnorderedMapNameLookup, 10, 30, 50, 90);
+
+// Resolves unique prefixes of the names of `state.arg()` parameters, which
+// should take the same time for any number of parameters.
+//
+void BM_MatchAbbreviation(State& state) {
+  ParameterMap parameter_map;
+  std::vector<std::string> prefixes;
+  for (int i = 0; i < state.arg(); ++i) {
+    std::string name{"option-" + std::to_string(i) + "-with-a-long-name"};
+    parameter_map(Parameter<bool>::Flag({name}));
+    prefixes.push_back(name.substr(0, name.size() - 5));
+  }
+  parameter_map.AllowAbbreviations();
+  while (state.KeepRunning()) {
+    int sum{0};
+    for (const std::string& prefix : prefixes) {
+      sum += parameter_map.MatchAbbreviation(prefix);
+    }
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_MatchAbbreviation, 100, 10000);
+
+// Suggests names for misspellings of the names of `state.arg()` parameters
+// with two adjacent characters transposed, which should take the same time
+// for any number of parameters once the index was built.
+//
+void BM_Suggest(State& state) {
+  ParameterMap parameter_map;
+  std::vector<std::string> typos;
+  for (int i = 0; i < state.arg(); ++i) {
+    std::string name{"option-" + std::to_string(i) + "-with-a-long-name"};
+    parameter_map(Parameter<bool>::Flag({name}));
+    std::swap(name.at(2), name.at(3));
+    typos.push_back(name);
+  }
+  parameter_map.Suggest(typos.front());
+  while (state.KeepRunning()) {
+    std::size_t sum{0};
+    for (int i = 0; i < 100; ++i) {
+      sum += parameter_map.Suggest(typos.at(i * 7919 % typos.size())).size();
+    }
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 100);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_Suggest, 100, 20000);
+
+// Builds the index used by `ParameterMap::Suggest` for the names of
+// `state.arg()` parameters, as the first misspelled name does.
+//
+void BM_BuildSuggestionIndex(State& state) {
+  ParameterMap parameter_map;
+  for (int i = 0; i < state.arg(); ++i) {
+    parameter_map(Parameter<bool>::Flag(
+        {"option-" + std::to_string(i) + "-with-a-long-name"}));
+  }
+  while (state.KeepRunning()) {
+    ParameterMap copy{parameter_map};
+    DoNotOptimize(copy.Suggest("option-1-with-a-lnog-name"));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_BuildSuggestionIndex, 100, 20000);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
@@ -0,0 +1,194 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures `ParseArgs` on long command lines and `ParseFile` on large
+// generated configuration files, and parsing against schemas with many
+// parameters.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+constexpr int kNumKeywords{100};
+constexpr int kArgumentsPerKeyword{9};
+
+// Keyword parameters `key_0`, ..., flags `flag_0`, ..., and one positional
+// parameter taking any number of arguments.
+//
+std::shared_ptr<const ParameterMap> MakeSchema() {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<std::string>::Positional(converters::StringIdentity,
+                                                   "positional", 0));
+  for (int i = 0; i < kNumKeywords; ++i) {
+    parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                          {"key_" + std::to_string(i)}))
+                 (Parameter<bool>::Flag({"flag_" + std::to_string(i)}));
+  }
+  return std::make_shared<const ParameterMap>(std::move(parameter_map));
+}
+
+// Returns `size` command-line arguments, mostly keyword names followed by
+// several arguments each, with some flags.
+//
+std::vector<std::string> MakeArguments(int size) {
+  std::vector<std::string> result{"command", "positional_argument"};
+  int i{0};
+  while (static_cast<int>(result.size()) < size) {
+    result.push_back("--key_" + std::to_string(i % kNumKeywords));
+    for (int j = 0; j < kArgumentsPerKeyword; ++j) {
+      result.push_back(std::to_string(i * kArgumentsPerKeyword + j));
+    }
+    result.push_back("--flag_" + std::to_string(i % kNumKeywords));
+    ++i;
+  }
+  result.resize(size);
+  return result;
+}
+
+// Returns a configuration file of `size` lines.
+//
+std::string MakeConfiguration(int size) {
+  std::string result{"# generated configuration\n"};
+  for (int i = 1; i < size; ++i) {
+    if (i % 10 == 0) {
+      result.append("flag_").append(std::to_string(i % kNumKeywords))
+            .append("=true\n");
+    } else {
+      result.append("key_").append(std::to_string(i % kNumKeywords))
+            .append("=").append(std::to_string(i)).append(" ")
+            .append(std::to_string(-i)).append("\n");
+    }
+  }
+  return result;
+}
+
+// `num_parameters` keyword parameters `option_0`, ... with descriptions, every
+// tenth of them required and another tenth with a default argument, and one
+// positional parameter taking any number of arguments.
+//
+std::shared_ptr<const ParameterMap> MakeLargeSchema(int num_parameters) {
+  ParameterMap parameter_map;
+  parameter_map.Reserve(num_parameters + 1, num_parameters + 1);
+  parameter_map(Parameter<std::string>::Positional(converters::StringIdentity,
+                                                   "positional", 0));
+  for (int i = 0; i < num_parameters; ++i) {
+    Parameter<int> parameter{Parameter<int>::Keyword(
+        converters::FromChars<int>, {"option_" + std::to_string(i)})};
+    parameter.MaxArgs(1).Description(
+        "Sets option number " + std::to_string(i) + " of the generated "
+        "schema; the description is as long as a typical one.");
+    if (i % 10 == 0) {
+      parameter.MinArgs(1);
+    } else if (i % 10 == 5) {
+      parameter.AddDefault(std::to_string(i));
+    }
+    parameter_map(std::move(parameter));
+  }
+  return std::make_shared<const ParameterMap>(std::move(parameter_map));
+}
+
+void BM_ParseArgs(State& state) {
+  std::shared_ptr<const ParameterMap> schema{MakeSchema()};
+  std::vector<std::string> arguments{MakeArguments(state.arg())};
+  std::vector<const char*> argv;
+  for (const std::string& argument : arguments) {
+    argv.push_back(argument.c_str());
+  }
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ArgumentMap argument_map{schema};
+    state.ResumeTiming();
+    DoNotOptimize(ParseArgs(argv.size(), argv.data(), argument_map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ParseArgs, 10, 1000, 100000);
+
+void BM_ParseFile(State& state) {
+  std::shared_ptr<const ParameterMap> schema{MakeSchema()};
+  std::string configuration{MakeConfiguration(state.arg())};
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ArgumentMap argument_map{schema};
+    std::istringstream iss{configuration};
+    state.ResumeTiming();
+    DoNotOptimize(ParseFile(iss, argument_map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ParseFile, 10, 1000, 100000);
+
+// Parses one argument for every tenth parameter of a schema of `state.arg()`
+// parameters, then applies defaults and checks for unfilled parameters.
+//
+void BM_ParseArgsLargeSchema(State& state) {
+  std::shared_ptr<const ParameterMap> schema{MakeLargeSchema(state.arg())};
+  std::vector<std::string> arguments{"command", "positional_argument"};
+  for (int i = 0; i < state.arg(); i += 10) {
+    arguments.push_back("--option_" + std::to_string(i));
+    arguments.push_back(std::to_string(i));
+  }
+  std::vector<const char*> argv;
+  for (const std::string& argument : arguments) {
+    argv.push_back(argument.c_str());
+  }
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ArgumentMap argument_map{schema};
+    state.ResumeTiming();
+    DoNotOptimize(ParseArgs(argv.size(), argv.data(), argument_map));
+    argument_map.SetDefaultArguments();
+    DoNotOptimize(argument_map.GetUnfilledParameters());
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ParseArgsLargeSchema, 10000);
+
+// Applies defaults and checks for unfilled parameters of a schema of
+// `state.arg()` parameters of which none received arguments.
+//
+void BM_SetDefaultArguments(State& state) {
+  std::shared_ptr<const ParameterMap> schema{MakeLargeSchema(state.arg())};
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ArgumentMap argument_map{schema};
+    state.ResumeTiming();
+    argument_map.SetDefaultArguments();
+    DoNotOptimize(argument_map.GetUnfilledParameters());
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_SetDefaultArguments, 10000);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
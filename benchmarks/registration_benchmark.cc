@@ -0,0 +1,128 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures registering parameters with a `ParameterMap` and generating its
+// help-string, for 10 to 100k parameters.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+// Returns `size` parameters of all categories with descriptions.
+//
+std::vector<Parameter<int>> MakeParameters(int size) {
+  std::vector<Parameter<int>> result;
+  result.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    std::string name{"parameter_" + std::to_string(i)};
+    if (i % 2 == 0) {
+      result.push_back(Parameter<int>::Keyword(converters::FromChars<int>,
+                                               {name, "alias_" + name}));
+    } else {
+      result.push_back(Parameter<int>::Positional(converters::FromChars<int>,
+                                                  name, i));
+    }
+    result.back().Description("Description of " + name + ", which is long"
+                              " enough to be wrapped onto a second line of the"
+                              " help-string.");
+  }
+  return result;
+}
+
+void BM_RegisterParameters(State& state) {
+  std::vector<Parameter<int>> parameters{MakeParameters(state.arg())};
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::vector<Parameter<int>> copy{parameters};
+    state.ResumeTiming();
+    ParameterMap parameter_map;
+    for (Parameter<int>& parameter : copy) {
+      parameter_map(std::move(parameter));
+    }
+    DoNotOptimize(parameter_map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_RegisterParameters, 10, 100, 1000, 10000,
+                            100000);
+
+void BM_RegisterReservedParameters(State& state) {
+  std::vector<Parameter<int>> parameters{MakeParameters(state.arg())};
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::vector<Parameter<int>> copy{parameters};
+    state.ResumeTiming();
+    ParameterMap parameter_map;
+    parameter_map.Reserve(copy.size(), 2 * copy.size());
+    for (Parameter<int>& parameter : copy) {
+      parameter_map(std::move(parameter));
+    }
+    DoNotOptimize(parameter_map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_RegisterReservedParameters, 10, 100, 1000,
+                            10000, 100000);
+
+void BM_RegisterParameterBatch(State& state) {
+  std::vector<Parameter<int>> parameters{MakeParameters(state.arg())};
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::vector<Parameter<int>> copy{parameters};
+    state.ResumeTiming();
+    ParameterMap parameter_map;
+    parameter_map.Register(std::make_move_iterator(copy.begin()),
+                           std::make_move_iterator(copy.end()));
+    DoNotOptimize(parameter_map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_RegisterParameterBatch, 10, 100, 1000, 10000,
+                            100000);
+
+void BM_FormattedHelpString(State& state) {
+  ParameterMap parameter_map;
+  for (Parameter<int>& parameter : MakeParameters(state.arg())) {
+    parameter_map(std::move(parameter));
+  }
+  parameter_map(Parameter<bool>::Flag({"h", "help"})
+                    .Description("Print this help message and exit."));
+  while (state.KeepRunning()) {
+    DoNotOptimize(FormattedHelpString(parameter_map, "Usage: command",
+                                      "Footer."));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_FormattedHelpString, 10, 100, 1000);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
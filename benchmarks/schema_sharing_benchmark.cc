@@ -0,0 +1,86 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures constructing and copying `ArgumentMap` objects for schemas of
+// various sizes. Both should cost time proportional to the number of
+// parameters, independent of names, descriptions and default arguments. Also
+// measures copying the schemas themselves.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+std::shared_ptr<const ParameterMap> MakeSchema(int size) {
+  ParameterMap parameter_map;
+  for (int i = 0; i < size; ++i) {
+    std::string name{"parameter_with_a_long_name_" + std::to_string(i)};
+    parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                          {name, "alias_" + name})
+                      .Description("A description which is long enough not to"
+                                   " fit into the small string buffer.")
+                      .AddDefault(std::to_string(i)));
+  }
+  return std::make_shared<const ParameterMap>(std::move(parameter_map));
+}
+
+void BM_ConstructFromSharedSchema(State& state) {
+  std::shared_ptr<const ParameterMap> schema{MakeSchema(state.arg())};
+  while (state.KeepRunning()) {
+    ArgumentMap argument_map{schema};
+    DoNotOptimize(argument_map);
+  }
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ConstructFromSharedSchema, 10, 100, 1000);
+
+void BM_CopyArgumentMap(State& state) {
+  ArgumentMap argument_map{MakeSchema(state.arg())};
+  argument_map.SetDefaultArguments();
+  while (state.KeepRunning()) {
+    ArgumentMap copy{argument_map};
+    DoNotOptimize(copy);
+  }
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_CopyArgumentMap, 10, 100, 1000);
+
+// Copies of a `ParameterMap` share its pool of names used for lookup.
+//
+void BM_CopyParameterMap(State& state) {
+  std::shared_ptr<const ParameterMap> schema{MakeSchema(state.arg())};
+  while (state.KeepRunning()) {
+    ParameterMap copy{*schema};
+    DoNotOptimize(copy);
+  }
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_CopyParameterMap, 10, 100, 1000);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
@@ -0,0 +1,93 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures starting a tool with `state.arg()` subcommands of 200 parameters
+// each, i.e. building its parameters and parsing a command line using one
+// subcommand, with all parameters in one flat `ParameterMap` compared to
+// subcommands whose parameters are created when their name is parsed.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+constexpr int kParametersPerSubcommand{200};
+
+// Registers the parameters of subcommand `subcommand` with `parameter_map`,
+// with names starting with `prefix`.
+//
+void AddSubcommandParameters(ParameterMap& parameter_map, int subcommand,
+                             const std::string& prefix) {
+  for (int i = 0; i < kParametersPerSubcommand; ++i) {
+    std::string name{prefix + "option-" + std::to_string(i)};
+    parameter_map(Parameter<int>::Keyword(converters::FromChars<int>, {name})
+                      .Description("Option " + std::to_string(i)
+                                   + " of subcommand "
+                                   + std::to_string(subcommand) + "."));
+  }
+}
+
+void BM_StartupFlatSchema(State& state) {
+  const char* argv[]{"tool", "--command-3-option-7", "5"};
+  while (state.KeepRunning()) {
+    ParameterMap parameter_map;
+    for (int i = 0; i < state.arg(); ++i) {
+      AddSubcommandParameters(parameter_map, i,
+                              "command-" + std::to_string(i) + "-");
+    }
+    ArgumentMap arguments{std::move(parameter_map)};
+    DoNotOptimize(ParseArgs(3, argv, arguments));
+    DoNotOptimize(arguments.GetValue<int>("command-3-option-7"));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StartupFlatSchema, 10, 40);
+
+void BM_StartupLazySubcommands(State& state) {
+  const char* argv[]{"tool", "command-3", "--option-7", "5"};
+  while (state.KeepRunning()) {
+    ParameterMap parameter_map;
+    for (int i = 0; i < state.arg(); ++i) {
+      parameter_map.AddSubcommand("command-" + std::to_string(i), [i]() {
+        ParameterMap result;
+        AddSubcommandParameters(result, i, "");
+        return result;
+      });
+    }
+    ArgumentMap arguments{std::move(parameter_map)};
+    DoNotOptimize(ParseArgs(4, argv, arguments));
+    DoNotOptimize(arguments.SubcommandArguments().GetValue<int>("option-7"));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_StartupLazySubcommands, 10, 40);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
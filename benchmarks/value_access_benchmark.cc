@@ -0,0 +1,156 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <vector>
+
+#include "arg_parse_convert.h"
+#include "benchmark.h"
+
+// Measures retrieval of long lists of cached values, and of a few values by
+// name compared to binding them to a struct.
+
+namespace arg_parse_convert {
+
+namespace benchmark {
+
+namespace {
+
+ArgumentMap MakeIntegerList(int size) {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<int>::Keyword(converters::FromChars<int>,
+                                        {"ints"}));
+  ArgumentMap argument_map{std::move(parameter_map)};
+  for (int i = 0; i < size; ++i) {
+    argument_map.AddArgument("ints", std::to_string(i));
+  }
+  argument_map.ConvertAll();
+  return argument_map;
+}
+
+void BM_GetValueLoop(State& state) {
+  ArgumentMap argument_map{MakeIntegerList(state.arg())};
+  while (state.KeepRunning()) {
+    long sum{0};
+    for (int pos = 0; pos < state.arg(); ++pos) {
+      sum += argument_map.GetValue<int>("ints", pos);
+    }
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_GetValueLoop, 1000, 100000);
+
+void BM_GetAllValues(State& state) {
+  ArgumentMap argument_map{MakeIntegerList(state.arg())};
+  while (state.KeepRunning()) {
+    DoNotOptimize(argument_map.GetAllValues<int>("ints"));
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_GetAllValues, 1000, 100000, 1000000);
+
+void BM_GetAllValuesIntoVector(State& state) {
+  ArgumentMap argument_map{MakeIntegerList(state.arg())};
+  std::vector<int> values;
+  while (state.KeepRunning()) {
+    values.clear();
+    argument_map.GetAllValuesInto("ints", values);
+    DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_GetAllValuesIntoVector, 1000, 100000, 1000000);
+
+void BM_GetAllValuesIntoArray(State& state) {
+  ArgumentMap argument_map{MakeIntegerList(state.arg())};
+  std::vector<int> values(state.arg());
+  while (state.KeepRunning()) {
+    argument_map.GetAllValuesInto("ints", values.data(), values.size());
+    DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.arg());
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_GetAllValuesIntoArray, 1000, 100000, 1000000);
+
+struct Options {
+  int count{0};
+  double ratio{0};
+  std::string output;
+};
+
+ArgumentMap MakeOptions(StructBinding<Options>& binding,
+                        ParameterMap& parameter_map) {
+  binding(&Options::count, Parameter<int>::Keyword(converters::FromChars<int>,
+                                                   {"count"}))
+         (&Options::ratio, Parameter<double>::Keyword(
+                               converters::FromChars<double>, {"ratio"}))
+         (&Options::output, Parameter<std::string>::Keyword(
+                                converters::StringIdentity, {"output"}));
+  ArgumentMap argument_map{std::move(parameter_map)};
+  argument_map.AddArgument("count", "42");
+  argument_map.AddArgument("ratio", "0.5");
+  argument_map.AddArgument("output", "result.txt");
+  argument_map.ConvertAll();
+  return argument_map;
+}
+
+void BM_ReadOptionsByName(State& state) {
+  ParameterMap parameter_map;
+  StructBinding<Options> binding{parameter_map};
+  ArgumentMap argument_map{MakeOptions(binding, parameter_map)};
+  while (state.KeepRunning()) {
+    DoNotOptimize(argument_map.GetValue<int>("count"));
+    DoNotOptimize(argument_map.GetValue<double>("ratio"));
+    DoNotOptimize(argument_map.GetValue<std::string>("output").size());
+  }
+  state.SetItemsProcessed(state.iterations() * 3);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ReadOptionsByName);
+
+void BM_ReadBoundOptions(State& state) {
+  ParameterMap parameter_map;
+  StructBinding<Options> binding{parameter_map};
+  ArgumentMap argument_map{MakeOptions(binding, parameter_map)};
+  Options options{binding.Bind(argument_map)};
+  while (state.KeepRunning()) {
+    DoNotOptimize(options.count);
+    DoNotOptimize(options.ratio);
+    DoNotOptimize(options.output.size());
+  }
+  state.SetItemsProcessed(state.iterations() * 3);
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_ReadBoundOptions);
+
+void BM_BindOptions(State& state) {
+  ParameterMap parameter_map;
+  StructBinding<Options> binding{parameter_map};
+  ArgumentMap argument_map{MakeOptions(binding, parameter_map)};
+  while (state.KeepRunning()) {
+    DoNotOptimize(binding.Bind(argument_map));
+  }
+}
+ARG_PARSE_CONVERT_BENCHMARK(BM_BindOptions);
+
+} // namespace
+
+} // namespace benchmark
+
+} // namespace arg_parse_convert
\ No newline at end of file
@@ -25,9 +25,16 @@
 #include "conversion_functions.h"
 #include "exceptions.h"
 #include "help_string_formatters.h"
+#include "memory_report.h"
 #include "parameter.h"
 #include "parameter_map.h"
+#include "parse_observer.h"
 #include "parsers.h"
+#include "perf_counters.h"
+#include "string_pool.h"
+#include "struct_binding.h"
+#include "trace.h"
+#include "trace_events.h"
 
 /// @defgroup ArgParseConvert-Reference
 ///
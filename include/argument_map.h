@@ -22,15 +22,29 @@
 #define ARG_PARSE_CONVERT_ARGUMENT_MAP_H_
 
 #include <any>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "exceptions.h"
+#include "memory_report.h"
 #include "parameter.h"
 #include "parameter_map.h"
+#include "parse_observer.h"
+#include "perf_counters.h"
+#include "trace_events.h"
 
 namespace arg_parse_convert {
 
+class TraceWriter;
+
 /// @addtogroup ArgParseConvert-Reference
 ///
 /// @{
@@ -38,29 +52,74 @@ namespace arg_parse_convert {
 /// @brief Stores arguments for an internal `ParameterMap` member's parameters
 ///  and allows for retrieving the parameter values.
 ///
+/// @details The `ParameterMap` member is immutable and shared between all
+///  objects constructed from the same `std::shared_ptr`, and between copies of
+///  an object. Constructing and copying an object therefore costs time and
+///  memory proportional to the number of parameters and arguments, but not to
+///  the size of the parameters' configurations.
+///
 /// @invariant Number of stored argument lists is always the same as the size of
 ///  the `ParameterMap` member.
 ///
 /// @invariant Number of stored value lists is always the same as the size of
 ///  the `ParameterMap` member.
 ///
+/// @invariant Each parameter's value list has as many entries as its argument
+///  list.
+///
+/// @details Value accessors are `const` and may be called concurrently from
+///  multiple threads, as long as no mutator is called at the same time. Each
+///  value is computed at most once; concurrent readers only wait for each other
+///  while that first conversion is in progress.
+///
 class ArgumentMap {
  public:
   using size_type = std::vector<std::vector<std::string>>::size_type;
+
+  /// @brief Schedules a task for execution.
+  ///
+  /// @details Used by `ConvertAll` to distribute conversions. The executor may
+  ///  run the task immediately, or on another thread, but must run each task it
+  ///  is given exactly once.
+  ///
+  using Executor = std::function<void(std::function<void()>)>;
+
+  /// @brief Default maximum number of arguments `ConvertAll` converts in a
+  ///  single task.
+  ///
+  static constexpr size_type kDefaultConversionChunkSize{4096};
+
   /// @name Constructors:
   ///
   /// @{
 
-  /// @brief Constructs object with copy of `parameters`.
+  /// @brief Constructs object which takes ownership of `parameters`.
   ///
   ArgumentMap(ParameterMap&& parameters)
-      : parameters_{parameters},
-        arguments_{parameters_.size(), std::vector<std::string>{}},
-        value_lists_{parameters_.size(), std::vector<std::any>{}} {}
+      : ArgumentMap{
+            std::make_shared<const ParameterMap>(std::move(parameters))} {}
+
+  /// @brief Constructs object which shares `parameters` with other objects.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Throws `exceptions::ParameterAccessError` if `parameters` is null.
+  ///
+  explicit ArgumentMap(std::shared_ptr<const ParameterMap> parameters)
+      : parameters_{std::move(parameters)} {
+    if (parameters_ == nullptr) {
+      throw exceptions::ParameterAccessError("ArgumentMap requires a"
+                                             " ParameterMap.");
+    }
+    arguments_.resize(parameters_->size());
+    value_lists_.resize(parameters_->size());
+    value_states_.resize(parameters_->size());
+  }
 
   /// @brief Copy constructor.
   ///
-  ArgumentMap(const ArgumentMap& other) = default;
+  /// @details Values another thread is computing meanwhile are not copied.
+  ///
+  ArgumentMap(const ArgumentMap& other);
 
   /// @brief Move constructor.
   ///
@@ -73,7 +132,9 @@ class ArgumentMap {
   
   /// @brief Copy assignments.
   ///
-  ArgumentMap& operator=(const ArgumentMap& other) = default;
+  /// @details Same as the copy constructor.
+  ///
+  ArgumentMap& operator=(const ArgumentMap& other);
 
   /// @brief Move assignment.
   ///
@@ -84,6 +145,27 @@ class ArgumentMap {
   ///
   /// @{
   
+  /// @brief Sets the observer notified of parse phases; null removes it.
+  ///
+  /// @details The object does not take ownership of `observer`, which must
+  ///  outlive its use by the object and its copies.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline void SetParseObserver(ParseObserver* observer) {
+    parse_observer_ = observer;
+  }
+
+  /// @brief Sets the writer capturing inputs of `ParseArgs` and `ParseFile`;
+  ///  null removes it.
+  ///
+  /// @details The object does not take ownership of `writer`, which must
+  ///  outlive its use by the object and its copies.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline void SetTraceWriter(TraceWriter* writer) {trace_writer_ = writer;}
+
   /// @brief Sets default argument lists for non-flag parameters lacking
   ///  arguments.
   ///
@@ -93,10 +175,13 @@ class ArgumentMap {
   /// @exceptions Basic guarantee.
   ///
   inline void SetDefaultArguments() {
+    const ParameterLayout& layout{parameters_->layout()};
     for (int i = 0; i < static_cast<int>(arguments_.size()); ++i) {
-      if (parameters_.GetConfiguration(i).category() != ParameterCategory::kFlag
+      if (layout.HasDefaults(i) && !layout.IsFlag(i)
           && arguments_.at(i).size() == 0) {
-        arguments_.at(i) = parameters_.GetConfiguration(i).default_arguments();
+        arguments_.at(i) = parameters_->GetConfiguration(i)
+                                      .default_arguments();
+        ResizeValueList(i);
       }
     }
   }
@@ -111,11 +196,17 @@ class ArgumentMap {
   ///  `name`.
   ///
   inline void AddArgument(const std::string& name, std::string arg) {
-    int id{parameters_.GetId(name)},
-        max_num_args{parameters_.GetConfiguration(name).max_num_arguments()};
+    int id{parameters_->GetId(name)},
+        max_num_args{parameters_->layout().max_num_arguments(id)};
     if (max_num_args == 0
         || static_cast<int>(arguments_.at(id).size()) < max_num_args) {
-      arguments_.at(parameters_.GetId(name)).emplace_back(std::move(arg));
+      arguments_.at(id).emplace_back(std::move(arg));
+      try {
+        ResizeValueList(id);
+      } catch (...) {
+        arguments_.at(id).pop_back();
+        throw;
+      }
     }
   }
   /// @}
@@ -134,7 +225,31 @@ class ArgumentMap {
   ///
   /// @exceptions Strong guarantee.
   ///
-  inline const ParameterMap& Parameters() const {return parameters_;}
+  inline const ParameterMap& Parameters() const {return *parameters_;}
+
+  /// @brief Returns the shared `ParameterMap` member of the object.
+  ///
+  /// @details Can be used to construct further objects for the same
+  ///  parameters without copying them.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline const std::shared_ptr<const ParameterMap>& SharedParameters() const {
+    return parameters_;
+  }
+
+  /// @brief Returns the observer notified of parse phases, or null.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline ParseObserver* parse_observer() const {return parse_observer_;}
+
+  /// @brief Returns the writer capturing inputs of `ParseArgs` and `ParseFile`,
+  ///  or null.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline TraceWriter* trace_writer() const {return trace_writer_;}
 
   /// @brief Returns the lists of arguments for the parameters.
   ///
@@ -147,12 +262,43 @@ class ArgumentMap {
     return arguments_;
   }
 
+  /// @brief Indicates whether `ParseArgs` reached the name of a subcommand.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline bool HasSubcommand() const {return subcommand_arguments_ != nullptr;}
+
+  /// @brief Returns the name of the subcommand `ParseArgs` reached.
+  ///
+  /// @exceptions Strong guarantee. Throws `exceptions::ValueAccessError` if
+  ///  `ParseArgs` reached no subcommand.
+  ///
+  std::string_view SubcommandName() const;
+
+  /// @brief Returns the arguments following the subcommand `ParseArgs`
+  ///  reached, which are stored for the subcommand's parameters.
+  ///
+  /// @exceptions Strong guarantee. Throws `exceptions::ValueAccessError` if
+  ///  `ParseArgs` reached no subcommand.
+  ///
+  const ArgumentMap& SubcommandArguments() const;
+
+  /// @brief Returns the arguments following the subcommand `ParseArgs`
+  ///  reached, e.g. to set their default arguments.
+  ///
+  /// @exceptions Same as `SubcommandArguments() const`.
+  ///
+  ArgumentMap& SubcommandArguments();
+
   /// @brief Returns the lists of values for the parameters.
   ///
-  /// @details The position of the argument list of a parameter in the returned
-  ///  vector is its id. Argument lists are only filled up to the positions for
-  ///  which `GetValue` was called, or filled all the way if `GetAllValues` was
-  ///  called for the corresponding paramters.
+  /// @details The position of the value list of a parameter in the returned
+  ///  vector is its id. The value list of a parameter with a conversion
+  ///  function has as many entries as the parameter has arguments, but only
+  ///  the entries at the positions for which values were computed (by
+  ///  `GetValue`, `GetAllValues`, or `ConvertAll`) are non-empty. Other value
+  ///  lists are empty. The lists must not be read while other threads may
+  ///  compute values; use `ValuesSnapshot` then.
   ///
   /// @exceptions Strong guarantee.
   ///
@@ -160,6 +306,15 @@ class ArgumentMap {
     return value_lists_;
   }
 
+  /// @brief Returns a copy of the lists of values for the parameters.
+  ///
+  /// @details Same as `Values`, but safe while other threads compute values;
+  ///  values being computed meanwhile are empty in the copy.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  std::vector<std::vector<std::any>> ValuesSnapshot() const;
+
   /// @brief Returns list of unfilled parameters.
   ///
   /// @details The primary string-identifier of each unfilled parameter is
@@ -171,10 +326,10 @@ class ArgumentMap {
   ///
   inline std::vector<std::string> GetUnfilledParameters() const {
     std::vector<std::string> result;
-    for (int i = 0; i < static_cast<int>(parameters_.size()); ++i) {
-      if (parameters_.GetConfiguration(i).min_num_arguments()
+    for (int i = 0; i < static_cast<int>(parameters_->size()); ++i) {
+      if (parameters_->layout().min_num_arguments(i)
           > static_cast<int>(arguments_.at(i).size())) {
-        result.emplace_back(parameters_.GetPrimaryName(i));
+        result.emplace_back(parameters_->GetPrimaryName(i));
       }
     }
     return result;
@@ -191,7 +346,7 @@ class ArgumentMap {
   ///  `name`.
   ///
   inline bool HasArgument(const std::string& name) const {
-    return (arguments_.at(parameters_.GetId(name)).size() > 0);
+    return (arguments_.at(parameters_->GetId(name)).size() > 0);
   }
 
   /// @brief Returns the arguments assigned to parameter identified by `name`.
@@ -202,7 +357,7 @@ class ArgumentMap {
   ///
   inline const std::vector<std::string>&
   ArgumentsOf(const std::string& name) const {
-    return (arguments_.at(parameters_.GetId(name)));
+    return (arguments_.at(parameters_->GetId(name)));
   }
 
   /// @brief Returns value of parameter.
@@ -227,7 +382,42 @@ class ArgumentMap {
   ///  * Conversion function may throw.
   ///
   template <class ParameterType>
-  ParameterType GetValue(const std::string& name, int pos = 0);
+  ParameterType GetValue(const std::string& name, int pos = 0) const;
+
+  /// @brief Returns value of parameter with integer-identifier `id`.
+  ///
+  /// @details Same as `GetValue(const std::string&, int)`, but skips the name
+  ///  lookup. Integer-identifiers are obtained from `ParameterMap::GetId`.
+  ///
+  /// @exceptions Same as `GetValue(const std::string&, int)`, where `id` takes
+  ///  the place of `name`.
+  ///
+  template <class ParameterType>
+  ParameterType GetValue(size_type id, int pos = 0) const;
+
+  /// @brief Returns value of parameter identified by `name`, whose conversion
+  ///  function `kConverter` was bound at compile time.
+  ///
+  /// @details Same as `GetValue<ParameterType>(name, pos)`, where
+  ///  `ParameterType` is the type `kConverter` returns, except that
+  ///  `kConverter` is called directly instead of through the stored conversion
+  ///  function, so that it can be inlined. The parameter must have been
+  ///  created by `Parameter::Keyword<kConverter>` or
+  ///  `Parameter::Positional<kConverter>`. Example:
+  ///  `GetValue<converters::FromChars<int>>("count")`.
+  ///
+  /// @exceptions Same as `GetValue(const std::string&, int)`. Also throws
+  ///  `exceptions::ValueAccessError` if the parameter's conversion function
+  ///  was not bound to `kConverter` at compile time.
+  ///
+  template <auto kConverter>
+  auto GetValue(const std::string& name, int pos = 0) const;
+
+  /// @brief Same as `GetValue<kConverter>(const std::string&, int)`, but
+  ///  identifies the parameter by its integer-identifier `id`.
+  ///
+  template <auto kConverter>
+  auto GetValue(size_type id, int pos = 0) const;
 
   /// @brief Returns list of values of parameter.
   ///
@@ -248,7 +438,87 @@ class ArgumentMap {
   ///  * Conversion function may throw.
   ///
   template <class ParameterType>
-  std::vector<ParameterType> GetAllValues(const std::string& name);
+  std::vector<ParameterType> GetAllValues(const std::string& name) const;
+
+  /// @brief Returns list of values of parameter with integer-identifier `id`.
+  ///
+  /// @details Same as `GetAllValues(const std::string&)`, but skips the name
+  ///  lookup.
+  ///
+  /// @exceptions Same as `GetAllValues(const std::string&)`, where `id` takes
+  ///  the place of `name`.
+  ///
+  template <class ParameterType>
+  std::vector<ParameterType> GetAllValues(size_type id) const;
+
+  /// @brief Writes the values of the parameter identified by `name` to the
+  ///  array of length `size` beginning at `out`.
+  ///
+  /// @details Writes the same values as `GetAllValues` returns, to the first
+  ///  positions of the array, and returns their number. The parameter's
+  ///  metadata are looked up once for the whole list, and values are read from,
+  ///  or stored in, the object's cache as by `GetValue`. The conversions made
+  ///  are reported to the parse observer as one `ParsePhase::kConvert` phase.
+  ///
+  /// @exceptions Basic guarantee. Same exceptions as `GetAllValues`. Also
+  ///  throws `exceptions::ValueAccessError` if `size` is less than the number
+  ///  of arguments of the parameter. The contents of the array are unspecified
+  ///  if a conversion function throws.
+  ///
+  template <class ParameterType>
+  size_type GetAllValuesInto(const std::string& name, ParameterType* out,
+                             size_type size) const;
+
+  /// @brief Same as the overload taking `name`, but identifies the parameter
+  ///  by its integer-identifier `id`.
+  ///
+  template <class ParameterType>
+  size_type GetAllValuesInto(size_type id, ParameterType* out,
+                             size_type size) const;
+
+  /// @brief Appends the values of the parameter identified by `name` to `out`.
+  ///
+  /// @details Appends the same values as `GetAllValues` returns. Reusing `out`
+  ///  across calls avoids allocating a new vector for each call.
+  ///
+  /// @exceptions Strong guarantee. Same exceptions as `GetAllValues`.
+  ///
+  template <class ParameterType>
+  void GetAllValuesInto(const std::string& name,
+                        std::vector<ParameterType>& out) const;
+
+  /// @brief Same as the overload taking `name`, but identifies the parameter
+  ///  by its integer-identifier `id`.
+  ///
+  template <class ParameterType>
+  void GetAllValuesInto(size_type id, std::vector<ParameterType>& out) const;
+
+  /// @brief Converts the arguments of all parameters and stores the values.
+  ///
+  /// @details Each parameter's conversion function is evaluated at each of its
+  ///  arguments whose value was not computed before. Argument lists are split
+  ///  into chunks of at most `chunk_size` arguments and each chunk is passed to
+  ///  `executor` as a separate task; the function returns once all tasks are
+  ///  done. Flags and parameters without conversion functions are skipped.
+  ///  After a successful call, `GetValue` and `GetAllValues` only read the
+  ///  stored values.
+  ///
+  ///  The single-argument overload runs all tasks on the calling thread.
+  ///
+  /// @exceptions Basic guarantee.
+  ///  * Throws `exceptions::ValueConversionError` listing every failed
+  ///    conversion if one or more conversion functions threw. All other values
+  ///    are stored regardless.
+  ///  * Throws `exceptions::ValueAccessError` if `chunk_size` is 0.
+  ///  * Rethrows exceptions thrown by `executor` after all tasks it accepted
+  ///    are done.
+  ///
+  void ConvertAll(const Executor& executor,
+                  size_type chunk_size = kDefaultConversionChunkSize) const;
+
+  /// @copydoc ConvertAll(const Executor&, size_type) const
+  ///
+  void ConvertAll() const;
 
   /// @brief Returns whether or not the flag is set.
   ///
@@ -262,15 +532,15 @@ class ArgumentMap {
   ///    that is not a flag.
   ///
   inline bool IsSet(const std::string& name) const {
-    std::stringstream error_message;
-    if (parameters_.GetConfiguration(name).category()
-        != ParameterCategory::kFlag) {
+    int id{parameters_->GetId(name)};
+    if (!parameters_->layout().IsFlag(id)) {
+      std::stringstream error_message;
       error_message << "Parameter with name: '" << name << "' is not a flag."
                     << " Call `ArgumentMap::IsSet` only to check if a flag is"
                     << " set.";
       throw exceptions::ValueAccessError(error_message.str());
     }
-    return (arguments_.at(parameters_.GetId(name)).size() > 0);
+    return (arguments_[id].size() > 0);
   }
   /// @}
 
@@ -283,6 +553,16 @@ class ArgumentMap {
   /// @exceptions Strong guarantee.
   ///
   std::string DebugString() const;
+
+  /// @brief Returns the heap memory used by the object's arguments and values.
+  ///
+  /// @details Does not include the `ParameterMap` member, which may be shared
+  ///  with other objects; its usage is reported by
+  ///  `Parameters().MemoryUsage()`.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  MemoryReport MemoryUsage() const;
   /// @}
 
  private:
@@ -290,9 +570,149 @@ class ArgumentMap {
                                             ArgumentMap& arguments);
   friend std::vector<std::string> ParseFile(std::istream& config_is,
                                             ArgumentMap& arguments);
+
+  /// @brief State of a value which is computed at most once and then
+  ///  published to all threads.
+  ///
+  /// @details Copying a state while another thread computes its value yields
+  ///  an empty state.
+  ///
+  class ValueState {
+   public:
+    ValueState() = default;
+
+    ValueState(const ValueState& other) {*this = other;}
+
+    ValueState& operator=(const ValueState& other) {
+      if (this != &other) {
+        state_.store(other.HasValue() ? kReady : kEmpty,
+                     std::memory_order_release);
+      }
+      return *this;
+    }
+
+    /// @brief Indicates whether the value was published.
+    ///
+    inline bool HasValue() const {
+      return (state_.load(std::memory_order_acquire) == kReady);
+    }
+
+    /// @brief Returns `value`, computing it with `compute` first if it was
+    ///  not published yet.
+    ///
+    /// @details Only one thread evaluates `compute` at a time; other threads
+    ///  asking for the value meanwhile wait for the result. If `compute`
+    ///  throws, the state remains empty and the exception is propagated.
+    ///
+    template <class Compute>
+    const std::any& GetOrCompute(std::any& value, Compute&& compute) const {
+      int state{state_.load(std::memory_order_acquire)};
+      internal::CountEvent(state == kReady ? PerfCounter::kCacheHits
+                                           : PerfCounter::kCacheMisses);
+      while (state != kReady) {
+        if (state == kEmpty) {
+          if (state_.compare_exchange_weak(state, kBusy,
+                                           std::memory_order_acquire)) {
+            internal::CountEvent(PerfCounter::kConversions);
+            try {
+              value = compute();
+            } catch (...) {
+              internal::CountEvent(PerfCounter::kConversionFailures);
+              state_.store(kEmpty, std::memory_order_release);
+              throw;
+            }
+            state_.store(kReady, std::memory_order_release);
+            return value;
+          }
+        } else {
+          std::this_thread::yield();
+          state = state_.load(std::memory_order_acquire);
+        }
+      }
+      return value;
+    }
+
+   private:
+    static constexpr int kEmpty{0}, kBusy{1}, kReady{2};
+
+    mutable std::atomic<int> state_{kEmpty};
+  };
+
+  /// @brief Throws `exceptions::ValueAccessError` if the parameter with
+  ///  integer-identifier `id` has no conversion function, or is a flag.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  void CheckValueAccess(size_type id, bool has_converter) const;
+
+  /// @brief Throws `exceptions::ValueAccessError` if the parameter with
+  ///  integer-identifier `id` has no argument at position `pos`.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  void CheckPosition(size_type id, int pos) const;
+
+  /// @brief Returns the value at position `pos` of the parameter with
+  ///  integer-identifier `id`, converting its argument with `convert` if it
+  ///  was not converted yet.
+  ///
+  /// @details `id` and `pos` must identify an argument, and `convert` must
+  ///  compute the same values as the parameter's conversion function.
+  ///
+  template <class ParameterType, class Convert>
+  const ParameterType& ValueAt(const Convert& convert, size_type id,
+                               size_type pos) const;
+
+  /// @brief Passes the values of the parameter with integer-identifier `id`
+  ///  to `output` in order, converting arguments with `convert` if they were
+  ///  not converted yet.
+  ///
+  /// @details Requirements are the same as for `ValueAt`. Published values are
+  ///  read without computing anything. All conversions are reported as one
+  ///  trace event and, if an observer is set, one `ParsePhase::kConvert`
+  ///  phase.
+  ///
+  template <class ParameterType, class Convert, class Output>
+  void ForEachValue(const Convert& convert, size_type id,
+                    Output&& output) const;
+
+  /// @brief Resizes the value list of the parameter with integer-identifier
+  ///  `id` to the size of its argument list, if it has a conversion function.
+  ///
+  /// @details Must be called after the argument list was modified directly.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline void ResizeValueList(size_type id) {
+    if (parameters_->ValueConversionFunction(id) == nullptr) {
+      return;
+    }
+    size_type size{arguments_.at(id).size()};
+    value_states_.at(id).resize(size);
+    try {
+      value_lists_.at(id).resize(size);
+    } catch (...) {
+      value_states_.at(id).resize(value_lists_.at(id).size());
+      throw;
+    }
+  }
+
+  /// @brief Resizes each value list to the size of the corresponding argument
+  ///  list.
+  ///
+  /// @details Must be called after argument lists were modified directly.
+  ///
+  inline void ResizeValueLists() {
+    for (size_type id = 0; id < arguments_.size(); ++id) {
+      ResizeValueList(id);
+    }
+  }
+
   /// @brief `ParameterMap` object associated with the object.
   ///
-  ParameterMap parameters_;
+  /// @details Only null in moved-from objects.
+  ///
+  std::shared_ptr<const ParameterMap> parameters_;
 
   /// @brief Lists of arguments of parameters stored in the object.
   ///
@@ -305,84 +725,241 @@ class ArgumentMap {
   ///
   /// @details Parameters' integer identifiers are the positions of the
   ///  associated `ParameterConfiguration` objects in `parameters_`. Each
-  ///  parameter's values are stored in this list when call to `GetValue`, or
-  ///  `GetValues` is made.
+  ///  parameter's values are stored in this list when call to `GetValue`,
+  ///  `GetAllValues`, or `ConvertAll` is made. A value may only be read once
+  ///  its state in `value_states_` is published.
+  ///
+  mutable std::vector<std::vector<std::any>> value_lists_;
+
+  /// @brief States of the values in `value_lists_`, at the same positions.
   ///
-  std::vector<std::vector<std::any>> value_lists_;
+  std::vector<std::vector<ValueState>> value_states_;
+
+  /// @brief Observer notified of parse phases, if not null.
+  ///
+  ParseObserver* parse_observer_{nullptr};
+
+  /// @brief Writer capturing parser inputs, if not null.
+  ///
+  TraceWriter* trace_writer_{nullptr};
+
+  /// @brief Integer-identifier of the subcommand `ParseArgs` reached, or
+  ///  `ParameterMap::kNoMatch`.
+  ///
+  int subcommand_{ParameterMap::kNoMatch};
+
+  /// @brief Arguments of the subcommand `ParseArgs` reached.
+  ///
+  /// @details Not null if and only if `subcommand_` identifies a subcommand.
+  ///
+  std::unique_ptr<ArgumentMap> subcommand_arguments_;
 };
 /// @}
 
 // ArgumentMap::GetValue
 //
 template <class ParameterType>
-ParameterType ArgumentMap::GetValue(const std::string& name, int pos) {
-  int id{parameters_.GetId(name)};
-  std::function<ParameterType(const std::string&)> converter{
-      parameters_.ConversionFunction<ParameterType>(name)};
-  std::stringstream error_message;
-
-  // Test if argument at position `pos` was assigned.
-  if (static_cast<int>(arguments_.at(id).size()) <= pos) {
-    error_message << "Attempted to access argument at position '" << pos
-                  << "' for parameter named '" << name << "' but only '"
-                  << arguments_.at(id).size()
-                  << "' arguments were assigned.";
-    throw exceptions::ValueAccessError(error_message.str());
-  }
-  // Test if parameter has a conversion function.
-  if (converter == nullptr) {
-    error_message << "Parameter identified by '" << name << "' has no"
-                  << " conversion function associated with it.";
-    throw exceptions::ValueAccessError(error_message.str());
-  }
-  // Test if `name` is a flag.
-  if (parameters_.flags().count(id)) {
-    error_message << "Attempted to use `ArgumentMap::GetValue` to check if flag"
-                     " named: '" <<  name << "' was set. Use"
-                     " `ArgumentMap::IsSet` to test flag values.";
+ParameterType ArgumentMap::GetValue(const std::string& name, int pos) const {
+  return GetValue<ParameterType>(
+      static_cast<size_type>(parameters_->GetId(name)), pos);
+}
+
+// ArgumentMap::GetValue
+//
+template <class ParameterType>
+ParameterType ArgumentMap::GetValue(size_type id, int pos) const {
+  const std::function<ParameterType(const std::string&)>& converter{
+      parameters_->ConversionFunction<ParameterType>(id)};
+  CheckValueAccess(id, converter != nullptr);
+  CheckPosition(id, pos);
+  return ValueAt<ParameterType>(converter, id, static_cast<size_type>(pos));
+}
+
+// ArgumentMap::GetValue
+//
+template <auto kConverter>
+auto ArgumentMap::GetValue(const std::string& name, int pos) const {
+  return GetValue<kConverter>(
+      static_cast<size_type>(parameters_->GetId(name)), pos);
+}
+
+// ArgumentMap::GetValue
+//
+template <auto kConverter>
+auto ArgumentMap::GetValue(size_type id, int pos) const {
+  using Converter = converters::StaticConverter<kConverter>;
+  using ParameterType = std::decay_t<
+      std::invoke_result_t<const Converter&, const std::string&>>;
+  using StaticConverter = typename Parameter<ParameterType>::StaticConverter;
+  const std::function<ParameterType(const std::string&)>& converter{
+      parameters_->ConversionFunction<ParameterType>(id)};
+  CheckValueAccess(id, converter != nullptr);
+
+  // Values in the cache must have been computed by the same function.
+  const StaticConverter* bound{converter.template target<StaticConverter>()};
+  if (bound == nullptr
+      || *bound != &Parameter<ParameterType>::template StaticConvert<
+                        Converter>) {
+    std::stringstream error_message;
+    error_message << "Attempted to use `ArgumentMap::GetValue` with a"
+                     " conversion function other than the one bound to"
+                     " parameter named: '" << parameters_->GetPrimaryName(id)
+                  << "'.";
     throw exceptions::ValueAccessError(error_message.str());
   }
+  CheckPosition(id, pos);
+  return ValueAt<ParameterType>(Converter{}, id, static_cast<size_type>(pos));
+}
 
-  // Compute value only if it wasn't computed before.
-  if (static_cast<int>(value_lists_.at(id).size()) <= pos
-      || !value_lists_.at(id).at(pos).has_value()) {
-    value_lists_.at(id).reserve(pos);
-    for (int i = value_lists_.at(id).size(); i < pos; ++i) {
-      value_lists_.at(id).emplace_back();
-    }
-    value_lists_.at(id).emplace_back(converter(arguments_.at(id).at(pos)));
-  }
-  return std::any_cast<ParameterType>(value_lists_.at(id).at(pos));
+// ArgumentMap::GetAllValues
+//
+template <class ParameterType>
+std::vector<ParameterType> ArgumentMap::GetAllValues(
+    const std::string& name) const {
+  std::vector<ParameterType> result;
+  GetAllValuesInto(static_cast<size_type>(parameters_->GetId(name)), result);
+  return result;
 }
 
 // ArgumentMap::GetAllValues
 //
 template <class ParameterType>
-std::vector<ParameterType> ArgumentMap::GetAllValues(const std::string& name) {
+std::vector<ParameterType> ArgumentMap::GetAllValues(size_type id) const {
   std::vector<ParameterType> result;
-  int id{parameters_.GetId(name)};
-  std::function<ParameterType(const std::string&)> converter{
-      parameters_.ConversionFunction<ParameterType>(name)};
-  std::stringstream error_message;
-
-  // Test if parameter has a conversion function.
-  if (converter == nullptr) {
-    error_message << "Parameter identified by '" << name << "' has no"
-                  << " conversion function associated with it.";
+  GetAllValuesInto(id, result);
+  return result;
+}
+
+// ArgumentMap::GetAllValuesInto
+//
+template <class ParameterType>
+ArgumentMap::size_type ArgumentMap::GetAllValuesInto(
+    const std::string& name, ParameterType* out, size_type size) const {
+  return GetAllValuesInto(static_cast<size_type>(parameters_->GetId(name)),
+                          out, size);
+}
+
+// ArgumentMap::GetAllValuesInto
+//
+template <class ParameterType>
+ArgumentMap::size_type ArgumentMap::GetAllValuesInto(
+    size_type id, ParameterType* out, size_type size) const {
+  const std::function<ParameterType(const std::string&)>& converter{
+      parameters_->ConversionFunction<ParameterType>(id)};
+  CheckValueAccess(id, converter != nullptr);
+  const std::vector<std::string>& arguments{arguments_[id]};
+
+  if (size < arguments.size()) {
+    std::stringstream error_message;
+    error_message << "Attempted to write '" << arguments.size() << "' values"
+                  << " of parameter named '" << parameters_->GetPrimaryName(id)
+                  << "' into space for only '" << size << "' values.";
     throw exceptions::ValueAccessError(error_message.str());
   }
-  // Test if `name` is a flag.
-  if (parameters_.flags().count(id)) {
-    error_message << "Attempted to use `ArgumentMap::GetValue` to check if flag"
-                     " named: '" <<  name << "' was set. Use"
-                     " `ArgumentMap::IsSet` to test flag values.";
-    throw exceptions::ValueAccessError(error_message.str());
+  ForEachValue<ParameterType>(converter, id,
+                              [out](const ParameterType& value) mutable {
+    *out++ = value;
+  });
+  return arguments.size();
+}
+
+// ArgumentMap::GetAllValuesInto
+//
+template <class ParameterType>
+void ArgumentMap::GetAllValuesInto(const std::string& name,
+                                   std::vector<ParameterType>& out) const {
+  GetAllValuesInto(static_cast<size_type>(parameters_->GetId(name)), out);
+}
+
+// ArgumentMap::GetAllValuesInto
+//
+template <class ParameterType>
+void ArgumentMap::GetAllValuesInto(size_type id,
+                                   std::vector<ParameterType>& out) const {
+  const std::function<ParameterType(const std::string&)>& converter{
+      parameters_->ConversionFunction<ParameterType>(id)};
+  CheckValueAccess(id, converter != nullptr);
+  const std::vector<std::string>& arguments{arguments_[id]};
+  size_type old_size{out.size()};
+
+  out.reserve(old_size + arguments.size());
+  try {
+    ForEachValue<ParameterType>(converter, id,
+                                [&out](const ParameterType& value) {
+      out.emplace_back(value);
+    });
+  } catch (...) {
+    out.erase(out.begin() + old_size, out.end());
+    throw;
   }
+}
 
-  for (int pos = 0; pos < static_cast<int>(arguments_.at(id).size()); ++pos) {
-    result.push_back(GetValue<ParameterType>(name, pos));
+// ArgumentMap::ValueAt
+//
+template <class ParameterType, class Convert>
+const ParameterType& ArgumentMap::ValueAt(const Convert& convert, size_type id,
+                                          size_type pos) const {
+  // Compute value only if it wasn't computed before.
+  const std::string& argument{arguments_[id][pos]};
+  const std::any& value{value_states_[id][pos].GetOrCompute(
+      value_lists_[id][pos], [&] {
+    TraceEventScope trace_event{"Convert", *parameters_,
+                                static_cast<int>(id)};
+    if (parse_observer_ == nullptr) {
+      return std::any{std::in_place_type<ParameterType>, convert(argument)};
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::any result{std::in_place_type<ParameterType>, convert(argument)};
+    PhaseStatistics statistics;
+    statistics.tokens = 1;
+    statistics.bytes = argument.size();
+    statistics.elapsed = std::chrono::steady_clock::now() - start;
+    parse_observer_->OnPhase(ParsePhase::kConvert, statistics);
+    return result;
+  })};
+  return *std::any_cast<ParameterType>(&value);
+}
+
+// ArgumentMap::ForEachValue
+//
+template <class ParameterType, class Convert, class Output>
+void ArgumentMap::ForEachValue(const Convert& convert, size_type id,
+                               Output&& output) const {
+  const std::vector<std::string>& arguments{arguments_[id]};
+  const std::vector<ValueState>& states{value_states_[id]};
+  std::vector<std::any>& values{value_lists_[id]};
+  TraceEventScope trace_event{"Convert", *parameters_, static_cast<int>(id)};
+  PhaseStatistics statistics;
+  std::uint64_t num_hits{0};
+  auto start = (parse_observer_ != nullptr
+                    ? std::chrono::steady_clock::now()
+                    : std::chrono::steady_clock::time_point{});
+  auto report = [&] {
+    internal::CountEvent(PerfCounter::kCacheHits, num_hits);
+    if (parse_observer_ != nullptr && statistics.tokens > 0) {
+      statistics.elapsed = std::chrono::steady_clock::now() - start;
+      parse_observer_->OnPhase(ParsePhase::kConvert, statistics);
+    }
+  };
+  try {
+    for (size_type pos = 0; pos < arguments.size(); ++pos) {
+      if (states[pos].HasValue()) {
+        ++num_hits;
+      } else {
+        states[pos].GetOrCompute(values[pos], [&] {
+          ++statistics.tokens;
+          statistics.bytes += arguments[pos].size();
+          return std::any{std::in_place_type<ParameterType>,
+                          convert(arguments[pos])};
+        });
+      }
+      output(*std::any_cast<ParameterType>(&values[pos]));
+    }
+  } catch (...) {
+    report();
+    throw;
   }
-  return result;
+  report();
 }
 
 } // namespace arg_parse_convert
@@ -21,13 +21,32 @@
 #ifndef ARG_PARSE_CONVERT_CONVERSION_FUNCTIONS_H_
 #define ARG_PARSE_CONVERT_CONVERSION_FUNCTIONS_H_
 
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
 #include <functional>
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
 
 namespace arg_parse_convert {
 
 namespace converters {
 
+/// @brief Function object calling `kConverter`.
+///
+/// @details The called function is part of the type, so calls through the
+///  object can be inlined, and the object has no state to store.
+///
+template <auto kConverter>
+struct StaticConverter {
+  inline auto operator()(const std::string& s) const {return kConverter(s);}
+};
+
 // Placeholder that is only used for flags. Never actually evaluated.
 inline bool FlagConverter(const std::string& s) {return true;}
 
@@ -42,7 +61,286 @@ inline float stof(const std::string& s) {return std::stof(s);}
 inline double stod(const std::string& s) {return std::stod(s);}
 inline long double stold(const std::string& s) {return std::stold(s);}
 
-} // namespace stl_converters
+/// @brief Parses all of `text` as a number of type `NumberType` and stores the
+///  result in `value`.
+///
+/// @details Parsing does not depend on the locale. Integers consist of an
+///  optional sign, an optional base prefix (`0x` for hexadecimal, `0o` for
+///  octal, `0b` for binary; case-insensitive) and digits. Floating point
+///  numbers consist of an optional sign and a decimal, or `0x`-prefixed
+///  hexadecimal number in the format accepted by `std::from_chars`. If
+///  `kDigitSeparator` is not `'\0'`, it may appear between any two digits and
+///  is ignored.
+///
+/// @return `std::errc{}` on success, `std::errc::invalid_argument` if `text`
+///  is not entirely a number of the expected format, and
+///  `std::errc::result_out_of_range` if the number is not representable by
+///  `NumberType`. `value` is only modified on success.
+///
+/// @exceptions No-throw guarantee, unless separators are used, in which case
+///  memory allocation may throw.
+///
+template <class NumberType, char kDigitSeparator = '\0'>
+std::errc ParseNumber(std::string_view text, NumberType& value);
+
+/// @brief Converts `s` to a number of type `NumberType` using `ParseNumber`.
+///
+/// @exceptions Strong guarantee. Throws `std::invalid_argument` if `s` is not
+///  entirely a number of the expected format and `std::out_of_range` if the
+///  number is not representable by `NumberType`.
+///
+template <class NumberType, char kDigitSeparator = '\0'>
+NumberType FromChars(const std::string& s);
+
+/// @brief Parses `text` as a list of elements separated by `kDelimiter` and
+///  appends the elements to `values`.
+///
+/// @details Numeric elements are parsed from views into `text` by
+///  `ParseNumber`, so no string is created per element, and `values` grows
+///  at most once. An empty `text` is an empty list; empty elements are invalid
+///  unless `ElementType` is `std::string`.
+///
+/// @return `std::errc{}` on success, or the error `ParseNumber` returned for
+///  the first invalid element, in which case `values` is left unchanged and
+///  the element is stored in `invalid_element`, unless it is null.
+///
+/// @exceptions Strong guarantee. Memory allocation may throw.
+///
+template <class ElementType, char kDelimiter = ',',
+          char kDigitSeparator = '\0'>
+std::errc ParseDelimitedList(std::string_view text,
+                             std::vector<ElementType>& values,
+                             std::string_view* invalid_element = nullptr);
+
+/// @brief Converts `s` to a list of elements using `ParseDelimitedList`.
+///
+/// @details Used as conversion function of list parameters, e.g.
+///  `Parameter<std::vector<int>>::Keyword<DelimitedList<int>>({"ids"})`.
+///
+/// @exceptions Strong guarantee. Throws `std::invalid_argument` if an element
+///  is not a number of the expected format and `std::out_of_range` if an
+///  element is not representable by `ElementType`.
+///
+template <class ElementType, char kDelimiter = ',',
+          char kDigitSeparator = '\0'>
+std::vector<ElementType> DelimitedList(const std::string& s);
+
+// Implementation details of `ParseNumber`.
+//
+namespace internal {
+
+// Removes separators from `text` into `buffer`. Returns false if a separator
+// is not between two alphanumeric characters.
+//
+inline bool RemoveSeparators(std::string_view text, char separator,
+                             std::string& buffer) {
+  auto is_digit = [](char c) {
+    return (('0' <= c && c <= '9') || ('a' <= c && c <= 'z')
+            || ('A' <= c && c <= 'Z'));
+  };
+  buffer.clear();
+  buffer.reserve(text.length());
+  for (std::string_view::size_type i = 0; i < text.length(); ++i) {
+    if (text[i] != separator) {
+      buffer.push_back(text[i]);
+    } else if (i == 0 || i + 1 == text.length() || !is_digit(text[i - 1])
+               || !is_digit(text[i + 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Removes a base prefix from `text` and returns the base it indicates.
+//
+inline int ConsumeBasePrefix(std::string_view& text) {
+  if (text.length() > 2 && text[0] == '0') {
+    switch (text[1]) {
+      case 'x': case 'X': text.remove_prefix(2); return 16;
+      case 'o': case 'O': text.remove_prefix(2); return 8;
+      case 'b': case 'B': text.remove_prefix(2); return 2;
+      default: break;
+    }
+  }
+  return 10;
+}
+
+template <class NumberType>
+std::errc ParseInteger(std::string_view text, NumberType& value) {
+  using UnsignedType = std::make_unsigned_t<NumberType>;
+  bool negative{false};
+  if (!text.empty() && (text[0] == '+' || text[0] == '-')) {
+    negative = (text[0] == '-');
+    text.remove_prefix(1);
+  }
+  int base{ConsumeBasePrefix(text)};
+  UnsignedType magnitude;
+  if (text.empty() || text[0] == '+' || text[0] == '-') {
+    return std::errc::invalid_argument;
+  }
+  std::from_chars_result result{std::from_chars(
+      text.data(), text.data() + text.length(), magnitude, base)};
+  if (result.ec != std::errc{}) {
+    return result.ec;
+  } else if (result.ptr != text.data() + text.length()) {
+    return std::errc::invalid_argument;
+  }
+  if (!negative) {
+    if (magnitude > static_cast<UnsignedType>(
+                        std::numeric_limits<NumberType>::max())) {
+      return std::errc::result_out_of_range;
+    }
+    value = static_cast<NumberType>(magnitude);
+  } else if (magnitude == 0) {
+    value = 0;
+  } else if constexpr (std::is_signed_v<NumberType>) {
+    // Magnitude of the minimum is one more than the magnitude of the maximum.
+    if (magnitude - 1 > static_cast<UnsignedType>(
+                            std::numeric_limits<NumberType>::max())) {
+      return std::errc::result_out_of_range;
+    }
+    value = static_cast<NumberType>(-static_cast<NumberType>(magnitude - 1)
+                                    - 1);
+  } else {
+    return std::errc::result_out_of_range;
+  }
+  return std::errc{};
+}
+
+template <class NumberType>
+std::errc ParseFloatingPoint(std::string_view text, NumberType& value) {
+  bool negative{false};
+  std::chars_format format{std::chars_format::general};
+  if (!text.empty() && (text[0] == '+' || text[0] == '-')) {
+    negative = (text[0] == '-');
+    text.remove_prefix(1);
+  }
+  if (text.length() > 2 && text[0] == '0'
+      && (text[1] == 'x' || text[1] == 'X')) {
+    format = std::chars_format::hex;
+    text.remove_prefix(2);
+  }
+  NumberType result_value;
+  if (text.empty() || text[0] == '+' || text[0] == '-') {
+    return std::errc::invalid_argument;
+  }
+  std::from_chars_result result{std::from_chars(
+      text.data(), text.data() + text.length(), result_value, format)};
+  if (result.ec != std::errc{}) {
+    return result.ec;
+  } else if (result.ptr != text.data() + text.length()) {
+    return std::errc::invalid_argument;
+  }
+  value = negative ? -result_value : result_value;
+  return std::errc{};
+}
+
+} // namespace internal
+
+// ParseNumber
+//
+template <class NumberType, char kDigitSeparator>
+std::errc ParseNumber(std::string_view text, NumberType& value) {
+  static_assert(std::is_arithmetic_v<NumberType>
+                && !std::is_same_v<NumberType, bool>,
+                "`ParseNumber` requires an integer or floating point type.");
+  std::string buffer;
+  if (kDigitSeparator != '\0'
+      && text.find(kDigitSeparator) != std::string_view::npos) {
+    if (!internal::RemoveSeparators(text, kDigitSeparator, buffer)) {
+      return std::errc::invalid_argument;
+    }
+    text = buffer;
+  }
+  if constexpr (std::is_integral_v<NumberType>) {
+    return internal::ParseInteger(text, value);
+  } else {
+    return internal::ParseFloatingPoint(text, value);
+  }
+}
+
+// FromChars
+//
+template <class NumberType, char kDigitSeparator>
+NumberType FromChars(const std::string& s) {
+  NumberType value;
+  std::errc error{ParseNumber<NumberType, kDigitSeparator>(s, value)};
+  if (error == std::errc{}) {
+    return value;
+  } else if (error == std::errc::result_out_of_range) {
+    throw std::out_of_range("Number out of range: '" + s + "'.");
+  } else {
+    throw std::invalid_argument("Not a valid number: '" + s + "'.");
+  }
+}
+
+// ParseDelimitedList
+//
+template <class ElementType, char kDelimiter, char kDigitSeparator>
+std::errc ParseDelimitedList(std::string_view text,
+                             std::vector<ElementType>& values,
+                             std::string_view* invalid_element) {
+  static_assert(kDelimiter != kDigitSeparator,
+                "Delimiter and digit separator must differ.");
+  if (text.empty()) {
+    return std::errc{};
+  }
+  // Counting is vectorized by the compiler and finding the next delimiter uses
+  // `std::memchr`, so both passes skip over many characters at a time.
+  values.reserve(values.size() + 1
+                 + std::count(text.cbegin(), text.cend(), kDelimiter));
+  auto old_size = values.size();
+  std::string_view::size_type start{0}, end;
+  do {
+    end = text.find(kDelimiter, start);
+    std::string_view element{text.substr(start, end - start)};
+    if constexpr (std::is_same_v<ElementType, std::string>) {
+      values.emplace_back(element);
+    } else {
+      ElementType value;
+      std::errc error{
+          ParseNumber<ElementType, kDigitSeparator>(element, value)};
+      if (error != std::errc{}) {
+        values.erase(values.begin() + old_size, values.end());
+        if (invalid_element != nullptr) {
+          *invalid_element = element;
+        }
+        return error;
+      }
+      values.push_back(value);
+    }
+    start = end + 1;
+  } while (end != std::string_view::npos);
+  return std::errc{};
+}
+
+// DelimitedList
+//
+template <class ElementType, char kDelimiter, char kDigitSeparator>
+std::vector<ElementType> DelimitedList(const std::string& s) {
+  std::vector<ElementType> values;
+  std::string_view invalid_element;
+  std::errc error{ParseDelimitedList<ElementType, kDelimiter, kDigitSeparator>(
+      s, values, &invalid_element)};
+  if (error == std::errc{}) {
+    return values;
+  }
+  std::string message{error == std::errc::result_out_of_range
+                          ? "Number out of range: '"
+                          : "Not a valid number: '"};
+  message.append(invalid_element)
+         .append("' (element ")
+         .append(std::to_string(std::count(s.data(), invalid_element.data(),
+                                           kDelimiter)))
+         .append(" of list).");
+  if (error == std::errc::result_out_of_range) {
+    throw std::out_of_range(message);
+  } else {
+    throw std::invalid_argument(message);
+  }
+}
+
+} // namespace converters
 
 } // namespace arg_parse_convert
 
@@ -21,7 +21,13 @@
 #ifndef ARG_PARSE_CONVERT_EXCEPTIONS_H_
 #define ARG_PARSE_CONVERT_EXCEPTIONS_H_
 
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.h"
 
 namespace arg_parse_convert {
 
@@ -31,10 +37,18 @@ namespace exceptions {
 ///  `arg_parse_convert` namespace.
 ///
 /// @details Only exceptions of a final derived type or exceptions from STL
-///  operations are thrown.
+///  operations are thrown. Creating one counts
+///  `PerfCounter::kExceptions`.
 ///
 struct BaseError : public std::logic_error {
-  using std::logic_error::logic_error;
+  explicit BaseError(const std::string& what_arg)
+      : std::logic_error{what_arg} {
+    internal::CountEvent(PerfCounter::kExceptions);
+  }
+
+  explicit BaseError(const char* what_arg) : std::logic_error{what_arg} {
+    internal::CountEvent(PerfCounter::kExceptions);
+  }
 };
 
 /// @brief Exception thrown while configuring a parameter.
@@ -61,10 +75,38 @@ struct ValueAccessError final : public BaseError {
   using BaseError::BaseError;
 };
 
+/// @brief Exception thrown when one or more arguments could not be converted
+///  to values.
+///
+struct ValueConversionError final : public BaseError {
+  using BaseError::BaseError;
+};
+
 /// @brief Exception thrown while parsing arguments.
 ///
 struct ArgumentParsingError final : public BaseError {
   using BaseError::BaseError;
+
+  /// @brief Constructs an error about an unknown parameter name which lists
+  ///  `suggestions`, the known names closest to it.
+  ///
+  ArgumentParsingError(const std::string& what_arg,
+                       std::vector<std::string> suggestions)
+      : BaseError{what_arg},
+        suggestions_{std::make_shared<const std::vector<std::string>>(
+            std::move(suggestions))} {}
+
+  /// @brief Returns the names suggested in place of an unknown one, nearest
+  ///  first, without hyphens.
+  ///
+  inline const std::vector<std::string>& suggestions() const noexcept {
+    static const std::vector<std::string> no_suggestions;
+    return (suggestions_ != nullptr ? *suggestions_ : no_suggestions);
+  }
+
+ private:
+  // Shared, so that copying the exception does not throw.
+  std::shared_ptr<const std::vector<std::string>> suggestions_;
 };
 
 /// @brief Exception thrown while generating help-strings.
@@ -73,6 +115,13 @@ struct HelpStringError final : public BaseError {
   using BaseError::BaseError;
 };
 
+/// @brief Exception thrown while reading malformed traces, or capturing
+///  schemas traces cannot represent.
+///
+struct TraceFormatError final : public BaseError {
+  using BaseError::BaseError;
+};
+
 } // namespace exceptions
 
 } // namespace arg_parse_convert
@@ -0,0 +1,200 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_HELP_TEXT_H_
+#define ARG_PARSE_CONVERT_HELP_TEXT_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "lazy_shared.h"
+#include "memory_report.h"
+
+namespace arg_parse_convert {
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Text only read when help-strings are generated, such as a
+///  parameter's description, which is stored without being built or copied.
+///
+/// @details The text is either a view of storage that outlives the object,
+///  e.g. a string literal, a string owned by the object, or a function called
+///  whenever the text is read. Copies share owned strings and functions, so
+///  copying an object never allocates memory.
+///
+///  Only `cached_str` keeps the text it builds, which copies made afterwards
+///  share.
+///
+class HelpText {
+ public:
+  /// @name Constructors:
+  ///
+  /// @{
+
+  /// @brief Constructs an empty text.
+  ///
+  HelpText() = default;
+
+  /// @brief Constructs an object owning `text`.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  explicit HelpText(std::string text) {
+    if (!text.empty()) {
+      auto owned = std::make_shared<const std::string>(std::move(text));
+      text_ = *owned;
+      storage_ = std::move(owned);
+    }
+  }
+
+  /// @brief Constructs an object whose text is returned by `provider`, which
+  ///  is called each time the text is read.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  explicit HelpText(std::function<std::string()> provider) {
+    if (provider != nullptr) {
+      storage_ = std::make_shared<const std::function<std::string()>>(
+          std::move(provider));
+    }
+  }
+
+  /// @brief Constructs an object viewing `text`, which must outlive the object
+  ///  and its copies, e.g. because it is a string literal.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  static inline HelpText Static(std::string_view text) noexcept {
+    HelpText result;
+    result.text_ = text;
+    return result;
+  }
+  /// @}
+
+  /// @name Accessors:
+  ///
+  /// @{
+
+  /// @brief Indicates whether the text is returned by a function.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  inline bool IsProvided() const noexcept {
+    return (text_.data() == nullptr && storage_ != nullptr);
+  }
+
+  /// @brief Returns the text, calling its function if it has one.
+  ///
+  /// @exceptions Strong guarantee. The function may throw.
+  ///
+  inline std::string str() const {
+    if (IsProvided()) {
+      return (*std::static_pointer_cast<const std::function<std::string()>>(
+          storage_))();
+    }
+    return std::string{text_};
+  }
+
+  /// @brief Returns the text, which is built on the first call, calling its
+  ///  function if it has one, unless the object owns it.
+  ///
+  /// @details The returned string lives as long as the object or a copy of
+  ///  it made afterwards. Safe to call concurrently.
+  ///
+  /// @exceptions Strong guarantee. The function may throw.
+  ///
+  inline const std::string& cached_str() const {
+    if (storage_ != nullptr && !IsProvided()) {
+      return *std::static_pointer_cast<const std::string>(storage_);
+    }
+    std::shared_ptr<const std::string> cached{cached_.Get()};
+    if (cached == nullptr) {
+      cached = cached_.Publish(std::make_shared<const std::string>(str()));
+    }
+    return *cached;
+  }
+
+  /// @brief Heap memory used by the object, not counting state owned by its
+  ///  function.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  inline std::size_t HeapSize() const noexcept {
+    std::size_t result{0};
+    if (std::shared_ptr<const std::string> cached{cached_.Get()};
+        cached != nullptr) {
+      result += (internal::SharedHeapSize<std::string>()
+                 + internal::HeapSize(*cached));
+    }
+    if (storage_ == nullptr) {
+      return result;
+    } else if (IsProvided()) {
+      return (result
+              + internal::SharedHeapSize<std::function<std::string()>>());
+    }
+    return (result + internal::SharedHeapSize<std::string>()
+            + internal::HeapSize(*std::static_pointer_cast<const std::string>(
+                  storage_)));
+  }
+  /// @}
+
+  /// @name Other:
+  ///
+  /// @{
+
+  /// @brief Compares the texts of the object and `other`, unless either is
+  ///  returned by a function; then compares whether both share it.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  inline bool operator==(const HelpText& other) const noexcept {
+    if (!IsProvided() && !other.IsProvided()) {
+      return (text_ == other.text_);
+    }
+    return (storage_ == other.storage_);
+  }
+  /// @}
+
+ private:
+  /// @brief The text, unless it is returned by a function; then its data
+  ///  pointer is null.
+  ///
+  std::string_view text_;
+
+  /// @brief The owned string `text_` views, the function returning the text,
+  ///  or null.
+  ///
+  std::shared_ptr<const void> storage_;
+
+  /// @brief Text built by `cached_str`, unless the object owns it.
+  ///
+  internal::LazyShared<std::string> cached_;
+};
+/// @}
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_HELP_TEXT_H_
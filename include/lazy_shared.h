@@ -0,0 +1,89 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_LAZY_SHARED_H_
+#define ARG_PARSE_CONVERT_LAZY_SHARED_H_
+
+#include <memory>
+#include <utility>
+
+namespace arg_parse_convert {
+
+namespace internal {
+
+// Holds a `T` created on first use by a const object that may be shared by
+// several threads.
+//
+// Creation is not synchronized beyond publishing the result atomically, so
+// concurrent first uses may each create an object; all but one are
+// discarded. Copies share the object.
+//
+template <class T>
+class LazyShared {
+ public:
+  LazyShared() = default;
+
+  inline LazyShared(const LazyShared& other)
+      : object_{std::atomic_load(&other.object_)} {}
+
+  inline LazyShared(LazyShared&& other) noexcept
+      : object_{std::move(other.object_)} {}
+
+  inline LazyShared& operator=(const LazyShared& other) {
+    std::atomic_store(&object_, std::atomic_load(&other.object_));
+    return *this;
+  }
+
+  inline LazyShared& operator=(LazyShared&& other) noexcept {
+    object_ = std::move(other.object_);
+    return *this;
+  }
+
+  // Returns the object, or null if none was published since the last
+  // `Reset`.
+  //
+  inline std::shared_ptr<const T> Get() const {
+    return std::atomic_load(&object_);
+  }
+
+  // Publishes `object` unless another one was published first, and returns
+  // the published object.
+  //
+  std::shared_ptr<const T> Publish(std::shared_ptr<const T> object) const {
+    std::shared_ptr<const T> expected;
+    if (std::atomic_compare_exchange_strong(&object_, &expected, object)) {
+      return object;
+    }
+    return expected;
+  }
+
+  // Discards the object, e.g. because what it was created from changed.
+  //
+  inline void Reset() {std::atomic_store(&object_, {});}
+
+ private:
+  mutable std::shared_ptr<const T> object_;
+};
+
+} // namespace internal
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_LAZY_SHARED_H_
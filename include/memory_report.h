@@ -0,0 +1,201 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_MEMORY_REPORT_H_
+#define ARG_PARSE_CONVERT_MEMORY_REPORT_H_
+
+#include <any>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace arg_parse_convert {
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Heap memory used by an object, in bytes, broken down by purpose.
+///
+/// @details Sizes are computed from the objects' containers, so they are
+///  accurate for the standard library the code was compiled with, as long as
+///  it allocates nodes and small objects the way libstdc++ does; they do not
+///  include state owned by user-provided conversion functions or by values
+///  other than strings.
+///
+struct MemoryReport {
+  /// @brief Parameter names, including the pool of their copies used for
+  ///  lookup, which may be shared with other objects.
+  ///
+  std::size_t names{0};
+
+  /// @brief Descriptions and argument placeholders.
+  ///
+  std::size_t descriptions{0};
+
+  /// @brief Default arguments.
+  ///
+  std::size_t defaults{0};
+
+  /// @brief Conversion functions.
+  ///
+  std::size_t converters{0};
+
+  /// @brief Argument strings.
+  ///
+  std::size_t arguments{0};
+
+  /// @brief Cached values.
+  ///
+  std::size_t values{0};
+
+  /// @brief Nodes and bucket arrays of lookup tables, excluding the names they
+  ///  contain.
+  ///
+  std::size_t hash_tables{0};
+
+  /// @brief Everything else, e.g. arrays of parameter configurations.
+  ///
+  std::size_t other{0};
+
+  /// @brief Returns the sum of all categories.
+  ///
+  inline std::size_t Total() const {
+    return (names + descriptions + defaults + converters + arguments + values
+            + hash_tables + other);
+  }
+};
+/// @}
+
+// Size estimates used to compute `MemoryReport` objects.
+//
+namespace internal {
+
+// Heap bytes of `s`; short strings are stored inside the object.
+//
+inline std::size_t HeapSize(const std::string& s) {
+  const char* data{s.data()};
+  const char* object{reinterpret_cast<const char*>(&s)};
+  if (data >= object && data < object + sizeof(s)) {
+    return 0;
+  }
+  return s.capacity() + 1;
+}
+
+// Heap bytes of `v`'s array; not including memory owned by the elements.
+//
+template <class T>
+std::size_t HeapSize(const std::vector<T>& v) {
+  return v.capacity() * sizeof(T);
+}
+
+inline std::size_t HeapSize(const std::vector<std::string>& v) {
+  std::size_t result{v.capacity() * sizeof(std::string)};
+  for (const std::string& s : v) {
+    result += HeapSize(s);
+  }
+  return result;
+}
+
+// Heap bytes of an object of type `T` created by `std::make_shared`, which
+// stores it after its reference counts.
+//
+template <class T>
+constexpr std::size_t SharedHeapSize() {
+  constexpr std::size_t counts{sizeof(void*) + 2 * sizeof(int)};
+  return (counts + alignof(T) - 1) / alignof(T) * alignof(T) + sizeof(T);
+}
+
+// Heap bytes of an object of type `T` stored in a `std::any`.
+//
+template <class T>
+constexpr std::size_t AnyHeapSize() {
+  return (std::is_nothrow_move_constructible_v<T> && sizeof(T) <= sizeof(void*)
+          && alignof(T) <= alignof(void*)) ? 0 : sizeof(T);
+}
+
+// Heap bytes of a function object of type `Functor` stored in a
+// `std::function`.
+//
+template <class Functor>
+constexpr std::size_t FunctionHeapSize() {
+  return (std::is_trivially_copyable_v<Functor>
+          && sizeof(Functor) <= 2 * sizeof(void*)
+          && alignof(Functor) <= alignof(void*)) ? 0 : sizeof(Functor);
+}
+
+// Nodes of hash tables keyed by strings also store the keys' hash values.
+//
+template <class Value, bool kCachesHash>
+struct HashNode {
+  void* next;
+  Value value;
+  std::size_t hash;
+};
+
+template <class Value>
+struct HashNode<Value, false> {
+  void* next;
+  Value value;
+};
+
+template <class Value>
+struct TreeNode {
+  int color;
+  void* parent;
+  void* left;
+  void* right;
+  Value value;
+};
+
+// Heap bytes of `table`'s nodes and buckets; not including memory owned by
+// the elements.
+//
+template <class Key, class Value>
+std::size_t HeapSize(const std::unordered_map<Key, Value>& table) {
+  using Node = HashNode<std::pair<const Key, Value>, !std::is_integral_v<Key>>;
+  return (table.size() * sizeof(Node)
+          + (table.bucket_count() > 1
+                 ? table.bucket_count() * sizeof(void*) : 0));
+}
+
+template <class Key>
+std::size_t HeapSize(const std::unordered_set<Key>& table) {
+  using Node = HashNode<Key, !std::is_integral_v<Key>>;
+  return (table.size() * sizeof(Node)
+          + (table.bucket_count() > 1
+                 ? table.bucket_count() * sizeof(void*) : 0));
+}
+
+template <class Key, class Value>
+std::size_t HeapSize(const std::map<Key, Value>& tree) {
+  return tree.size() * sizeof(TreeNode<std::pair<const Key, Value>>);
+}
+
+} // namespace internal
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_MEMORY_REPORT_H_
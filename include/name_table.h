@@ -0,0 +1,239 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_NAME_TABLE_H_
+#define ARG_PARSE_CONVERT_NAME_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace arg_parse_convert {
+
+namespace internal {
+
+// Open-addressing hash table mapping parameter names to integer-identifiers.
+//
+// Slots are organized in groups of eight. Each slot has a control byte, which
+// is either `kEmpty` or the low seven bits of its name's hash. A lookup loads
+// the control bytes of a group as one 64 bit word and compares all of them
+// with the fingerprint of the name at once (SWAR), and only compares names of
+// slots whose fingerprints match. Names of up to `kInlineSize` characters are
+// stored inside the slot; longer names are referred to, so they must outlive
+// the table, e.g. by being interned in a `StringPool`. Names are never
+// removed, so there are no tombstones.
+//
+class NameTable {
+ public:
+  using size_type = std::size_t;
+
+  // Returned by `Find` for names not contained in the table.
+  //
+  static constexpr int kNotFound{-1};
+
+  // Returns the number of names in the table.
+  //
+  inline size_type size() const {return size_;}
+
+  // Returns the integer-identifier of `name`, or `kNotFound`.
+  //
+  inline int Find(std::string_view name) const {
+    if (size_ == 0) {
+      return kNotFound;
+    }
+    std::size_t hash{Hash(name)};
+    std::uint8_t fingerprint{Fingerprint(hash)};
+    size_type mask{NumGroups() - 1};
+    size_type group{GroupIndex(hash) & mask};
+    // Triangular probing visits every group once since the number of groups
+    // is a power of two, and at least one slot is always empty.
+    for (size_type step = 1; ; ++step) {
+      std::uint64_t control{LoadGroup(group)};
+      for (std::uint64_t match = MatchByte(control, fingerprint); match != 0;
+           match &= match - 1) {
+        const Slot& slot{slots_[group * kGroupSize + LowestByte(match)]};
+        if (slot.Equals(name)) {
+          return slot.id;
+        }
+      }
+      if (MatchEmpty(control) != 0) {
+        return kNotFound;
+      }
+      group = (group + step) & mask;
+    }
+  }
+
+  // Makes room for `num_names` names in total, so that inserting them does
+  // not throw. Strong guarantee.
+  //
+  void Reserve(size_type num_names);
+
+  // Inserts `name`, which must not be contained in the table, and which must
+  // outlive the table if longer than `kInlineSize`. Strong guarantee; does not
+  // throw if room was reserved.
+  //
+  void Insert(std::string_view name, int id);
+
+  // Heap bytes of the table.
+  //
+  inline std::size_t HeapSize() const {
+    return control_.capacity() + slots_.capacity() * sizeof(Slot);
+  }
+
+ private:
+  static constexpr size_type kGroupSize{8};
+  static constexpr size_type kInlineSize{16};
+  static constexpr std::uint8_t kEmpty{0x80};
+  static constexpr std::uint64_t kLowBits{0x0101010101010101};
+  static constexpr std::uint64_t kHighBits{0x8080808080808080};
+
+  // A name and its integer-identifier.
+  //
+  struct Slot {
+    std::int32_t id;
+    std::uint32_t size;
+    // The name's characters, or a pointer to them if longer than
+    // `kInlineSize`.
+    char chars[kInlineSize];
+
+    inline const char* data() const {
+      if (size <= kInlineSize) {
+        return chars;
+      }
+      const char* result;
+      std::memcpy(&result, chars, sizeof(result));
+      return result;
+    }
+
+    inline bool Equals(std::string_view name) const {
+      return (size == name.size()
+              && std::memcmp(data(), name.data(), size) == 0);
+    }
+  };
+
+  // Hashes eight characters at a time, which is cheaper than
+  // `std::hash<std::string_view>` for the short strings that names and most
+  // command-line arguments are.
+  //
+  static inline std::size_t Hash(std::string_view name) {
+    const char* chars{name.data()};
+    size_type num_chars{name.size()};
+    std::uint64_t result{Mix(num_chars)};
+    for (; num_chars >= 8; chars += 8, num_chars -= 8) {
+      std::uint64_t word;
+      std::memcpy(&word, chars, sizeof(word));
+      result = Mix(result ^ word);
+    }
+    if (num_chars > 0) {
+      std::uint64_t word{0};
+      for (size_type i = 0; i < num_chars; ++i) {
+        word |= std::uint64_t{static_cast<unsigned char>(chars[i])} << (8 * i);
+      }
+      result = Mix(result ^ word);
+    }
+    return static_cast<std::size_t>(result);
+  }
+
+  // Multiplies by the golden ratio and folds the high bits into the low ones.
+  //
+  static inline std::uint64_t Mix(std::uint64_t x) {
+    x *= 0x9e3779b97f4a7c15;
+    return x ^ (x >> 32);
+  }
+
+  static inline std::uint8_t Fingerprint(std::size_t hash) {
+    return static_cast<std::uint8_t>(hash & 0x7f);
+  }
+
+  static inline size_type GroupIndex(std::size_t hash) {return hash >> 7;}
+
+  // Bytes of `control` equal to `byte` have their high bit set; bytes above
+  // a matching byte may also be reported, which costs an extra comparison of
+  // names.
+  //
+  static inline std::uint64_t MatchByte(std::uint64_t control,
+                                        std::uint8_t byte) {
+    std::uint64_t x{control ^ (kLowBits * byte)};
+    return (x - kLowBits) & ~x & kHighBits;
+  }
+
+  // Empty slots of `control` have their high bit set.
+  //
+  static inline std::uint64_t MatchEmpty(std::uint64_t control) {
+    return control & kHighBits;
+  }
+
+  // Index of the lowest byte whose high bit is set in `match`, which must not
+  // be zero.
+  //
+  static inline size_type LowestByte(std::uint64_t match) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(match) / 8;
+#else
+    size_type result{0};
+    while ((match & 0x80) == 0) {
+      match >>= 8;
+      ++result;
+    }
+    return result;
+#endif
+  }
+
+  inline size_type NumGroups() const {return control_.size() / kGroupSize;}
+
+  // Control bytes of `group`, the first one in the lowest byte.
+  //
+  inline std::uint64_t LoadGroup(size_type group) const {
+    const std::uint8_t* bytes{&control_[group * kGroupSize]};
+    std::uint64_t result{0};
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(&result, bytes, sizeof(result));
+#else
+    for (size_type i = 0; i < kGroupSize; ++i) {
+      result |= std::uint64_t{bytes[i]} << (8 * i);
+    }
+#endif
+    return result;
+  }
+
+  // Stores `name` and `id` in an empty slot; there must be one.
+  //
+  void Place(std::string_view name, int id);
+
+  // Control bytes of all slots; empty if the table has no capacity.
+  //
+  std::vector<std::uint8_t> control_;
+
+  // Slots, at the same indices as their control bytes.
+  //
+  std::vector<Slot> slots_;
+
+  // Number of names in the table.
+  //
+  size_type size_{0};
+};
+
+} // namespace internal
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_NAME_TABLE_H_
@@ -21,12 +21,19 @@
 #ifndef ARG_PARSE_CONVERT_PARAMETER_H_
 #define ARG_PARSE_CONVERT_PARAMETER_H_
 
+#include <any>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "conversion_functions.h"
 #include "exceptions.h"
+#include "help_text.h"
 
 namespace arg_parse_convert {
 
@@ -36,7 +43,7 @@ namespace arg_parse_convert {
 
 /// @brief Enumeration of the different parameter categories.
 ///
-enum class ParameterCategory {
+enum class ParameterCategory : std::uint8_t {
   /// @brief Can be used for any type and its arguments are detected in a list
   ///  of arguments based on their position.
   ///
@@ -98,15 +105,22 @@ class ParameterConfiguration {
 
   /// @brief Returns parameter's names.
   ///
+  /// @details Copies of the object share the names, which are only replaced
+  ///  as a whole, so the strings stay at the same address while any copy
+  ///  refers to them.
+  ///
   /// @exceptions Strong guarantee.
   ///
-  inline const std::vector<std::string>& names() const {return names_;}
+  inline const std::vector<std::string>& names() const {
+    static const std::vector<std::string> kNoNames;
+    return (names_ != nullptr ? *names_ : kNoNames);
+  }
 
   /// @brief Returns the primary name.
   ///
   /// @exceptions Strong guarantee.
   ///
-  inline const std::string& PrimaryName() const {return names_.at(0);}
+  inline const std::string& PrimaryName() const {return names().at(0);}
 
   /// @brief Returns the category.
   ///
@@ -157,15 +171,47 @@ class ParameterConfiguration {
 
   /// @brief Returns the parameter descriptions.
   ///
+  /// @details Unless the description is an owned string, it is built on the
+  ///  first call, calling its provider if it has one, and kept until another
+  ///  description is set. Help-strings are generated from
+  ///  `description_text()` instead, which keeps nothing.
+  ///
+  /// @exceptions Strong guarantee. The provider may throw.
+  ///
+  inline const std::string& description() const {
+    return description_.cached_str();
+  }
+
+  /// @brief Returns the parameter description without building it.
+  ///
   /// @exceptions Strong guarantee.
   ///
-  inline const std::string& description() const {return description_;}
+  inline const HelpText& description_text() const {return description_;}
 
   /// @brief Returns the placeholder for the parameter argument in help strings.
   ///
+  /// @details Built on the first call like `description()`, unless it is an
+  ///  owned string or the primary name.
+  ///
+  /// @exceptions Strong guarantee. The provider may throw.
+  ///
+  inline const std::string& placeholder() const {
+    return (placeholder_is_name_ ? names().at(0)
+                                 : argument_placeholder_.cached_str());
+  }
+
+  /// @brief Returns the placeholder for the parameter argument without
+  ///  building it.
+  ///
+  /// @details The returned object views the primary name if that is the
+  ///  placeholder, so it must not outlive the object.
+  ///
   /// @exceptions Strong guarantee.
   ///
-  inline const std::string& placeholder() const {return argument_placeholder_;}
+  inline HelpText placeholder_text() const {
+    return (placeholder_is_name_ ? HelpText::Static(names().at(0))
+                                 : argument_placeholder_);
+  }
   /// @}
 
   /// @name Mutators:
@@ -190,7 +236,8 @@ class ParameterConfiguration {
             "All parameter names must be non-empty strings.");
       }
     }
-    names_ = std::move(names);
+    names_ = std::make_shared<const std::vector<std::string>>(
+        std::move(names));
   }
 
   /// @brief Sets parameter category.
@@ -281,6 +328,15 @@ class ParameterConfiguration {
   /// @exception Strong guarantee.
   ///
   inline void description(std::string description) {
+    description_ = HelpText{std::move(description)};
+  }
+
+  /// @brief Sets the description, e.g. to a view of static storage or to a
+  ///  provider.
+  ///
+  /// @exception No-throw guarantee.
+  ///
+  inline void description(HelpText description) noexcept {
     description_ = std::move(description);
   }
 
@@ -289,7 +345,17 @@ class ParameterConfiguration {
   /// @exception Strong guarantee.
   ///
   inline void placeholder(std::string placeholder) {
+    this->placeholder(HelpText{std::move(placeholder)});
+  }
+
+  /// @brief Sets the argument placeholder, e.g. to a view of static storage
+  ///  or to a provider.
+  ///
+  /// @exception No-throw guarantee.
+  ///
+  inline void placeholder(HelpText placeholder) noexcept {
     argument_placeholder_ = std::move(placeholder);
+    placeholder_is_name_ = false;
   }
   /// @}
 
@@ -299,15 +365,18 @@ class ParameterConfiguration {
   
   /// @brief Compares the object to `other`.
   ///
+  /// @details Descriptions and placeholders returned by functions are only
+  ///  equal if they share the function, which is not called.
+  ///
   inline bool operator==(const ParameterConfiguration& other) const {
-    return (names_ == other.names_
+    return (names() == other.names()
             && category_ == other.category_
             && default_arguments_ == other.default_arguments_
             && position_ == other.position_
             && min_num_arguments_ == other.min_num_arguments_
             && max_num_arguments_ == other.max_num_arguments_
             && description_ == other.description_
-            && argument_placeholder_ == other.argument_placeholder_);
+            && placeholder_text() == other.placeholder_text());
   }
   /// @}
 
@@ -332,9 +401,9 @@ class ParameterConfiguration {
   ///
   ParameterConfiguration() = default;
 
-  /// @brief Parameter's string-identifiers.
+  /// @brief Parameter's string-identifiers, shared by copies of the object.
   ///
-  std::vector<std::string> names_;
+  std::shared_ptr<const std::vector<std::string>> names_;
 
   /// @brief Parameter category determines how parameter is treated by various
   ///  functions.
@@ -361,11 +430,17 @@ class ParameterConfiguration {
 
   /// @brief Description included in the parameter's help-string.
   ///
-  std::string description_;
+  HelpText description_;
+
+  /// @brief Placeholder for parameter's argument in its help-string, unless
+  ///  `placeholder_is_name_` is set.
+  ///
+  HelpText argument_placeholder_{HelpText::Static("<ARG>")};
 
-  /// @brief Placeholder for parameter's argument in its help-string.
+  /// @brief Indicates whether the primary name is the placeholder, as for
+  ///  positional parameters, so that it is not copied.
   ///
-  std::string argument_placeholder_{"<ARG>"};
+  bool placeholder_is_name_{false};
 };
 
 /// @brief Bundles `ParameterConfiguration` object with conversion function and
@@ -376,6 +451,16 @@ class ParameterConfiguration {
 template <class ParameterType>
 class Parameter {
  public:
+  /// @brief Type of the conversion functions stored by the factories taking a
+  ///  conversion function as template argument.
+  ///
+  using StaticConverter = ParameterType (*)(const std::string&);
+
+  /// @brief Type of conversion functions bound at compile time whose result
+  ///  is wrapped in a `std::any`.
+  ///
+  using StaticValueConverter = std::any (*)(const std::string&);
+
   /// @name Factories:
   ///
   /// @{
@@ -397,6 +482,34 @@ class Parameter {
       std::function<ParameterType(const std::string&)> converter,
       std::vector<std::string> names);
 
+  /// @brief Creates a keyword parameter identified by `names`, with
+  ///  conversion function `kConverter` bound at compile time.
+  ///
+  /// @details Same as `Keyword(converter, names)`, except that `kConverter`
+  ///  is part of the types of the stored conversion functions, so it can be
+  ///  inlined into them and no memory is allocated to store it, and that
+  ///  values can be read with `ArgumentMap::GetValue<kConverter>`, which calls
+  ///  `kConverter` directly. Example:
+  ///  `Parameter<int>::Keyword<converters::FromChars<int>>({"count"})`.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Throws `exceptions::ParameterConfigurationError` if `names` is empty.
+  ///
+  template <auto kConverter>
+  static Parameter<ParameterType> Keyword(std::vector<std::string> names);
+
+  /// @brief Creates a keyword parameter identified by `names`, with a
+  ///  default-constructed `Converter` object as conversion function.
+  ///
+  /// @details Same as `Keyword<kConverter>(names)`, for function object
+  ///  types.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Throws `exceptions::ParameterConfigurationError` if `names` is empty.
+  ///
+  template <class Converter>
+  static Parameter<ParameterType> Keyword(std::vector<std::string> names);
+
   /// @brief Creates a positional parameter identified by `name`, with provided
   ///  relative position and conversion function.
   ///
@@ -406,6 +519,30 @@ class Parameter {
   static Parameter<ParameterType> Positional(
       std::function<ParameterType(const std::string&)> converter,
       std::string name, int position);
+
+  /// @brief Creates a positional parameter identified by `name`, with provided
+  ///  relative position and conversion function `kConverter` bound at compile
+  ///  time.
+  ///
+  /// @details See `Keyword<kConverter>(names)`.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Throws `exceptions::ParameterConfigurationError` if `name` is empty.
+  ///
+  template <auto kConverter>
+  static Parameter<ParameterType> Positional(std::string name, int position);
+
+  /// @brief Creates a positional parameter identified by `name`, with provided
+  ///  relative position and a default-constructed `Converter` object as
+  ///  conversion function.
+  ///
+  /// @details See `Keyword<Converter>(names)`.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Throws `exceptions::ParameterConfigurationError` if `name` is empty.
+  ///
+  template <class Converter>
+  static Parameter<ParameterType> Positional(std::string name, int position);
   /// @}
 
   /// @name Constructors:
@@ -454,6 +591,18 @@ class Parameter {
   converter() const {
     return converter_;
   }
+
+  /// @brief Returns the parameter's converter with its result wrapped in a
+  ///  `std::any`.
+  ///
+  /// @details Only set for parameters whose conversion function was bound at
+  ///  compile time; null otherwise.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  inline StaticValueConverter value_converter() const noexcept {
+    return value_converter_;
+  }
   /// @}
 
   /// @name Mutators:
@@ -518,6 +667,31 @@ class Parameter {
     return *this;
   }
 
+  /// @brief Sets the parameter's description to the result of `provider`,
+  ///  which is only called when the description is read, e.g. by
+  ///  `FormattedHelpString`.
+  ///
+  /// @exception Strong guarantee.
+  ///
+  inline Parameter<ParameterType>& Description(
+      std::function<std::string()> provider) {
+    configuration_.description(HelpText{std::move(provider)});
+    return *this;
+  }
+
+  /// @brief Sets the parameter's description to a view of `description`,
+  ///  which must outlive the parameter and its copies, e.g. a string literal.
+  ///
+  /// @details Neither the parameter nor its copies copy the description.
+  ///
+  /// @exception No-throw guarantee.
+  ///
+  inline Parameter<ParameterType>& StaticDescription(
+      std::string_view description) noexcept {
+    configuration_.description(HelpText::Static(description));
+    return *this;
+  }
+
   /// @brief Sets the argument's placeholder in the parameter's help string.
   ///
   /// @exception Strong guarantee.
@@ -526,6 +700,28 @@ class Parameter {
     configuration_.placeholder(std::move(placeholder));
     return *this;
   }
+
+  /// @brief Sets the argument's placeholder to the result of `provider`,
+  ///  which is only called when the placeholder is read.
+  ///
+  /// @exception Strong guarantee.
+  ///
+  inline Parameter<ParameterType>& Placeholder(
+      std::function<std::string()> provider) {
+    configuration_.placeholder(HelpText{std::move(provider)});
+    return *this;
+  }
+
+  /// @brief Sets the argument's placeholder to a view of `placeholder`,
+  ///  which must outlive the parameter and its copies, e.g. a string literal.
+  ///
+  /// @exception No-throw guarantee.
+  ///
+  inline Parameter<ParameterType>& StaticPlaceholder(
+      std::string_view placeholder) noexcept {
+    configuration_.placeholder(HelpText::Static(placeholder));
+    return *this;
+  }
   /// @}
 
   /// @name Other:
@@ -537,6 +733,19 @@ class Parameter {
   /// @exceptions Strong guarantee.
   ///
   std::string DebugString() const;
+
+  /// @brief Converts `argument` with a default-constructed `Converter`
+  ///  object.
+  ///
+  /// @details The factories taking `Converter`, or `kConverter` through
+  ///  `converters::StaticConverter`, store a pointer to this function as
+  ///  conversion function, by which `ArgumentMap::GetValue<kConverter>`
+  ///  recognizes their parameters.
+  ///
+  template <class Converter>
+  static ParameterType StaticConvert(const std::string& argument) {
+    return Converter{}(argument);
+  }
   /// @}
  private:
   // Used only in factories to ensure proper initialization.
@@ -553,6 +762,23 @@ class Parameter {
       std::function<ParameterType(const std::string&)> converter,
       std::vector<std::string> names);
 
+  /// @brief Returns a `Parameter` object with the given configuration and a
+  ///  default-constructed `Converter` object as conversion function.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Throws `exceptions::ParameterConfigurationError` if `names` is empty.
+  ///
+  template <class Converter>
+  static Parameter<ParameterType> CreateStatic(
+      ParameterConfiguration configuration, std::vector<std::string> names);
+
+  /// @brief Same as `StaticConvert`, with the result wrapped in a `std::any`.
+  ///
+  template <class Converter>
+  static std::any StaticValueConvert(const std::string& argument) {
+    return std::any{StaticConvert<Converter>(argument)};
+  }
+
   /// @brief Contains all information except conversion function.
   ///
   ParameterConfiguration configuration_;
@@ -560,6 +786,11 @@ class Parameter {
   /// @brief The parameter's conversion function.
   ///
   std::function<ParameterType(const std::string&)> converter_;
+
+  /// @brief The parameter's conversion function with its result wrapped in a
+  ///  `std::any`, if it was bound at compile time.
+  ///
+  StaticValueConverter value_converter_{nullptr};
 };
 /// @}
 
@@ -577,6 +808,25 @@ Parameter<ParameterType> Parameter<ParameterType>::Create(
   return parameter;
 }
 
+// Parameter::CreateStatic
+//
+template <class ParameterType>
+template <class Converter>
+Parameter<ParameterType> Parameter<ParameterType>::CreateStatic(
+    ParameterConfiguration configuration, std::vector<std::string> names) {
+  static_assert(
+      std::is_convertible_v<std::invoke_result_t<const Converter&,
+                                                 const std::string&>,
+                            ParameterType>,
+      "Conversion function must return a value convertible to the parameter"
+      " type.");
+  // A `std::function` holding a function pointer does not allocate.
+  Parameter<ParameterType> parameter{Create(
+      std::move(configuration), &StaticConvert<Converter>, std::move(names))};
+  parameter.value_converter_ = &StaticValueConvert<Converter>;
+  return parameter;
+}
+
 // Parameter::Flag
 //
 template <>
@@ -584,7 +834,7 @@ inline Parameter<bool> Parameter<bool>::Flag(std::vector<std::string> names) {
   Parameter<bool> result;
   ParameterConfiguration configuration;
   configuration.category_ = ParameterCategory::kFlag;
-  configuration.argument_placeholder_.clear();
+  configuration.argument_placeholder_ = HelpText{};
   result = Parameter<bool>::Create(std::move(configuration),
                                    converters::FlagConverter,
                                    std::move(names));
@@ -606,6 +856,26 @@ Parameter<ParameterType> Parameter<ParameterType>::Keyword(
   return result;
 }
 
+// Parameter::Keyword
+//
+template <class ParameterType>
+template <auto kConverter>
+Parameter<ParameterType> Parameter<ParameterType>::Keyword(
+    std::vector<std::string> names) {
+  return Keyword<converters::StaticConverter<kConverter>>(std::move(names));
+}
+
+// Parameter::Keyword
+//
+template <class ParameterType>
+template <class Converter>
+Parameter<ParameterType> Parameter<ParameterType>::Keyword(
+    std::vector<std::string> names) {
+  ParameterConfiguration configuration;
+  configuration.category_ = ParameterCategory::kKeywordParameter;
+  return CreateStatic<Converter>(std::move(configuration), std::move(names));
+}
+
 // Parameter::Positional
 //
 template <class ParameterType>
@@ -616,13 +886,37 @@ Parameter<ParameterType> Parameter<ParameterType>::Positional(
   ParameterConfiguration configuration;
   configuration.category_ = ParameterCategory::kPositionalParameter;
   configuration.position_ = position;
-  configuration.placeholder(name);
+  configuration.placeholder_is_name_ = true;
   result = Parameter<ParameterType>::Create(
       std::move(configuration), std::move(converter),
       std::vector<std::string>{std::move(name)});
   return result;
 }
 
+// Parameter::Positional
+//
+template <class ParameterType>
+template <auto kConverter>
+Parameter<ParameterType> Parameter<ParameterType>::Positional(
+    std::string name, int position) {
+  return Positional<converters::StaticConverter<kConverter>>(std::move(name),
+                                                             position);
+}
+
+// Parameter::Positional
+//
+template <class ParameterType>
+template <class Converter>
+Parameter<ParameterType> Parameter<ParameterType>::Positional(
+    std::string name, int position) {
+  ParameterConfiguration configuration;
+  configuration.category_ = ParameterCategory::kPositionalParameter;
+  configuration.position_ = position;
+  configuration.placeholder_is_name_ = true;
+  return CreateStatic<Converter>(std::move(configuration),
+                                 std::vector<std::string>{std::move(name)});
+}
+
 // Parameter::DebugString
 //
 template <class ParameterType>
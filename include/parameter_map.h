@@ -21,21 +21,175 @@
 #ifndef ARG_PARSE_CONVERT_PARAMETER_MAP_H_
 #define ARG_PARSE_CONVERT_PARAMETER_MAP_H_
 
+#include <algorithm>
 #include <any>
+#include <iterator>
 #include <map>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <utility>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "exceptions.h"
+#include "lazy_shared.h"
+#include "memory_report.h"
+#include "name_table.h"
 #include "parameter.h"
+#include "perf_counters.h"
+#include "prefix_trie.h"
+#include "string_pool.h"
+#include "suggestion_index.h"
 
 namespace arg_parse_convert {
 
+class ArgumentMap;
+
 /// @addtogroup ArgParseConvert-Reference
 ///
 /// @{
 
+/// @brief Flat representation of the fields of the parameters stored in a
+///  `ParameterMap` that are read while parsing.
+///
+/// @details Indexed by the parameters' integer-identifiers: the category,
+///  position and argument bounds are stored in a 16 byte record per
+///  parameter, four to a cache line, apart from the names, descriptions and
+///  default arguments of the `ParameterConfiguration` objects. Required
+///  parameters and flags are stored as bitsets, so membership tests are a
+///  bit test. Positional parameters are stored as a vector sorted by
+///  position. Maintained by the `ParameterMap` while parameters are
+///  inserted.
+///
+class ParameterLayout {
+ public:
+  using size_type = std::vector<ParameterCategory>::size_type;
+
+  /// @brief Returns the number of parameters.
+  ///
+  inline size_type size() const {return records_.size();}
+
+  /// @brief Returns the category of the parameter identified by `id`.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline ParameterCategory category(size_type id) const {
+    return records_[id].category;
+  }
+
+  /// @brief Returns the position of the parameter identified by `id`.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline int position(size_type id) const {return records_[id].position;}
+
+  /// @brief Returns the minimum number of arguments of the parameter
+  ///  identified by `id`.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline int min_num_arguments(size_type id) const {
+    return records_[id].min_num_arguments;
+  }
+
+  /// @brief Returns the maximum number of arguments of the parameter
+  ///  identified by `id`, or zero if the number is unbounded.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline int max_num_arguments(size_type id) const {
+    return records_[id].max_num_arguments;
+  }
+
+  /// @brief Indicates whether the parameter identified by `id` has default
+  ///  arguments.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline bool HasDefaults(size_type id) const {
+    return records_[id].has_defaults;
+  }
+
+  /// @brief Indicates whether the parameter identified by `id` cannot take
+  ///  more than `num_arguments` arguments.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline bool IsFull(size_type id, int num_arguments) const {
+    return (records_[id].max_num_arguments > 0
+            && num_arguments >= records_[id].max_num_arguments);
+  }
+
+  /// @brief Indicates whether the parameter identified by `id` is required.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline bool IsRequired(size_type id) const {return TestBit(required_, id);}
+
+  /// @brief Indicates whether the parameter identified by `id` is a flag.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline bool IsFlag(size_type id) const {return TestBit(flags_, id);}
+
+  /// @brief Indicates whether the parameter identified by `id` is a keyword
+  ///  parameter.
+  ///
+  /// @details `id` must identify a parameter.
+  ///
+  inline bool IsKeyword(size_type id) const {
+    return records_[id].category == ParameterCategory::kKeywordParameter;
+  }
+
+  /// @brief Returns pairs of position and integer-identifier of the
+  ///  positional parameters, ordered by position.
+  ///
+  inline const std::vector<std::pair<int, int>>& positional_parameters()
+      const {
+    return positional_parameters_;
+  }
+
+ private:
+  friend class ParameterMap;
+
+  /// @brief The fields of a parameter read while parsing.
+  ///
+  struct Record {
+    std::int32_t position;
+    std::int32_t min_num_arguments;
+    std::int32_t max_num_arguments;
+    ParameterCategory category;
+    bool has_defaults;
+  };
+
+  static_assert(sizeof(Record) == 16);
+
+  static constexpr size_type kBitsPerWord{64};
+
+  static inline bool TestBit(const std::vector<std::uint64_t>& bits,
+                             size_type id) {
+    return (bits[id / kBitsPerWord] >> (id % kBitsPerWord)) & 1;
+  }
+
+  /// @brief Reserves space for `num_parameters` parameters, of which
+  ///  `num_positional` are positional parameters.
+  ///
+  void Reserve(size_type num_parameters, size_type num_positional);
+
+  /// @brief Appends the parameter configured by `configuration`.
+  ///
+  /// @details Does not throw if space was reserved before.
+  ///
+  void Add(const ParameterConfiguration& configuration);
+
+  std::vector<Record> records_;
+  std::vector<std::uint64_t> required_;
+  std::vector<std::uint64_t> flags_;
+  std::vector<std::pair<int, int>> positional_parameters_;
+};
+
 /// @brief A `ParameterMap` stores the configurations of parameters.
 ///
 /// @details The different parameters stored in a `ParameterMap` are identified
@@ -56,16 +210,44 @@ class ParameterMap {
 
  public:
   using size_type = std::vector<ParameterConfiguration>::size_type;
+
+  /// @brief Returned by `FindId` and `MatchAbbreviation` if no parameter
+  ///  matches.
+  ///
+  static constexpr int kNoMatch{-1};
+
+  /// @brief Returned by `MatchAbbreviation` if names of several parameters
+  ///  start with the abbreviation.
+  ///
+  static constexpr int kAmbiguousMatch{-2};
+
   /// @name Constructors:
   ///
   /// @{
 
   /// @brief Default constructor.
   ///
+  /// @details The object creates its own `StringPool` when the first
+  ///  subcommand is inserted.
+  ///
   ParameterMap() = default;
 
+  /// @brief Constructs an empty object whose subcommand names are interned
+  ///  in `strings`.
+  ///
+  /// @details Objects sharing a pool store each distinct subcommand name
+  ///  once. Parameter names are not interned; the lookup tables refer to the
+  ///  names held by the parameters' configurations.
+  ///
+  explicit ParameterMap(std::shared_ptr<StringPool> strings)
+      : strings_{std::move(strings)} {}
+
   /// @brief Copy constructor.
   ///
+  /// @details The copy shares `other`'s `StringPool` and the names of its
+  ///  parameters, so no names are copied. The parameters' default arguments
+  ///  are copied.
+  ///
   ParameterMap(const ParameterMap& other) = default;
 
   /// @brief Move constructor.
@@ -103,7 +285,8 @@ class ParameterMap {
   /// @exceptions Strong guarantee.
   ///
   inline bool Contains(const std::string& name) const {
-    return (name_to_id_.count(name) > 0);
+    internal::CountEvent(PerfCounter::kLookups);
+    return (name_to_id_.Find(name) != internal::NameTable::kNotFound);
   }
 
   /// @brief Indicates whether object contains a flag identified by `name`.
@@ -111,7 +294,9 @@ class ParameterMap {
   /// @exceptions Strong guarantee.
   ///
   inline bool IsFlag(const std::string& name) const {
-    return (Contains(name) && flags_.count(GetId(name)) > 0);
+    internal::CountEvent(PerfCounter::kLookups);
+    int id{name_to_id_.Find(name)};
+    return (id != internal::NameTable::kNotFound && layout_.IsFlag(id));
   }
 
   /// @brief Indicates whether object contains a keyword parameter identified by
@@ -120,7 +305,9 @@ class ParameterMap {
   /// @exceptions Strong guarantee.
   ///
   inline bool IsKeyword(const std::string& name) const {
-    return (Contains(name) && keyword_parameters_.count(GetId(name)) > 0);
+    internal::CountEvent(PerfCounter::kLookups);
+    int id{name_to_id_.Find(name)};
+    return (id != internal::NameTable::kNotFound && layout_.IsKeyword(id));
   }
 
   /// @brief Returns integer-identifier for parameter with string-identifier
@@ -130,15 +317,89 @@ class ParameterMap {
   ///  object contains no parameter identified by `name`.
   ///
   inline int GetId(const std::string& name) const {
-    std::stringstream error_message;
-    try {
-      return name_to_id_.at(name);
-    } catch (const std::out_of_range& e) {
+    internal::CountEvent(PerfCounter::kLookups);
+    int id{name_to_id_.Find(name)};
+    if (id == internal::NameTable::kNotFound) {
+      std::stringstream error_message;
       error_message << "Unable to find parameter named: '" << name << "'.";
       throw exceptions::ParameterAccessError(error_message.str());
     }
+    return id;
+  }
+
+  /// @brief Returns integer-identifier for parameter with string-identifier
+  ///  `name`, or `kNoMatch`.
+  ///
+  /// @details Unlike `GetId`, takes a view, e.g. of part of a command-line
+  ///  argument, and does not throw for unknown names.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  inline int FindId(std::string_view name) const noexcept {
+    internal::CountEvent(PerfCounter::kLookups);
+    return name_to_id_.Find(name);
+  }
+
+  /// @brief Indicates whether `MatchAbbreviation` resolves prefixes of names.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline bool AllowsAbbreviations() const {return allow_abbreviations_;}
+
+  /// @brief Returns integer-identifier for parameter with string-identifier
+  ///  `name`, or else the keyword parameter or flag whose names are the only
+  ///  ones starting with `name`.
+  ///
+  /// @details Prefixes are only resolved after `AllowAbbreviations` was
+  ///  called; otherwise only exact names match. Names of positional
+  ///  parameters only match exactly, since they are not given on the command
+  ///  line. Takes time proportional to the length of `name`. Returns
+  ///  `kNoMatch` if no name starts with `name`, and `kAmbiguousMatch` if
+  ///  names of several parameters do.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  inline int MatchAbbreviation(std::string_view name) const noexcept {
+    int id{FindId(name)};
+    if (id != kNoMatch || !allow_abbreviations_) {
+      return id;
+    }
+    internal::CountEvent(PerfCounter::kLookups);
+    return abbreviations_.Match(name);
   }
 
+  /// @brief Returns the names of keyword parameters and flags starting with
+  ///  `prefix` in lexicographic order.
+  ///
+  /// @details Empty unless `AllowAbbreviations` was called. Meant for error
+  ///  messages about ambiguous abbreviations.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline std::vector<std::string> NamesStartingWith(std::string_view prefix)
+      const {
+    return abbreviations_.Names(prefix);
+  }
+
+  /// @brief Returns at most `max_suggestions` names of keyword parameters and
+  ///  flags closest to `name`, which matches no parameter, nearest first.
+  ///
+  /// @details Suggests all names within edit distance one of `name`, counting
+  ///  transpositions of adjacent characters as one edit. If `name` is longer
+  ///  than four characters, names within distance two are also suggested if
+  ///  `name` lacks at most one of their characters, e.g. `verbsoe` or
+  ///  `verbosee` for `verbose`, but not `vrbse`. Meant for error messages about
+  ///  misspelled names: the index used is built on the first call after
+  ///  parameters were inserted, which takes time linear in the total length
+  ///  of all names, and each later call takes a few microseconds regardless
+  ///  of the number of parameters. Safe to call concurrently on a const
+  ///  object.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  std::vector<std::string> Suggest(std::string_view name,
+                                   size_type max_suggestions = 3) const;
+
   /// @brief Returns primary string-identifier for parameter with
   ///  integer-identifier `id`.
   ///
@@ -149,13 +410,12 @@ class ParameterMap {
   ///  object contains no parameter identified by `id`.
   ///
   inline const std::string& GetPrimaryName(int id) const {
-    std::stringstream error_message;
-    try {
-      return parameter_configurations_.at(id).names().at(0);
-    } catch (const std::out_of_range& e) {
+    if (id < 0 || id >= static_cast<int>(parameter_configurations_.size())) {
+      std::stringstream error_message;
       error_message << "Unable to find parameter with id: '" << id << "'.";
       throw exceptions::ParameterAccessError(error_message.str());
     }
+    return parameter_configurations_[id].names().at(0);
   }
 
   /// @brief Returns `ParameterConfiguration` object associated with the
@@ -166,13 +426,7 @@ class ParameterMap {
   ///
   inline const ParameterConfiguration& GetConfiguration(
       const std::string& name) const {
-    std::stringstream error_message;
-    try {
-      return parameter_configurations_.at(GetId(name));
-    } catch (const std::out_of_range& e) {
-      error_message << "Unable to find parameter with name: '" << name << "'.";
-      throw exceptions::ParameterAccessError(error_message.str());
-    }
+    return parameter_configurations_[GetId(name)];
   }
 
   /// @brief Returns `ParameterConfiguration` object associated with the
@@ -182,13 +436,12 @@ class ParameterMap {
   ///  object contains no parameter identified by `id`.
   ///
   inline const ParameterConfiguration& GetConfiguration(size_type id) const {
-    std::stringstream error_message;
-    try {
-      return parameter_configurations_.at(id);
-    } catch (const std::out_of_range& e) {
+    if (id >= parameter_configurations_.size()) {
+      std::stringstream error_message;
       error_message << "Unable to find parameter with id: '" << id << "'.";
       throw exceptions::ParameterAccessError(error_message.str());
     }
+    return parameter_configurations_[id];
   }
 
   /// @brief Returns conversion function associated with the parameter
@@ -199,41 +452,141 @@ class ParameterMap {
   ///  * `ParameterType` is not the type of the parameter identified by `name`.
   ///
   template <class ParameterType>
-  std::function<ParameterType(const std::string&)>
+  const std::function<ParameterType(const std::string&)>&
   ConversionFunction(const std::string& name) const;
-  
+
+  /// @brief Returns conversion function associated with the parameter
+  ///  identified by `id`.
+  ///
+  /// @exceptions Strong guarantee. Throws `exceptions::ParameterAccessError` if
+  ///  * object contains no parameter identified by `id`.
+  ///  * `ParameterType` is not the type of the parameter identified by `id`.
+  ///
+  template <class ParameterType>
+  const std::function<ParameterType(const std::string&)>&
+  ConversionFunction(size_type id) const;
+
+  /// @brief Returns a type-erased conversion function for the parameter
+  ///  identified by `id`.
+  ///
+  /// @details The returned function evaluates the parameter's conversion
+  ///  function and wraps the result in a `std::any`. It is empty if the
+  ///  parameter has no conversion function, or is a flag.
+  ///
+  /// @exceptions Strong guarantee. Throws `exceptions::ParameterAccessError` if
+  ///  object contains no parameter identified by `id`.
+  ///
+  inline const std::function<std::any(const std::string&)>&
+  ValueConversionFunction(size_type id) const {
+    if (id >= value_converters_.size()) {
+      std::stringstream error_message;
+      error_message << "Unable to find parameter with id: '" << id << "'.";
+      throw exceptions::ParameterAccessError(error_message.str());
+    }
+    return value_converters_[id];
+  }
+
   /// @brief Returns integer-identifiers for the contained required parameters.
   ///
+  /// @details Built from `layout()` on the first call after parameters were
+  ///  inserted, which invalidates the returned reference. `layout()` gives the
+  ///  same information without building anything.
+  ///
   /// @exceptions Strong guarantee.
   ///
   inline const std::unordered_set<int>& required_parameters() const {
-    return required_parameters_;
+    return CategorySets().required_parameters;
   }
 
   /// @brief Returns integer-identifiers for the contained positional parameters
   ///  ordered by their associated position.
   ///
+  /// @details Same as `required_parameters()`.
+  ///
   /// @exceptions Strong guarantee.
   ///
   inline const std::map<int, int>& positional_parameters() const {
-    return positional_parameters_;
+    return CategorySets().positional_parameters;
   }
 
   /// @brief Returns integer-identifiers for the contained keyword parameters.
   ///
+  /// @details Same as `required_parameters()`.
+  ///
   /// @exceptions Strong guarantee.
   ///
   inline const std::unordered_set<int>& keyword_parameters() const {
-    return keyword_parameters_;
+    return CategorySets().keyword_parameters;
   }
 
   /// @brief Returns integer-identifiers of the contained flags.
   ///
+  /// @details Same as `required_parameters()`.
+  ///
   /// @exceptions Strong guarantee.
   ///
   inline const std::unordered_set<int>& flags() const {
-    return flags_;
+    return CategorySets().flags;
+  }
+
+  /// @brief Returns the flat representation of the parameters' categories.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline const ParameterLayout& layout() const {return layout_;}
+
+  /// @brief Returns the pool holding the subcommand names, or null if no
+  ///  subcommand was inserted yet.
+  ///
+  /// @details Views of equal names returned by the same pool have equal data
+  ///  pointers.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline const std::shared_ptr<StringPool>& strings() const {
+    return strings_;
   }
+
+  /// @brief Returns the number of registered subcommands.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline size_type num_subcommands() const {return subcommands_.size();}
+
+  /// @brief Returns integer-identifier of the subcommand named `name`, or
+  ///  `kNoMatch`.
+  ///
+  /// @details Subcommands are numbered in order of registration, separately
+  ///  from parameters.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  inline int FindSubcommand(std::string_view name) const noexcept {
+    if (subcommands_.empty()) {
+      return kNoMatch;
+    }
+    internal::CountEvent(PerfCounter::kLookups);
+    return subcommand_ids_.Find(name);
+  }
+
+  /// @brief Returns the name of the subcommand identified by `id`.
+  ///
+  /// @exceptions Strong guarantee. Throws `exceptions::ParameterAccessError` if
+  ///  object contains no subcommand identified by `id`.
+  ///
+  std::string_view SubcommandName(int id) const;
+
+  /// @brief Returns the parameters of the subcommand identified by `id`.
+  ///
+  /// @details The parameters are created by the subcommand's factory on the
+  ///  first call, and shared by later calls and by copies of the object. Safe
+  ///  to call concurrently on a const object; concurrent first calls may each
+  ///  run the factory, and all but one result are discarded.
+  ///
+  /// @exceptions Strong guarantee. Throws `exceptions::ParameterAccessError` if
+  ///  object contains no subcommand identified by `id`. The factory may throw.
+  ///
+  std::shared_ptr<const ParameterMap> SubcommandParameters(int id) const;
   /// @}
 
   /// @name Mutators:
@@ -256,6 +609,71 @@ class ParameterMap {
   ///
   template<class ParameterType>
   ParameterMap& operator()(Parameter<ParameterType> parameter);
+
+  /// @brief Inserts the parameters in the range [`first`, `last`) into the
+  ///  object, in order.
+  ///
+  /// @details All parameters are validated before any is inserted, and each
+  ///  container of the object grows at most once. `Iterator` must refer to
+  ///  `Parameter` objects; they are copied unless `first` and `last` are move
+  ///  iterators.
+  ///
+  /// @exceptions Strong guarantee if validation fails, basic guarantee
+  ///  otherwise.
+  ///  * Throws `exceptions::ParameterRegistrationError` in the cases listed
+  ///    for `operator()`, and when two parameters in the range share a name
+  ///    or a position.
+  ///  * Constructors of the parameters' conversion functions may throw.
+  ///
+  template <class Iterator>
+  ParameterMap& Register(Iterator first, Iterator last);
+
+  /// @brief Inserts the parameters of `parameters` into the object, in order.
+  ///
+  /// @details Same as `Register(std::begin(parameters),
+  ///  std::end(parameters))`.
+  ///
+  template <class Range>
+  ParameterMap& Register(Range&& parameters) {
+    return Register(std::begin(parameters), std::end(parameters));
+  }
+
+  /// @brief Reserves space for `num_parameters` parameters with
+  ///  `num_names` names in total.
+  ///
+  /// @details Avoids repeated reallocation and rehashing when the number of
+  ///  parameters to be registered is known in advance.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  void Reserve(size_type num_parameters, size_type num_names);
+
+  /// @brief Lets `ParseArgs` accept unique prefixes of long names, e.g.
+  ///  `--verb` for `--verbose`.
+  ///
+  /// @details Indexes the names of all parameters, including ones inserted
+  ///  later, in a radix trie used by `MatchAbbreviation`. A prefix is unique
+  ///  if all names starting with it belong to the same parameter; exact names
+  ///  always take precedence.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  void AllowAbbreviations();
+
+  /// @brief Registers subcommand `name`, whose parameters are returned by
+  ///  `factory`, which takes no arguments and returns a `ParameterMap`.
+  ///
+  /// @details `factory` is only called by `SubcommandParameters`, e.g. when
+  ///  `ParseArgs` reaches the subcommand's name, so that tools with many
+  ///  subcommands only build the parameters of the one used. Returns a
+  ///  reference to the object.
+  ///
+  /// @exceptions Strong guarantee. Throws
+  ///  `exceptions::ParameterRegistrationError` if `name` is empty, starts with
+  ///  '-', or is the name of another subcommand.
+  ///
+  template <class Factory>
+  ParameterMap& AddSubcommand(const std::string& name, Factory factory);
   /// @}
 
   /// @name Other:
@@ -267,17 +685,116 @@ class ParameterMap {
   /// @exceptions Strong guarantee.
   ///
   std::string DebugString() const;
+
+  /// @brief Returns the heap memory used by the object.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  MemoryReport MemoryUsage() const;
   /// @}
 
  private:
-  
+  friend class ArgumentMap;
+
+  /// @brief Heap memory used by a parameter's conversion functions and by
+  ///  each of its values.
+  ///
+  struct HeapFootprint {
+    std::size_t converters{0};
+    std::size_t value{0};
+  };
+
+  /// @brief A subcommand's name, the factory creating its parameters and the
+  ///  parameters, once created.
+  ///
+  struct Subcommand {
+    std::string_view name;
+    std::function<ParameterMap()> factory;
+    std::size_t factory_heap_size{0};
+    internal::LazyShared<ParameterMap> parameters;
+  };
+
+  /// @brief Adds subcommand `name` with `factory`, whose function object
+  ///  uses `factory_heap_size` bytes of heap memory, as `AddSubcommand` does.
+  ///
+  void InsertSubcommand(const std::string& name,
+                        std::function<ParameterMap()> factory,
+                        std::size_t factory_heap_size);
+
+  /// @brief Throws `exceptions::ParameterRegistrationError` if a parameter
+  ///  configured by `configuration` cannot be inserted into the object.
+  ///
+  void CheckRegistration(const ParameterConfiguration& configuration) const;
+
+  /// @brief Makes room for `num_parameters` more parameters with `num_names`
+  ///  names, of which `num_positional` are positional parameters.
+  ///
+  /// @details Grows containers geometrically, so that inserting parameters
+  ///  one at a time takes amortized constant time.
+  ///
+  void ReserveAdditional(size_type num_parameters, size_type num_names,
+                         size_type num_positional);
+
+  /// @brief Integer-identifiers of parameters by category, in the containers
+  ///  returned by the accessors of the same names.
+  ///
+  struct Categories {
+    std::unordered_set<int> required_parameters;
+    std::map<int, int> positional_parameters;
+    std::unordered_set<int> keyword_parameters;
+    std::unordered_set<int> flags;
+  };
+
+  /// @brief Returns the categories of the parameters, built from `layout_` on
+  ///  the first call after parameters were inserted.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  const Categories& CategorySets() const;
+
+  /// @brief Inserts `parameter`, which must have passed `CheckRegistration`,
+  ///  after room was made for it with `ReserveAdditional`.
+  ///
+  template <class ParameterType>
+  void Insert(Parameter<ParameterType> parameter);
+
   /// @brief Map of string-identifiers to integer-identifiers of parameters
   ///  stored in the object.
   ///
   /// @details Each parameter is identified in the other data members of the
-  ///  object by its integer-identifier.
+  ///  object by its integer-identifier. Names too long to be stored inline
+  ///  are views of the names in `parameter_configurations_`, which copies of
+  ///  the object share.
   ///
-  std::unordered_map<std::string, int> name_to_id_;
+  internal::NameTable name_to_id_;
+
+  /// @brief Pool in which the keys of `subcommand_ids_` are interned.
+  ///
+  std::shared_ptr<StringPool> strings_;
+
+  /// @brief Indicates whether `abbreviations_` indexes all names of keyword
+  ///  parameters and flags.
+  ///
+  bool allow_abbreviations_{false};
+
+  /// @brief Trie of all names of keyword parameters and flags, views of the
+  ///  names in `parameter_configurations_`, if `allow_abbreviations_` is set.
+  ///
+  internal::PrefixTrie abbreviations_;
+
+  /// @brief Index of all names used by `Suggest`, built on first use and
+  ///  discarded when parameters are inserted.
+  ///
+  internal::LazySuggestionIndex suggestions_;
+
+  /// @brief Registered subcommands, by integer-identifier.
+  ///
+  std::vector<Subcommand> subcommands_;
+
+  /// @brief Map of subcommand names, views of strings in `strings_`, to
+  ///  their integer-identifiers.
+  ///
+  internal::NameTable subcommand_ids_;
 
   /// @brief Configurations of parameters stored in the object.
   ///
@@ -293,140 +810,191 @@ class ParameterMap {
   ///
   std::vector<std::any> converters_;
 
-  /// @brief Contains integer-identifiers of required parameters.
+  /// @brief Type-erased conversion functions of parameters stored in the
+  ///  object.
+  ///
+  /// @details Parameters' integer identifiers are the positions of the
+  ///  associated `ParameterConfiguration` objects. Used where the parameter's
+  ///  type is not known, such as `ArgumentMap::ConvertAll`.
   ///
-  std::unordered_set<int> required_parameters_;
+  std::vector<std::function<std::any(const std::string&)>> value_converters_;
 
-  /// @brief Orders integer-identifiers of positional parameters by position.
+  /// @brief Heap memory used by conversion functions and values of parameters
+  ///  stored in the object.
   ///
-  std::map<int, int> positional_parameters_;
+  /// @details Parameters' integer identifiers are the positions of the
+  ///  associated `ParameterConfiguration` objects.
+  ///
+  std::vector<HeapFootprint> heap_footprints_;
 
-  /// @brief Contains integer-identifiers of keyword parameters.
+  /// @brief Flat representation of the parameters' categories.
   ///
-  std::unordered_set<int> keyword_parameters_;
+  ParameterLayout layout_;
 
-  /// @brief Contains integer-identifiers of flags.
+  /// @brief Categories returned by `CategorySets`, built on first use and
+  ///  discarded when parameters are inserted.
   ///
-  std::unordered_set<int> flags_;
+  internal::LazyShared<Categories> category_sets_;
 };
 /// @}
 
 // ParameterMap::ConversionFunction()
 //
 template <class ParameterType>
-std::function<ParameterType(const std::string&)>
+const std::function<ParameterType(const std::string&)>&
 ParameterMap::ConversionFunction(const std::string& name) const {
-  std::stringstream error_message;
-  try {
-    // Note placement of * and & here to obtain const reference.
-    return std::any_cast<std::function<ParameterType(const std::string&)>>(
-        converters_.at(GetId(name)));
-  } catch (const std::out_of_range& e) {
-    error_message << "Expected the name of a parameter contained in the"
-                  << " object. No parameter with name: '" << name << "' was"
-                  << " found.";
+  return ConversionFunction<ParameterType>(
+      static_cast<size_type>(GetId(name)));
+}
+
+// ParameterMap::ConversionFunction()
+//
+template <class ParameterType>
+const std::function<ParameterType(const std::string&)>&
+ParameterMap::ConversionFunction(size_type id) const {
+  if (id >= converters_.size()) {
+    std::stringstream error_message;
+    error_message << "Expected the id of a parameter contained in the object."
+                  << " No parameter with id: '" << id << "' was found.";
     throw exceptions::ParameterAccessError(error_message.str());
-  } catch (const std::bad_any_cast& e) {
+  }
+  // Pointer form of `std::any_cast` avoids copying the function.
+  const auto* converter{
+      std::any_cast<std::function<ParameterType(const std::string&)>>(
+          &converters_[id])};
+  if (converter == nullptr) {
+    std::stringstream error_message;
     error_message << "Expected the argument to match the original `Parameter`"
                   << " object's template argument. Function was called with:"
                   << " '" << typeid(ParameterType).name() << "', but original"
                   << " `Parameter` object has conversion function type"
-                  << converters_.at(GetId(name)).type().name() << "'.";
+                  << converters_[id].type().name() << "'.";
     throw exceptions::ParameterAccessError(error_message.str());
   }
+  return *converter;
 }
 
 // ParameterMap::operator()
 //
 template<class ParameterType>
 ParameterMap& ParameterMap::operator()(Parameter<ParameterType> parameter) {
-  int id{static_cast<int>(parameter_configurations_.size())};
-  std::vector<std::string> names{parameter.configuration().names()};
-  std::any converter{
-      std::make_any<std::function<ParameterType(const std::string&)>>(
-          std::move(parameter.converter()))};
-  ParameterCategory parameter_category{parameter.configuration().category()};
-  int parameter_position{parameter.configuration().position()};
-  std::stringstream error_message;
-  int other_id;
+  const ParameterConfiguration& configuration{parameter.configuration()};
+  CheckRegistration(configuration);
+  ReserveAdditional(
+      1, configuration.names().size(),
+      configuration.category() == ParameterCategory::kPositionalParameter
+      ? 1 : 0);
+  Insert(std::move(parameter));
+  return *this;
+}
+
+// ParameterMap::AddSubcommand
+//
+template <class Factory>
+ParameterMap& ParameterMap::AddSubcommand(const std::string& name,
+                                          Factory factory) {
+  InsertSubcommand(name, std::function<ParameterMap()>{std::move(factory)},
+                   internal::FunctionHeapSize<Factory>());
+  return *this;
+}
 
-  // Preconditions.
-  if (names.empty()) {
-    error_message << "Parameter must be given at least one name.";
+// ParameterMap::Register
+//
+template <class Iterator>
+ParameterMap& ParameterMap::Register(Iterator first, Iterator last) {
+  size_type num_parameters{0}, num_names{0};
+  std::vector<std::string_view> names;
+  std::vector<int> positions;
+
+  // Validate all parameters before inserting any.
+  for (Iterator it = first; it != last; ++it) {
+    const ParameterConfiguration& configuration{(*it).configuration()};
+    CheckRegistration(configuration);
+    names.insert(names.end(), configuration.names().begin(),
+                 configuration.names().end());
+    if (configuration.category() == ParameterCategory::kPositionalParameter) {
+      positions.push_back(configuration.position());
+    }
+    ++num_parameters;
+    num_names += configuration.names().size();
+  }
+  // Sorting finds names and positions shared within the range without
+  // allocating per element.
+  std::sort(names.begin(), names.end());
+  auto name_it = std::adjacent_find(names.begin(), names.end());
+  if (name_it != names.end()) {
+    std::stringstream error_message;
+    error_message << "Name '" << *name_it << "' already taken by another"
+                  << " parameter.";
     throw exceptions::ParameterRegistrationError(error_message.str());
   }
-  for (const std::string& name : names) {
-    if (name_to_id_.count(name)) {
-      error_message << "Name '" << name << "' already taken by another"
-                    << " parameter.";
-      throw exceptions::ParameterRegistrationError(error_message.str());
-    }
+  std::sort(positions.begin(), positions.end());
+  auto position_it = std::adjacent_find(positions.begin(), positions.end());
+  if (position_it != positions.end()) {
+    std::stringstream error_message;
+    error_message << "Position '" << *position_it << "' already taken by"
+                  << " another parameter.";
+    throw exceptions::ParameterRegistrationError(error_message.str());
   }
-  if (parameter_category == ParameterCategory::kPositionalParameter
-      && positional_parameters_.count(parameter_position)) {
 
-    other_id = positional_parameters_.at(parameter_position);
-    error_message << "Position '" << parameter_position << "' for parameter"
-                  << " named '" << names.at(0)
-                  << "' already taken by parameter named: '"
-                  << parameter_configurations_.at(other_id).names().at(0)
-                  << "'.";
-    throw exceptions::ParameterRegistrationError(error_message.str());
+  ReserveAdditional(num_parameters, num_names, positions.size());
+  for (; first != last; ++first) {
+    Insert(*first);
   }
+  return *this;
+}
 
-  // Reserve space to trigger exceptions before modifying
+// ParameterMap::Insert
+//
+template <class ParameterType>
+void ParameterMap::Insert(Parameter<ParameterType> parameter) {
+  int id{static_cast<int>(parameter_configurations_.size())};
+  std::any converter{
+      std::make_any<std::function<ParameterType(const std::string&)>>(
+          parameter.converter())};
+  ParameterCategory parameter_category{parameter.configuration().category()};
+  std::function<std::any(const std::string&)> value_converter{
+      parameter.value_converter()};
+  HeapFootprint heap_footprint{
+      internal::AnyHeapSize<std::function<ParameterType(const std::string&)>>(),
+      internal::AnyHeapSize<ParameterType>()};
+  if (value_converter == nullptr && parameter.converter() != nullptr
+      && parameter_category != ParameterCategory::kFlag) {
+    value_converter = [converter = parameter.converter()](
+        const std::string& argument) {
+      return std::any{converter(argument)};
+    };
+    // The function object captures a copy of `converter`.
+    heap_footprint.converters += internal::FunctionHeapSize<
+        std::function<ParameterType(const std::string&)>>();
+  }
+
+  // Space was reserved, so appending elements does not throw.
   // Move constructor of std::function isn't 'noexcept' until C++20, swap is.
   converters_.emplace_back();
-  name_to_id_.reserve(name_to_id_.size() + names.size());
-  parameter_configurations_.reserve(parameter_configurations_.size() + 1);
-  converters_.reserve(converters_.size() + 1);
-  if (parameter.configuration().IsRequired()) {
-    required_parameters_.reserve(required_parameters_.size() + 1);
-  }
-  switch (parameter_category) {
-    case ParameterCategory::kKeywordParameter: {
-      keyword_parameters_.reserve(keyword_parameters_.size() + 1);
-      break;
-    }
-    case ParameterCategory::kFlag: {
-      flags_.reserve(flags_.size() + 1);
-      break;
-    }
-    default: {
-      // Positional parameters are inserted into std::map; no reserve needed.
-    }
-  }
+  value_converters_.emplace_back();
+  heap_footprints_.emplace_back();
 
   // Insert names.
-  for (std::string& name : names) {
-    name_to_id_.emplace(std::move(name), id);
+  suggestions_.Reset();
+  // The names are shared with `parameter_configurations_`'s new element, so
+  // they stay where they are.
+  for (const std::string& name : parameter.configuration().names()) {
+    name_to_id_.Insert(name, id);
+    if (allow_abbreviations_
+        && parameter_category != ParameterCategory::kPositionalParameter) {
+      abbreviations_.Insert(name, id);
+    }
   }
   // Insert converter.
   converters_.back().swap(converter);
+  value_converters_.back().swap(value_converter);
+  heap_footprints_.back() = heap_footprint;
   // Insert into appropriate categories.
-  if (parameter.configuration().IsRequired()) {
-    required_parameters_.emplace(id);
-  }
-  switch (parameter_category) {
-    case ParameterCategory::kPositionalParameter: {
-      positional_parameters_.emplace(parameter_position, id);
-      break;
-    }
-    case ParameterCategory::kKeywordParameter: {
-      keyword_parameters_.emplace(id);
-      break;
-    }
-    case ParameterCategory::kFlag: {
-      flags_.emplace(id);
-      break;
-    }
-    default: {
-      // Already handled above.
-    }
-  }
+  category_sets_.Reset();
+  layout_.Add(parameter.configuration());
   // Insert configuration object.
   parameter_configurations_.emplace_back(std::move(parameter.configuration()));
-  return *this;
 }
 
 } // namespace arg_parse_convert
@@ -0,0 +1,163 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_PARSE_OBSERVER_H_
+#define ARG_PARSE_CONVERT_PARSE_OBSERVER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace arg_parse_convert {
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Phases of parsing arguments and obtaining their values.
+///
+enum class ParsePhase {
+  kTokenize = 0, ///< Splitting input into names and arguments.
+  kLookup,       ///< Looking up parameters by name.
+  kAssign,       ///< Assigning the arguments to their parameters.
+  kConvert       ///< Converting arguments to values.
+};
+
+/// @brief Number of `ParsePhase` values.
+///
+inline constexpr std::size_t kNumParsePhases{4};
+
+/// @brief Returns the name of `phase`.
+///
+const char* ParsePhaseName(ParsePhase phase);
+
+/// @brief Work done during one occurrence of a phase.
+///
+struct PhaseStatistics {
+  /// @brief Number of tokens, i.e. command-line arguments, configuration file
+  ///  lines, or converted arguments.
+  ///
+  std::size_t tokens{0};
+
+  /// @brief Number of parameter name lookups.
+  ///
+  std::size_t lookups{0};
+
+  /// @brief Number of input characters scanned or converted.
+  ///
+  std::size_t bytes{0};
+
+  /// @brief Time spent in the phase.
+  ///
+  std::chrono::nanoseconds elapsed{0};
+};
+
+/// @brief Receives statistics at phase boundaries of `ParseArgs`, `ParseFile`,
+///  and of value conversions by `ArgumentMap`.
+///
+/// @details Attached to an `ArgumentMap` with `ArgumentMap::SetParseObserver`.
+///  Without an observer, no time is measured and no calls are made.
+///
+///  `ParseArgs` and `ParseFile` report `kTokenize`, `kLookup` and `kAssign`
+///  once per successful call. Each conversion of an argument to a value by
+///  `GetValue`, `GetAllValues`, or `GetAllValuesInto` reports `kConvert`;
+///  `ConvertAll` reports `kConvert` once per task. Since value accessors and
+///  `ConvertAll` may run on multiple threads, `OnPhase` must be thread-safe
+///  when they do.
+///
+class ParseObserver {
+ public:
+  virtual ~ParseObserver() = default;
+
+  /// @brief Called when `phase` ended.
+  ///
+  /// @details Must not throw; it may be called from tasks of `ConvertAll`.
+  ///
+  virtual void OnPhase(ParsePhase phase,
+                       const PhaseStatistics& statistics) noexcept = 0;
+};
+
+/// @brief Aggregated statistics of a phase.
+///
+/// @details `buckets[i]` counts occurrences of the phase which took at least
+///  `2^(i-1)` and less than `2^i` nanoseconds; `buckets[0]` counts those which
+///  took less than one nanosecond.
+///
+struct PhaseHistogram {
+  static constexpr std::size_t kNumBuckets{64};
+
+  std::uint64_t count{0};
+  std::uint64_t tokens{0};
+  std::uint64_t lookups{0};
+  std::uint64_t bytes{0};
+  std::chrono::nanoseconds elapsed{0};
+  std::array<std::uint64_t, kNumBuckets> buckets{};
+};
+
+/// @brief Observer which aggregates statistics of each phase into a
+///  `PhaseHistogram`.
+///
+/// @details `OnPhase` is thread-safe and lock-free.
+///
+class HistogramParseObserver final : public ParseObserver {
+ public:
+  void OnPhase(ParsePhase phase,
+               const PhaseStatistics& statistics) noexcept override;
+
+  /// @brief Returns the statistics of `phase` aggregated so far.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  PhaseHistogram Histogram(ParsePhase phase) const;
+
+  /// @brief Discards all statistics.
+  ///
+  /// @exceptions No-throw guarantee.
+  ///
+  void Reset();
+
+  /// @brief Returns the histograms of all phases as a JSON object, keyed by
+  ///  phase name. Empty buckets beyond the last non-empty one are omitted.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  std::string ToJson() const;
+
+ private:
+  struct AtomicHistogram {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> tokens{0};
+    std::atomic<std::uint64_t> lookups{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::int64_t> elapsed{0};
+    std::array<std::atomic<std::uint64_t>, PhaseHistogram::kNumBuckets>
+        buckets{};
+  };
+
+  std::array<AtomicHistogram, kNumParsePhases> histograms_;
+};
+/// @}
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_PARSE_OBSERVER_H_
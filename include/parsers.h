@@ -52,19 +52,33 @@ namespace arg_parse_convert {
 ///  the next positional parameter is assigned to next. The two-letter argument
 ///  `--` marks a separation point in the argument list, after which all
 ///  arguments are read as positional parameter arguments independent of their
-///  prefix.
+///  prefix. If `ParameterMap::AllowAbbreviations` was called, names following
+///  `--` may be abbreviated by any prefix that only names of one parameter
+///  start with.
+///
+/// If the `ParameterMap` member has subcommands, the first argument without
+///  prefix that is not assigned to an open keyword parameter and is the name
+///  of a subcommand ends the arguments for the `ParameterMap` member. The
+///  subcommand's parameters are then created, and the remaining arguments are
+///  parsed for them into `arguments.SubcommandArguments()`, which may in turn
+///  have subcommands.
 ///
 /// If a parameter was assigned one or more arguments prior to execution of this
 ///  function, the arguments that would be assigned to it by this function are
 ///  added to the return value instead.
 ///
-/// @return A list of arguments which could not be assigned to any parameters.
+/// @return A list of arguments which could not be assigned to any parameters,
+///  including parameters of a subcommand.
 ///
 /// @exceptions Basic guarantee. Throws `exceptions::ArgumentParsingError` when:
 ///  * Option list contains a character that is not the name of a flag, or the
 ///    the name of a keyword parameter in the case of the last letter.
 ///  * When a parameter begins with 2 hyphens, but the suffix after the 2 hypens
 ///    is not the name of a registered keyword parameter or flag.
+///  * When abbreviations are allowed and the suffix after the 2 hyphens is a
+///    prefix of names of more than one parameter.
+///  * When an earlier call for `arguments` reached a different subcommand.
+///  The factory creating a subcommand's parameters may throw.
 ///    
 std::vector<std::string> ParseArgs(int argc, const char** argv,
                                    ArgumentMap& arguments);
@@ -0,0 +1,168 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_PERF_COUNTERS_H_
+#define ARG_PARSE_CONVERT_PERF_COUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace arg_parse_convert {
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Indicates whether performance counters are compiled in.
+///
+/// @details Counters are enabled by defining
+///  `ARG_PARSE_CONVERT_PERF_COUNTERS`, e.g. with the cmake option of the same
+///  name. Otherwise counting compiles to nothing and all snapshots are zero.
+///
+#ifdef ARG_PARSE_CONVERT_PERF_COUNTERS
+inline constexpr bool kPerfCountersEnabled{true};
+#else
+inline constexpr bool kPerfCountersEnabled{false};
+#endif
+
+/// @brief Events counted by the performance counters.
+///
+enum class PerfCounter {
+  kLookups = 0,        ///< Parameter lookups by name in `ParameterMap`.
+  kCacheHits,          ///< Values of `ArgumentMap` found already computed.
+  kCacheMisses,        ///< Values of `ArgumentMap` not computed yet.
+  kConversions,        ///< Calls of conversion functions.
+  kConversionFailures, ///< Calls of conversion functions that threw.
+  kExceptions          ///< Exceptions of type `exceptions::BaseError` created.
+};
+
+/// @brief Number of `PerfCounter` values.
+///
+inline constexpr std::size_t kNumPerfCounters{6};
+
+/// @brief Returns the name of `counter`.
+///
+inline const char* PerfCounterName(PerfCounter counter) {
+  switch (counter) {
+    case PerfCounter::kLookups: return "lookups";
+    case PerfCounter::kCacheHits: return "cache_hits";
+    case PerfCounter::kCacheMisses: return "cache_misses";
+    case PerfCounter::kConversions: return "conversions";
+    case PerfCounter::kConversionFailures: return "conversion_failures";
+    case PerfCounter::kExceptions: return "exceptions";
+  }
+  return "unknown";
+}
+
+/// @brief Values of all performance counters at some point in time.
+///
+/// @details Counters are process-wide and only increase, so the events
+///  counted during some work are the difference of snapshots taken before and
+///  after it.
+///
+struct PerfCounterSnapshot {
+  std::array<std::uint64_t, kNumPerfCounters> counts{};
+
+  /// @brief Returns the value of `counter`.
+  ///
+  inline std::uint64_t operator[](PerfCounter counter) const {
+    return counts[static_cast<std::size_t>(counter)];
+  }
+
+  /// @brief Returns the number of events counted since `earlier`.
+  ///
+  inline PerfCounterSnapshot operator-(
+      const PerfCounterSnapshot& earlier) const {
+    PerfCounterSnapshot result;
+    for (std::size_t i = 0; i < kNumPerfCounters; ++i) {
+      result.counts[i] = counts[i] - earlier.counts[i];
+    }
+    return result;
+  }
+};
+
+namespace internal {
+
+#ifdef ARG_PARSE_CONVERT_PERF_COUNTERS
+/// @brief Number of shards the counters are split into.
+///
+inline constexpr std::size_t kNumPerfCounterShards{16};
+
+/// @brief Counters updated by a subset of the threads, on their own cache
+///  line.
+///
+struct alignas(64) PerfCounterShard {
+  std::array<std::atomic<std::uint64_t>, kNumPerfCounters> counts{};
+};
+
+inline std::array<PerfCounterShard, kNumPerfCounterShards>
+    perf_counter_shards{};
+inline std::atomic<std::size_t> next_perf_counter_shard{0};
+
+/// @brief Returns the shard of the calling thread, assigning shards to
+///  threads round-robin.
+///
+inline PerfCounterShard& ThreadPerfCounterShard() {
+  thread_local PerfCounterShard& shard{perf_counter_shards[
+      next_perf_counter_shard.fetch_add(1, std::memory_order_relaxed)
+      % kNumPerfCounterShards]};
+  return shard;
+}
+#endif
+
+/// @brief Adds `count` to `counter` if counters are enabled.
+///
+inline void CountEvent(PerfCounter counter, std::uint64_t count = 1) {
+#ifdef ARG_PARSE_CONVERT_PERF_COUNTERS
+  ThreadPerfCounterShard().counts[static_cast<std::size_t>(counter)]
+      .fetch_add(count, std::memory_order_relaxed);
+#else
+  static_cast<void>(counter);
+  static_cast<void>(count);
+#endif
+}
+
+} // namespace internal
+
+/// @brief Returns the current values of the performance counters, summed over
+///  all threads.
+///
+/// @details Counts of other threads may be observed partially while they
+///  run. Returns zeros if counters are disabled.
+///
+inline PerfCounterSnapshot SnapshotPerfCounters() {
+  PerfCounterSnapshot result;
+#ifdef ARG_PARSE_CONVERT_PERF_COUNTERS
+  for (const internal::PerfCounterShard& shard
+       : internal::perf_counter_shards) {
+    for (std::size_t i = 0; i < kNumPerfCounters; ++i) {
+      result.counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+    }
+  }
+#endif
+  return result;
+}
+/// @}
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_PERF_COUNTERS_H_
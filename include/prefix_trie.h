@@ -0,0 +1,124 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_PREFIX_TRIE_H_
+#define ARG_PARSE_CONVERT_PREFIX_TRIE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arg_parse_convert {
+
+namespace internal {
+
+// Radix trie over parameter names for resolving unique prefixes.
+//
+// Each edge is labelled with a view of a substring of an inserted name, so
+// names must outlive the trie, e.g. by being interned in a `StringPool`. Nodes
+// are stored in a single vector and link to their first child and next
+// sibling, with siblings ordered by the first character of their labels.
+// Every node records the integer-identifier shared by all names below it, so
+// a prefix is resolved in time proportional to its length, independent of the
+// number of names.
+//
+class PrefixTrie {
+ public:
+  using size_type = std::size_t;
+
+  // Returned by `Match` for prefixes of no name.
+  //
+  static constexpr int kNotFound{-1};
+
+  // Returned by `Match` for prefixes of names of different parameters.
+  //
+  static constexpr int kAmbiguous{-2};
+
+  // Returns the number of names in the trie.
+  //
+  inline size_type size() const {return num_names_;}
+
+  // Returns the integer-identifier of `prefix` if it is a name, otherwise of
+  // the parameter all names starting with `prefix` belong to, or `kNotFound`
+  // or `kAmbiguous`.
+  //
+  int Match(std::string_view prefix) const;
+
+  // Returns the names starting with `prefix` in lexicographic order.
+  //
+  std::vector<std::string> Names(std::string_view prefix) const;
+
+  // Makes room for `num_names` more names, so that inserting them does not
+  // throw. Strong guarantee.
+  //
+  void Reserve(size_type num_names);
+
+  // Inserts `name`, which must outlive the trie, for the parameter identified
+  // by `id`. Strong guarantee; does not throw if room was reserved.
+  //
+  void Insert(std::string_view name, int id);
+
+  // Heap bytes of the trie.
+  //
+  inline std::size_t HeapSize() const {
+    return nodes_.capacity() * sizeof(Node);
+  }
+
+ private:
+  static constexpr std::int32_t kNoNode{-1};
+
+  struct Node {
+    // Characters on the edge from the parent; empty for the root.
+    std::string_view label;
+    std::int32_t first_child{kNoNode};
+    std::int32_t next_sibling{kNoNode};
+    // Parameter of the name ending at this node, or `kNotFound`.
+    std::int32_t exact_id{kNotFound};
+    // Parameter of all names ending at or below this node, `kNotFound` or
+    // `kAmbiguous`.
+    std::int32_t subtree_id{kNotFound};
+  };
+
+  // Returns the child of `node` whose label starts with `c`, or `kNoNode`.
+  //
+  std::int32_t FindChild(std::int32_t node, char c) const;
+
+  // Appends the names ending at or below `node` to `names`, each prefixed by
+  // `prefix`.
+  //
+  void CollectNames(std::int32_t node, std::string& prefix,
+                    std::vector<std::string>& names) const;
+
+  // Nodes of the trie; the root is the first one, if any.
+  //
+  std::vector<Node> nodes_;
+
+  // Number of names in the trie.
+  //
+  size_type num_names_{0};
+};
+
+} // namespace internal
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_PREFIX_TRIE_H_
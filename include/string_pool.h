@@ -0,0 +1,110 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_STRING_POOL_H_
+#define ARG_PARSE_CONVERT_STRING_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace arg_parse_convert {
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Append-only pool of interned strings.
+///
+/// @details `Intern` returns a `std::string_view` of a copy of its argument
+///  owned by the pool. The copy is stored in a large block shared with other
+///  strings, is never moved, and lives as long as the pool. Equal strings are
+///  stored once, so two views returned by the same pool are equal exactly
+///  when their data pointers are.
+///
+///  A pool may be shared by several `ParameterMap` objects, e.g. by copies of
+///  one schema or by similar schemas, and may be used by several threads.
+///
+class StringPool {
+ public:
+  using size_type = std::unordered_set<std::string_view>::size_type;
+
+  /// @brief Default constructor.
+  ///
+  StringPool() = default;
+
+  StringPool(const StringPool& other) = delete;
+  StringPool& operator=(const StringPool& other) = delete;
+
+  /// @brief Returns a view of the pool's copy of `s`, copying `s` into the
+  ///  pool if it contains no equal string.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  std::string_view Intern(std::string_view s);
+
+  /// @brief Returns the number of distinct strings in the pool.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  size_type size() const;
+
+  /// @brief Returns the heap memory used by the pool in bytes.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  std::size_t HeapSize() const;
+
+ private:
+  /// @brief Size of the blocks strings are copied into; longer strings get a
+  ///  block of their own.
+  ///
+  static constexpr std::size_t kBlockSize{4096};
+
+  /// @brief Guards all other data members.
+  ///
+  mutable std::mutex mutex_;
+
+  /// @brief Blocks holding the strings' characters.
+  ///
+  std::vector<std::unique_ptr<char[]>> blocks_;
+
+  /// @brief Unused characters at the end of the most recent block of size
+  ///  `kBlockSize`.
+  ///
+  char* free_begin_{nullptr};
+  char* free_end_{nullptr};
+
+  /// @brief Total size of `blocks_`' elements.
+  ///
+  std::size_t block_bytes_{0};
+
+  /// @brief Views of the interned strings.
+  ///
+  std::unordered_set<std::string_view> index_;
+};
+/// @}
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_STRING_POOL_H_
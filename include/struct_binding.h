@@ -0,0 +1,244 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_STRUCT_BINDING_H_
+#define ARG_PARSE_CONVERT_STRUCT_BINDING_H_
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argument_map.h"
+#include "exceptions.h"
+#include "parameter.h"
+#include "parameter_map.h"
+
+namespace arg_parse_convert {
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Registers parameters with a `ParameterMap` and binds each of them to
+///  a data member of `Options`.
+///
+/// @details After arguments were parsed, `Bind` fills an `Options` object with
+///  all bound parameters' values in a single pass, so that application code
+///  reads plain data members instead of calling `ArgumentMap::GetValue`.
+///
+///  Parameters are bound according to the type of the data member:
+///   - A flag bound to a `bool` member is set to whether the flag was given.
+///   - Another parameter bound to a `ParameterType` member is set to the
+///     parameter's first value, if it has an argument.
+///   - A parameter bound to a `std::vector<ParameterType>` member is set to
+///     all of the parameter's values.
+///
+///  Members of parameters without arguments keep their previous values.
+///
+/// @invariant The number of bound members is the number of parameters the
+///  object registered.
+///
+template <class Options>
+class StructBinding {
+ public:
+  using size_type = ParameterMap::size_type;
+
+  /// @name Constructors:
+  ///
+  /// @{
+
+  /// @brief Constructs object which registers parameters with `parameters`.
+  ///
+  /// @details `parameters` must outlive all calls to `operator()`; it is not
+  ///  accessed by `Bind`.
+  ///
+  explicit StructBinding(ParameterMap& parameters) : parameters_{&parameters} {}
+  /// @}
+
+  /// @name Accessors:
+  ///
+  /// @{
+
+  /// @brief Returns the number of bound members.
+  ///
+  /// @exceptions Strong guarantee.
+  ///
+  inline size_type size() const {return members_.size();}
+
+  /// @brief Returns an `Options` object whose bound members are set from the
+  ///  arguments in `arguments`.
+  ///
+  /// @details Members are assigned to `options`, which provides the values of
+  ///  members whose parameters have no arguments, and of all unbound members.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  * Throws `exceptions::ParameterAccessError` if `arguments` was not
+  ///    constructed from the `ParameterMap` the parameters were registered
+  ///    with.
+  ///  * Exceptions thrown by `ArgumentMap::GetValue` and
+  ///    `ArgumentMap::GetAllValuesInto`, including those of conversion
+  ///    functions.
+  ///
+  Options Bind(const ArgumentMap& arguments, Options options = Options{}) const;
+  /// @}
+
+  /// @name Mutators:
+  ///
+  /// @{
+
+  /// @brief Registers `parameter` and binds it to data member `member`.
+  ///
+  /// @details Returns a reference to the object.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Exceptions thrown by `ParameterMap::operator()`.
+  ///
+  template <class ParameterType>
+  StructBinding& operator()(ParameterType Options::* member,
+                            Parameter<ParameterType> parameter);
+
+  /// @brief Registers `parameter` and binds all of its values to data member
+  ///  `member`.
+  ///
+  /// @details Returns a reference to the object.
+  ///
+  /// @exceptions Strong guarantee.
+  ///  Exceptions thrown by `ParameterMap::operator()`.
+  ///
+  template <class ParameterType>
+  StructBinding& operator()(std::vector<ParameterType> Options::* member,
+                            Parameter<ParameterType> parameter);
+  /// @}
+
+ private:
+  /// @brief Assigns the values of a parameter to a data member.
+  ///
+  using Assigner = std::function<void(const ArgumentMap&, size_type,
+                                      Options&)>;
+
+  /// @brief Data member bound to a parameter.
+  ///
+  struct Member {
+    size_type id;
+    std::string name;
+    Assigner assign;
+  };
+
+  /// @brief Registers `parameter` and appends the member assigned by
+  ///  `assign`.
+  ///
+  template <class ParameterType>
+  void Register(Parameter<ParameterType>&& parameter, Assigner&& assign);
+
+  /// @brief `ParameterMap` object parameters are registered with.
+  ///
+  ParameterMap* parameters_;
+
+  /// @brief Bound data members in the order of registration.
+  ///
+  std::vector<Member> members_;
+};
+/// @}
+
+// StructBinding::Bind
+//
+template <class Options>
+Options StructBinding<Options>::Bind(const ArgumentMap& arguments,
+                                     Options options) const {
+  const ParameterMap& parameters{arguments.Parameters()};
+  for (const Member& member : members_) {
+    if (member.id >= parameters.size()
+        || parameters.GetPrimaryName(member.id) != member.name) {
+      std::stringstream error_message;
+      error_message << "Parameter named '" << member.name << "' was not"
+                    << " registered with the parameters of the `ArgumentMap`.";
+      throw exceptions::ParameterAccessError(error_message.str());
+    }
+  }
+  for (const Member& member : members_) {
+    member.assign(arguments, member.id, options);
+  }
+  return options;
+}
+
+// StructBinding::operator()
+//
+template <class Options>
+template <class ParameterType>
+StructBinding<Options>& StructBinding<Options>::operator()(
+    ParameterType Options::* member, Parameter<ParameterType> parameter) {
+  if (parameter.configuration().category() == ParameterCategory::kFlag) {
+    Register(std::move(parameter), [member](const ArgumentMap& arguments,
+                                            size_type id, Options& options) {
+      options.*member = !arguments.Arguments()[id].empty();
+    });
+  } else {
+    Register(std::move(parameter), [member](const ArgumentMap& arguments,
+                                            size_type id, Options& options) {
+      if (!arguments.Arguments()[id].empty()) {
+        options.*member = arguments.GetValue<ParameterType>(id);
+      }
+    });
+  }
+  return *this;
+}
+
+template <class Options>
+template <class ParameterType>
+StructBinding<Options>& StructBinding<Options>::operator()(
+    std::vector<ParameterType> Options::* member,
+    Parameter<ParameterType> parameter) {
+  Register(std::move(parameter), [member](const ArgumentMap& arguments,
+                                          size_type id, Options& options) {
+    if (!arguments.Arguments()[id].empty()) {
+      std::vector<ParameterType> values;
+      arguments.GetAllValuesInto(id, values);
+      options.*member = std::move(values);
+    }
+  });
+  return *this;
+}
+
+// StructBinding::Register
+//
+template <class Options>
+template <class ParameterType>
+void StructBinding<Options>::Register(Parameter<ParameterType>&& parameter,
+                                      Assigner&& assign) {
+  Member bound_member{parameters_->size(),
+                      parameter.configuration().names().empty()
+                          ? std::string{}
+                          : parameter.configuration().names().front(),
+                      std::move(assign)};
+  // The member is added first, letting the vector grow geometrically, and
+  // removed again if the parameter cannot be inserted.
+  members_.push_back(std::move(bound_member));
+  try {
+    (*parameters_)(std::move(parameter));
+  } catch (...) {
+    members_.pop_back();
+    throw;
+  }
+}
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_STRUCT_BINDING_H_
@@ -0,0 +1,121 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_SUGGESTION_INDEX_H_
+#define ARG_PARSE_CONVERT_SUGGESTION_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lazy_shared.h"
+
+namespace arg_parse_convert {
+
+namespace internal {
+
+// Returns the optimal string alignment distance of `a` and `b`, i.e. the
+// number of insertions, deletions, substitutions and transpositions of
+// adjacent characters needed to turn one into the other, or `limit + 1` if it
+// exceeds `limit`.
+//
+std::size_t EditDistance(std::string_view a, std::string_view b,
+                         std::size_t limit);
+
+// Symmetric deletion index over parameter names for finding the names
+// nearest to a misspelled one.
+//
+// The index maps hashes of each name and of each string obtained by deleting
+// one of its characters to the name. A query looks up the hashes of the input
+// and of the strings obtained by deleting up to `max_distance` of its
+// characters, and verifies the candidates found with `EditDistance`. This
+// finds all names within distance one, and names within distance two that
+// become equal to the input after deleting at most one of their characters
+// and at most two of the input's, which covers transposed, substituted and
+// extra characters. A query takes time independent of the number of names.
+// Names are views that must outlive the index, e.g. by being interned in a
+// `StringPool`.
+//
+class SuggestionIndex {
+ public:
+  using size_type = std::size_t;
+
+  // Builds the index over `names`, which must outlive it.
+  //
+  explicit SuggestionIndex(std::vector<std::string_view> names);
+
+  // Returns the number of names in the index.
+  //
+  inline size_type size() const {return names_.size();}
+
+  // Returns at most `max_suggestions` names within edit distance
+  // `max_distance` of `name`, nearest first, and in lexicographic order among
+  // equally near ones. `max_distance` must not exceed two.
+  //
+  std::vector<std::string> Nearest(std::string_view name,
+                                   size_type max_suggestions,
+                                   size_type max_distance) const;
+
+  // Heap bytes of the index.
+  //
+  inline std::size_t HeapSize() const {
+    return (names_.capacity() * sizeof(std::string_view)
+            + entries_.capacity() * sizeof(Entry));
+  }
+
+ private:
+  // Hash of a name or deletion variant, and the index of the name in
+  // `names_`. Hashes are never zero, which marks empty entries. Hash
+  // collisions only add candidates, which are verified.
+  //
+  struct Entry {
+    std::uint32_t hash{0};
+    std::uint32_t name{0};
+  };
+
+  // Inserts `entry` into `entries_` by linear probing.
+  //
+  void Add(Entry entry);
+
+  // Appends the indices of names in `names_` whose entries have `hash`.
+  //
+  void Find(std::uint32_t hash, std::vector<std::uint32_t>& names) const;
+
+  // Indexed names.
+  //
+  std::vector<std::string_view> names_;
+
+  // Open-addressing hash table of entries, at most three quarters full; its
+  // size is a power of two.
+  //
+  std::vector<Entry> entries_;
+};
+
+// Holds a `SuggestionIndex` built on first use by a const object.
+//
+using LazySuggestionIndex = LazyShared<SuggestionIndex>;
+
+} // namespace internal
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_SUGGESTION_INDEX_H_
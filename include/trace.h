@@ -0,0 +1,158 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_TRACE_H_
+#define ARG_PARSE_CONVERT_TRACE_H_
+
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exceptions.h"
+#include "parameter_map.h"
+
+namespace arg_parse_convert {
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Kind of input stored in a `TraceRecord`.
+///
+enum class TraceRecordKind : std::uint8_t {
+  kSchema = 0,    ///< Serialized `ParameterMap`; see `SerializeSchema`.
+  kArguments = 1, ///< Arguments passed to `ParseArgs`, including `argv[0]`.
+  kFile = 2       ///< Lines read by `ParseFile`.
+};
+
+/// @brief One captured input.
+///
+struct TraceRecord {
+  TraceRecordKind kind{TraceRecordKind::kArguments};
+  std::vector<std::string> tokens;
+};
+
+/// @brief Writes a compact binary trace of parser inputs to a stream.
+///
+/// @details Attached to an `ArgumentMap` with `ArgumentMap::SetTraceWriter`,
+///  it captures the inputs of `ParseArgs` and `ParseFile`, including inputs
+///  which fail to parse. The trace begins with the bytes `APCT` and a version
+///  byte; each record consists of its kind byte, the number of tokens, and
+///  each token's length followed by its characters, with all numbers encoded
+///  as base-128 varints.
+///
+///  Writing is thread-safe.
+///
+class TraceWriter {
+ public:
+  /// @brief Constructs object writing to `os`, which must outlive it, and
+  ///  writes the trace header.
+  ///
+  explicit TraceWriter(std::ostream& os);
+
+  /// @brief Appends a record.
+  ///
+  /// @exceptions Basic guarantee. Exceptions thrown by the stream.
+  ///
+  void Write(TraceRecordKind kind, const std::vector<std::string>& tokens);
+
+  /// @brief Appends a record of the arguments passed to `ParseArgs`.
+  ///
+  /// @exceptions Basic guarantee. Exceptions thrown by the stream.
+  ///
+  void WriteArguments(int argc, const char** argv);
+
+  /// @brief Appends a record of `SerializeSchema(parameters)`.
+  ///
+  /// @exceptions Basic guarantee. Exceptions thrown by the stream, and those
+  ///  thrown by `SerializeSchema`.
+  ///
+  void WriteSchema(const ParameterMap& parameters);
+
+ private:
+  void WriteVarint(std::uint64_t value);
+
+  void WriteToken(std::string_view token);
+
+  std::ostream& os_;
+  std::mutex mutex_;
+};
+
+/// @brief Reads records written by a `TraceWriter` from a stream.
+///
+class TraceReader {
+ public:
+  /// @brief Constructs object reading from `is`, which must outlive it, and
+  ///  reads the trace header.
+  ///
+  /// @exceptions Throws `exceptions::TraceFormatError` if `is` does not begin
+  ///  with a trace header of a supported version.
+  ///
+  explicit TraceReader(std::istream& is);
+
+  /// @brief Reads the next record into `record`. Returns false at the end of
+  ///  the trace.
+  ///
+  /// @details Memory is only allocated for bytes actually read, so corrupt
+  ///  token counts and lengths cannot cause large allocations.
+  ///
+  /// @exceptions Basic guarantee. Throws `exceptions::TraceFormatError` if the
+  ///  record is truncated or malformed.
+  ///
+  bool Next(TraceRecord& record);
+
+ private:
+  bool ReadVarint(std::uint64_t& value);
+
+  std::istream& is_;
+};
+
+/// @brief Returns the configurations of all parameters in `parameters` as
+///  tokens of a `TraceRecordKind::kSchema` record.
+///
+/// @details Conversion functions cannot be serialized, and descriptions and
+///  placeholders returned by functions are serialized as empty, without
+///  calling the functions.
+///
+/// @exceptions Strong guarantee. Throws `exceptions::TraceFormatError` if
+///  `parameters` has subcommands, which traces cannot represent.
+///
+std::vector<std::string> SerializeSchema(const ParameterMap& parameters);
+
+/// @brief Returns a `ParameterMap` with the configurations serialized in
+///  `tokens`.
+///
+/// @details Flags are registered as `Parameter<bool>`, all other parameters
+///  as `Parameter<std::string>` with `converters::StringIdentity`, in the
+///  order of their integer-identifiers.
+///
+/// @exceptions Strong guarantee. Throws `exceptions::TraceFormatError` if
+///  `tokens` are malformed.
+///
+ParameterMap DeserializeSchema(const std::vector<std::string>& tokens);
+/// @}
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_TRACE_H_
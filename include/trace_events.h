@@ -0,0 +1,183 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_TRACE_EVENTS_H_
+#define ARG_PARSE_CONVERT_TRACE_EVENTS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace arg_parse_convert {
+
+class ParameterMap;
+
+/// @addtogroup ArgParseConvert-Reference
+///
+/// @{
+
+/// @brief Indicates whether trace events are compiled in.
+///
+/// @details Trace events are enabled by defining
+///  `ARG_PARSE_CONVERT_TRACE_EVENTS`, e.g. with the cmake option of the same
+///  name. Otherwise `TraceEventScope` is empty and records nothing.
+///
+#ifdef ARG_PARSE_CONVERT_TRACE_EVENTS
+inline constexpr bool kTraceEventsEnabled{true};
+#else
+inline constexpr bool kTraceEventsEnabled{false};
+#endif
+
+namespace internal {
+
+/// @brief Fixed-size ring buffer of the trace events of one thread.
+///
+/// @details Only the owning thread records events; `FlushTraceEvents` reads
+///  them concurrently without locking. Each slot carries a sequence number
+///  that is invalidated while the slot is written, so events overwritten
+///  during a flush are skipped instead of torn.
+///
+class TraceEventBuffer {
+ public:
+  /// @brief Number of events kept per thread; older events are overwritten.
+  ///
+  static constexpr std::size_t kCapacity{4096};
+
+  /// @brief Maximum number of characters of an event's detail.
+  ///
+  static constexpr std::size_t kMaxDetailLength{31};
+
+  explicit TraceEventBuffer(int thread_id) : thread_id_{thread_id} {}
+
+  /// @brief Records a complete event. Must only be called by the owning
+  ///  thread.
+  ///
+  void Record(const char* name, const std::string* detail,
+              std::chrono::steady_clock::time_point start,
+              std::chrono::steady_clock::time_point end);
+
+  /// @brief Writes the events recorded since the last call as comma-separated
+  ///  JSON objects, prefixing all but the first object written to `os` with a
+  ///  comma if `*first` is false. Sets `*first` to false if any event was
+  ///  written.
+  ///
+  /// @details Returns the number of events lost to overwriting.
+  ///
+  std::uint64_t Drain(std::ostream& os, bool* first);
+
+ private:
+  struct Slot {
+    std::atomic<std::uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<std::int64_t> start{0};
+    std::atomic<std::int64_t> duration{0};
+    // Detail characters packed into words, so they can be read concurrently.
+    std::array<std::atomic<std::uint64_t>, (kMaxDetailLength + 1) / 8>
+        detail{};
+  };
+
+  int thread_id_;
+  std::atomic<std::uint64_t> head_{0};
+  // Only accessed by `Drain`, which callers serialize.
+  std::uint64_t tail_{0};
+  std::array<Slot, kCapacity> slots_;
+};
+
+/// @brief Returns the buffer of the calling thread, taking a buffer of an
+///  exited thread or creating and registering one first if needed.
+///
+/// @details Buffers are never freed. When a thread exits, its buffer is
+///  recycled by the next thread recording events, which continues it under
+///  the same thread id. Buffers thus occupy memory for the largest number of
+///  threads which recorded events at the same time, and the events of an
+///  exited thread are kept until they are flushed or overwritten.
+///
+TraceEventBuffer& ThreadTraceEventBuffer();
+
+/// @brief Returns the primary name of the parameter with integer-identifier
+///  `id` in `parameters`, as detail of a trace event.
+///
+const std::string* TraceEventDetail(const ParameterMap& parameters, int id);
+
+} // namespace internal
+
+/// @brief Records a trace event spanning the lifetime of the object, if trace
+///  events are enabled.
+///
+/// @details `name` must point to a string literal. `detail`, e.g. the name
+///  of a parameter, is copied and truncated to
+///  `internal::TraceEventBuffer::kMaxDetailLength` characters.
+///
+class TraceEventScope {
+ public:
+#ifdef ARG_PARSE_CONVERT_TRACE_EVENTS
+  explicit TraceEventScope(const char* name, const std::string* detail = nullptr)
+      : name_{name}, detail_{detail},
+        start_{std::chrono::steady_clock::now()} {}
+
+  ~TraceEventScope() {
+    internal::ThreadTraceEventBuffer().Record(
+        name_, detail_, start_, std::chrono::steady_clock::now());
+  }
+  /// @brief Same as above, with the primary name of the parameter with
+  ///  integer-identifier `id` in `parameters` as detail, which is only looked
+  ///  up if trace events are enabled.
+  ///
+  TraceEventScope(const char* name, const ParameterMap& parameters, int id)
+      : TraceEventScope{name, internal::TraceEventDetail(parameters, id)} {}
+#else
+  explicit TraceEventScope(const char*, const std::string* = nullptr) {}
+
+  TraceEventScope(const char*, const ParameterMap&, int) {}
+#endif
+
+  TraceEventScope(const TraceEventScope&) = delete;
+  TraceEventScope& operator=(const TraceEventScope&) = delete;
+
+#ifdef ARG_PARSE_CONVERT_TRACE_EVENTS
+ private:
+  const char* name_;
+  const std::string* detail_;
+  std::chrono::steady_clock::time_point start_;
+#endif
+};
+
+/// @brief Writes the trace events recorded by all threads since the last call
+///  to `os` in Chrome's trace-event JSON format.
+///
+/// @details The output can be loaded by Perfetto and `chrome://tracing`.
+///  Timestamps are microseconds of `std::chrono::steady_clock`. The number
+///  of events lost because a thread's buffer was overwritten before the
+///  flush is reported as `dropped_events` in `otherData`. Writes an empty
+///  event list if trace events are disabled.
+///
+/// @exceptions Basic guarantee. Events drained before an exception of `os` are
+///  not written again.
+///
+void FlushTraceEvents(std::ostream& os);
+/// @}
+
+} // namespace arg_parse_convert
+
+#endif // ARG_PARSE_CONVERT_TRACE_EVENTS_H_
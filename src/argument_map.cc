@@ -20,10 +20,280 @@
 
 #include "argument_map.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
+#include <utility>
 
 namespace arg_parse_convert {
 
+// ConvertAll helpers.
+//
+namespace {
+
+// Describes a failed conversion.
+//
+struct ConversionFailure {
+  int id;
+  ArgumentMap::size_type pos;
+  std::string what;
+};
+
+// Counts down finished tasks and lets a thread wait until all are done.
+//
+class TaskCounter {
+ public:
+  explicit TaskCounter(ArgumentMap::size_type count) : remaining_{count} {}
+
+  // Notifies while holding the lock, so the waiting thread cannot destroy the
+  // object before the notifying thread is done with it.
+  void CountDown(ArgumentMap::size_type count = 1) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    remaining_ -= count;
+    if (remaining_ == 0) {
+      done_.notify_all();
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this]{return remaining_ == 0;});
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable done_;
+  ArgumentMap::size_type remaining_;
+};
+
+} // namespace
+
+// ArgumentMap::ArgumentMap
+//
+ArgumentMap::ArgumentMap(const ArgumentMap& other)
+    : parameters_{other.parameters_},
+      arguments_{other.arguments_},
+      value_states_{other.value_states_},
+      parse_observer_{other.parse_observer_},
+      trace_writer_{other.trace_writer_},
+      subcommand_{other.subcommand_},
+      subcommand_arguments_{
+          other.subcommand_arguments_ != nullptr
+          ? std::make_unique<ArgumentMap>(*other.subcommand_arguments_)
+          : nullptr} {
+  // States are copied first, so that each copied published state has a
+  // published value.
+  value_lists_ = other.ValuesSnapshot();
+}
+
+// ArgumentMap::operator=
+//
+ArgumentMap& ArgumentMap::operator=(const ArgumentMap& other) {
+  if (this != &other) {
+    ArgumentMap copy{other};
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+// ArgumentMap::ConvertAll
+//
+void ArgumentMap::ConvertAll(const Executor& executor,
+                             size_type chunk_size) const {
+  struct Chunk {
+    int id;
+    size_type begin, end;
+  };
+  std::vector<Chunk> chunks;
+
+  if (chunk_size == 0) {
+    std::stringstream error_message;
+    error_message << "Chunk size for `ArgumentMap::ConvertAll` must be"
+                  << " positive.";
+    throw exceptions::ValueAccessError(error_message.str());
+  }
+
+  for (int id = 0; id < static_cast<int>(arguments_.size()); ++id) {
+    if (parameters_->ValueConversionFunction(id) == nullptr) {
+      continue;
+    }
+    const std::vector<ValueState>& states{value_states_[id]};
+    for (size_type begin = 0; begin < states.size(); begin += chunk_size) {
+      size_type end{std::min(begin + chunk_size, states.size())};
+      // Chunks whose values were all computed before need no task.
+      if (std::any_of(states.begin() + begin, states.begin() + end,
+                      [](const ValueState& state) {
+                        return !state.HasValue();
+                      })) {
+        chunks.push_back(Chunk{id, begin, end});
+      }
+    }
+  }
+  if (chunks.empty()) {
+    return;
+  }
+
+  // Each task only touches its own range of values and its own failure list.
+  std::vector<std::vector<ConversionFailure>> failures(chunks.size());
+  TaskCounter counter{chunks.size()};
+  size_type scheduled{0};
+  try {
+    for (; scheduled < chunks.size(); ++scheduled) {
+      executor([this, &chunks, &failures, &counter, scheduled] {
+        const Chunk& chunk{chunks[scheduled]};
+        const std::function<std::any(const std::string&)>& converter{
+            parameters_->ValueConversionFunction(chunk.id)};
+        const std::vector<ValueState>& states{value_states_[chunk.id]};
+        std::vector<std::any>& values{value_lists_[chunk.id]};
+        const std::vector<std::string>& arguments{arguments_[chunk.id]};
+        TraceEventScope trace_event{"ConvertAll", *parameters_, chunk.id};
+        PhaseStatistics statistics;
+        auto start = (parse_observer_ != nullptr
+                          ? std::chrono::steady_clock::now()
+                          : std::chrono::steady_clock::time_point{});
+        for (size_type pos = chunk.begin; pos < chunk.end; ++pos) {
+          try {
+            states[pos].GetOrCompute(values[pos], [&converter, &arguments,
+                                                   &statistics, pos] {
+              ++statistics.tokens;
+              statistics.bytes += arguments[pos].size();
+              return converter(arguments[pos]);
+            });
+          } catch (const std::exception& e) {
+            failures[scheduled].push_back({chunk.id, pos, e.what()});
+          } catch (...) {
+            failures[scheduled].push_back({chunk.id, pos, "unknown error"});
+          }
+        }
+        if (parse_observer_ != nullptr) {
+          statistics.elapsed = std::chrono::steady_clock::now() - start;
+          parse_observer_->OnPhase(ParsePhase::kConvert, statistics);
+        }
+        counter.CountDown();
+      });
+    }
+  } catch (...) {
+    counter.CountDown(chunks.size() - scheduled);
+    counter.Wait();
+    throw;
+  }
+  counter.Wait();
+
+  // Report all failures at once.
+  std::stringstream error_message;
+  size_type num_failures{0};
+  for (const std::vector<ConversionFailure>& task_failures : failures) {
+    for (const ConversionFailure& failure : task_failures) {
+      error_message << (num_failures == 0 ? "" : "; ")
+                    << "parameter '" << parameters_->GetPrimaryName(failure.id)
+                    << "' at position '" << failure.pos << "' with argument '"
+                    << arguments_.at(failure.id).at(failure.pos) << "': "
+                    << failure.what;
+      ++num_failures;
+    }
+  }
+  if (num_failures > 0) {
+    throw exceptions::ValueConversionError(
+        "Failed to convert " + std::to_string(num_failures)
+        + " argument(s): " + error_message.str() + '.');
+  }
+}
+
+// ArgumentMap::ConvertAll
+//
+void ArgumentMap::ConvertAll() const {
+  ConvertAll([](std::function<void()> task) {task();});
+}
+
+// ArgumentMap::CheckValueAccess
+//
+void ArgumentMap::CheckValueAccess(size_type id, bool has_converter) const {
+  // Test if parameter has a conversion function.
+  if (!has_converter) {
+    std::stringstream error_message;
+    error_message << "Parameter identified by '"
+                  << parameters_->GetPrimaryName(id) << "' has no conversion"
+                  << " function associated with it.";
+    throw exceptions::ValueAccessError(error_message.str());
+  }
+  // Test if parameter is a flag.
+  if (parameters_->layout().IsFlag(id)) {
+    std::stringstream error_message;
+    error_message << "Attempted to use `ArgumentMap::GetValue` to check if flag"
+                     " named: '" << parameters_->GetPrimaryName(id) << "' was"
+                     " set. Use `ArgumentMap::IsSet` to test flag values.";
+    throw exceptions::ValueAccessError(error_message.str());
+  }
+}
+
+// ArgumentMap::CheckPosition
+//
+void ArgumentMap::CheckPosition(size_type id, int pos) const {
+  // Test if argument at position `pos` was assigned.
+  if (pos < 0 || static_cast<int>(arguments_[id].size()) <= pos) {
+    std::stringstream error_message;
+    error_message << "Attempted to access argument at position '" << pos
+                  << "' for parameter named '"
+                  << parameters_->GetPrimaryName(id) << "' but only '"
+                  << arguments_[id].size() << "' arguments were assigned.";
+    throw exceptions::ValueAccessError(error_message.str());
+  }
+}
+
+// ArgumentMap::SubcommandName
+//
+std::string_view ArgumentMap::SubcommandName() const {
+  if (!HasSubcommand()) {
+    std::stringstream error_message;
+    error_message << "Attempted to use `ArgumentMap::SubcommandName`, but no"
+                     " subcommand was parsed.";
+    throw exceptions::ValueAccessError(error_message.str());
+  }
+  return parameters_->SubcommandName(subcommand_);
+}
+
+// ArgumentMap::SubcommandArguments
+//
+const ArgumentMap& ArgumentMap::SubcommandArguments() const {
+  if (!HasSubcommand()) {
+    std::stringstream error_message;
+    error_message << "Attempted to use `ArgumentMap::SubcommandArguments`, but"
+                     " no subcommand was parsed.";
+    throw exceptions::ValueAccessError(error_message.str());
+  }
+  return *subcommand_arguments_;
+}
+
+// ArgumentMap::SubcommandArguments
+//
+ArgumentMap& ArgumentMap::SubcommandArguments() {
+  if (!HasSubcommand()) {
+    std::stringstream error_message;
+    error_message << "Attempted to use `ArgumentMap::SubcommandArguments`, but"
+                     " no subcommand was parsed.";
+    throw exceptions::ValueAccessError(error_message.str());
+  }
+  return *subcommand_arguments_;
+}
+
+// ArgumentMap::ValuesSnapshot
+//
+std::vector<std::vector<std::any>> ArgumentMap::ValuesSnapshot() const {
+  std::vector<std::vector<std::any>> result(value_lists_.size());
+  for (size_type id = 0; id < value_lists_.size(); ++id) {
+    const std::vector<ValueState>& states{value_states_[id]};
+    result[id].resize(states.size());
+    for (size_type pos = 0; pos < states.size(); ++pos) {
+      if (states[pos].HasValue()) {
+        result[id][pos] = value_lists_[id][pos];
+      }
+    }
+  }
+  return result;
+}
+
 // ArgumentMap::DebugString
 //
 std::string ArgumentMap::DebugString() const {
@@ -42,4 +312,38 @@ std::string ArgumentMap::DebugString() const {
   return ss.str();
 }
 
+// ArgumentMap::MemoryUsage
+//
+MemoryReport ArgumentMap::MemoryUsage() const {
+  MemoryReport report;
+  report.arguments = internal::HeapSize(arguments_);
+  for (const std::vector<std::string>& argument_list : arguments_) {
+    report.arguments += internal::HeapSize(argument_list);
+  }
+  report.values = (internal::HeapSize(value_lists_)
+                   + internal::HeapSize(value_states_));
+  for (size_type id = 0; id < value_lists_.size(); ++id) {
+    report.values += (internal::HeapSize(value_lists_[id])
+                      + internal::HeapSize(value_states_[id]));
+    for (size_type pos = 0; pos < value_states_[id].size(); ++pos) {
+      if (value_states_[id][pos].HasValue()) {
+        const std::any* value{&value_lists_[id][pos]};
+        report.values += parameters_->heap_footprints_[id].value;
+        // Strings are the only values whose own memory is known.
+        if (const auto* s = std::any_cast<std::string>(value); s != nullptr) {
+          report.values += internal::HeapSize(*s);
+        }
+      }
+    }
+  }
+  if (HasSubcommand()) {
+    MemoryReport subcommand_report{subcommand_arguments_->MemoryUsage()};
+    report.other = sizeof(ArgumentMap);
+    report.arguments += subcommand_report.arguments;
+    report.values += subcommand_report.values;
+    report.other += subcommand_report.other;
+  }
+  return report;
+}
+
 } // namespace arg_parse_convert
\ No newline at end of file
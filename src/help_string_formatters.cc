@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <cassert>
 
+#include "trace_events.h"
+
 namespace arg_parse_convert {
 
 // Help string formatting helpers.
@@ -35,7 +37,9 @@ std::string FormattedDescription(const ParameterConfiguration& configuration,
                                  int width, int indentation) {
   assert(width > 0 && indentation >= 0 && width > indentation);
   std::string result;
-  std::string_view description{configuration.description()};
+  // Descriptions are only built here.
+  std::string description_text{configuration.description_text().str()};
+  std::string_view description{description_text};
   int offset{0}, text_width{width - indentation};
   std::string_view::size_type break_pos;
   std::string_view window{description.substr(0, text_width + 1)};
@@ -70,11 +74,12 @@ std::string FormattedDescription(const ParameterConfiguration& configuration,
 //
 std::string Placeholder(const ParameterConfiguration& configuration) {
   std::string result;
-  if (configuration.placeholder().length() > 0) {
+  std::string placeholder{configuration.placeholder_text().str()};
+  if (placeholder.length() > 0) {
     if (configuration.category() != ParameterCategory::kPositionalParameter) {
       result.push_back(' ');
     }
-    result.append(configuration.placeholder());
+    result.append(placeholder);
   }
   return result;
 }
@@ -185,8 +190,10 @@ std::string FlagHelpString(const ParameterConfiguration& configuration,
 std::string FormattedHelpString(const ParameterMap& parameter_map,
     std::string header, std::string footer, int width,
     int parameter_indentation, int description_indentation) {
-  int required_positional{0}, required_keyword{0};
-  std::vector<int> sorted_required, sorted_keywords, sorted_flags;
+  TraceEventScope trace_event{"FormattedHelpString"};
+  const ParameterLayout& layout{parameter_map.layout()};
+  ParameterLayout::size_type num_required{0}, num_optional_keywords{0};
+  ParameterLayout::size_type num_optional_positional{0}, num_flags{0};
   // Preconditions.
   std::stringstream error_message;
   if (width <= 0 || parameter_indentation < 0 || description_indentation < 0
@@ -197,29 +204,37 @@ std::string FormattedHelpString(const ParameterMap& parameter_map,
                   << description_indentation << "').";
     throw exceptions::HelpStringError(error_message.str());
   }
+  for (ParameterLayout::size_type id = 0; id < layout.size(); ++id) {
+    if (layout.IsRequired(id)) {
+      ++num_required;
+    } else if (layout.IsFlag(id)) {
+      ++num_flags;
+    } else if (layout.IsKeyword(id)) {
+      ++num_optional_keywords;
+    } else {
+      ++num_optional_positional;
+    }
+  }
   // Header.
   std::string result{std::move(header)};
-  // Required parameters.
-  if (!parameter_map.required_parameters().empty()) {
-    sorted_required = std::vector<int>{
-        parameter_map.required_parameters().cbegin(),
-        parameter_map.required_parameters().cend()};
-    std::sort(sorted_required.begin(), sorted_required.end());
+  // Required parameters, ordered by integer-identifier.
+  if (num_required > 0) {
     result.append("\nRequired parameters:\n");
-    for (int id : sorted_required) {
-      switch (parameter_map.GetConfiguration(id).category()) {
+    for (ParameterLayout::size_type id = 0; id < layout.size(); ++id) {
+      if (!layout.IsRequired(id)) {
+        continue;
+      }
+      switch (layout.category(id)) {
         case ParameterCategory::kPositionalParameter: {
           result.append(PositionalHelpString(parameter_map.GetConfiguration(id),
                                              width, parameter_indentation,
                                              description_indentation));
-          required_positional += 1;
           break;
         }
         case ParameterCategory::kKeywordParameter: {
           result.append(KeywordHelpString(parameter_map.GetConfiguration(id),
                                           width, parameter_indentation,
                                           description_indentation));
-          required_keyword += 1;
           break;
         }
         default: {
@@ -229,45 +244,37 @@ std::string FormattedHelpString(const ParameterMap& parameter_map,
       }
     }
   }
-  // Non-required positional parameters.
-  if (static_cast<int>(parameter_map.positional_parameters().size())
-      > required_positional) {
+  // Non-required positional parameters, ordered by position.
+  if (num_optional_positional > 0) {
     result.append("\nOptional positional parameters:\n");
-    for (const auto& pair : parameter_map.positional_parameters()) {
-      if (!parameter_map.GetConfiguration(pair.second).IsRequired()) {
+    for (const auto& pair : layout.positional_parameters()) {
+      if (!layout.IsRequired(pair.second)) {
         result.append(PositionalHelpString(
             parameter_map.GetConfiguration(pair.second), width,
             parameter_indentation, description_indentation));
       }
     }
   }
-  // Non-required keyword parameters.
-  if (static_cast<int>(parameter_map.keyword_parameters().size())
-      > required_keyword) {
+  // Non-required keyword parameters, ordered by integer-identifier.
+  if (num_optional_keywords > 0) {
     result.append("\nOptional keyword parameters:\n");
-    sorted_keywords = std::vector<int>{
-        parameter_map.keyword_parameters().cbegin(),
-        parameter_map.keyword_parameters().cend()};
-    std::sort(sorted_keywords.begin(), sorted_keywords.end());
-    for (int id : sorted_keywords) {
-      if (!parameter_map.GetConfiguration(id).IsRequired()) {
+    for (ParameterLayout::size_type id = 0; id < layout.size(); ++id) {
+      if (layout.IsKeyword(id) && !layout.IsRequired(id)) {
         result.append(KeywordHelpString(parameter_map.GetConfiguration(id),
                                         width, parameter_indentation,
                                         description_indentation));
       }
     }
   }
-  // Flags.
-  if (!parameter_map.flags().empty()) {
+  // Flags, ordered by integer-identifier.
+  if (num_flags > 0) {
     result.append("\nFlags:\n");
-    sorted_flags = std::vector<int>{
-        parameter_map.flags().cbegin(),
-        parameter_map.flags().cend()};
-    std::sort(sorted_flags.begin(), sorted_flags.end());
-    for (int id : sorted_flags) {
-      result.append(FlagHelpString(parameter_map.GetConfiguration(id), width,
-                                   parameter_indentation,
-                                   description_indentation));
+    for (ParameterLayout::size_type id = 0; id < layout.size(); ++id) {
+      if (layout.IsFlag(id)) {
+        result.append(FlagHelpString(parameter_map.GetConfiguration(id), width,
+                                     parameter_indentation,
+                                     description_indentation));
+      }
     }
   }
   // Footer.
@@ -0,0 +1,90 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "name_table.h"
+
+#include <utility>
+
+namespace arg_parse_convert {
+
+namespace internal {
+
+// NameTable::Reserve
+//
+void NameTable::Reserve(size_type num_names) {
+  // At most seven eighths of the slots are used, so that probing ends.
+  size_type num_groups{NumGroups()};
+  if (num_names <= num_groups * (kGroupSize - 1)) {
+    return;
+  }
+  num_groups = (num_groups == 0 ? 1 : num_groups);
+  while (num_names > num_groups * (kGroupSize - 1)) {
+    num_groups *= 2;
+  }
+  NameTable table;
+  table.control_.assign(num_groups * kGroupSize, kEmpty);
+  table.slots_.resize(num_groups * kGroupSize);
+  for (size_type i = 0; i < slots_.size(); ++i) {
+    if (control_[i] != kEmpty) {
+      table.Place(std::string_view{slots_[i].data(), slots_[i].size},
+                  slots_[i].id);
+    }
+  }
+  std::swap(control_, table.control_);
+  std::swap(slots_, table.slots_);
+}
+
+// NameTable::Insert
+//
+void NameTable::Insert(std::string_view name, int id) {
+  if (size_ + 1 > NumGroups() * (kGroupSize - 1)) {
+    Reserve(2 * size_ + 1);
+  }
+  Place(name, id);
+}
+
+// NameTable::Place
+//
+void NameTable::Place(std::string_view name, int id) {
+  std::size_t hash{Hash(name)};
+  size_type mask{NumGroups() - 1};
+  size_type group{GroupIndex(hash) & mask};
+  std::uint64_t empty;
+  for (size_type step = 1;
+       (empty = MatchEmpty(LoadGroup(group))) == 0; ++step) {
+    group = (group + step) & mask;
+  }
+  size_type index{group * kGroupSize + LowestByte(empty)};
+  Slot& slot{slots_[index]};
+  slot.id = id;
+  slot.size = static_cast<std::uint32_t>(name.size());
+  if (name.size() <= kInlineSize) {
+    name.copy(slot.chars, name.size());
+  } else {
+    const char* data{name.data()};
+    std::memcpy(slot.chars, &data, sizeof(data));
+  }
+  control_[index] = Fingerprint(hash);
+  ++size_;
+}
+
+} // namespace internal
+
+} // namespace arg_parse_convert
@@ -42,9 +42,9 @@ const char* kParameterCategory[]{
 std::string ParameterConfiguration::DebugString() const {
   std::stringstream ss;
   ss << "{names: [";
-  if (!names_.empty()) {
-    ss << names_.at(0);
-    for (const std::string& name : names_) {
+  if (!names().empty()) {
+    ss << names().at(0);
+    for (const std::string& name : names()) {
       ss << ", " << name;
     }
   }
@@ -60,8 +60,8 @@ std::string ParameterConfiguration::DebugString() const {
   ss << "], position: " << position_
      << ", min number of arguments: " << min_num_arguments_
      << ", max number of arguments: " << max_num_arguments_
-     << ", description: " << description_
-     << ", argument placeholder: " << argument_placeholder_
+     << ", description: " << description_text().str()
+     << ", argument placeholder: " << placeholder_text().str()
      << "}.";
   return ss.str();
 }
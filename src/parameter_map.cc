@@ -20,61 +20,374 @@
 
 #include "parameter_map.h"
 
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include <sstream>
+#include <utility>
 
 namespace arg_parse_convert {
 
+namespace {
+
+// Reserves space for at least `size` elements, at least doubling the
+// capacity if it must grow.
+//
+template <class ValueType>
+void GrowVector(std::vector<ValueType>& vector, std::size_t size) {
+  if (size > vector.capacity()) {
+    vector.reserve(std::max(size, 2 * vector.capacity()));
+  }
+}
+
+} // namespace
+
+// ParameterLayout::Reserve
+//
+void ParameterLayout::Reserve(size_type num_parameters,
+                              size_type num_positional) {
+  size_type num_words{(num_parameters + kBitsPerWord - 1) / kBitsPerWord};
+  GrowVector(records_, num_parameters);
+  GrowVector(required_, num_words);
+  GrowVector(flags_, num_words);
+  GrowVector(positional_parameters_, num_positional);
+}
+
+// ParameterLayout::Add
+//
+void ParameterLayout::Add(const ParameterConfiguration& configuration) {
+  size_type id{records_.size()};
+  records_.push_back(Record{
+      configuration.position(), configuration.min_num_arguments(),
+      configuration.max_num_arguments(), configuration.category(),
+      !configuration.default_arguments().empty()});
+  if (id % kBitsPerWord == 0) {
+    required_.push_back(0);
+    flags_.push_back(0);
+  }
+  std::uint64_t bit{std::uint64_t{1} << (id % kBitsPerWord)};
+  if (configuration.IsRequired()) {
+    required_.back() |= bit;
+  }
+  if (configuration.category() == ParameterCategory::kFlag) {
+    flags_.back() |= bit;
+  } else if (configuration.category()
+             == ParameterCategory::kPositionalParameter) {
+    std::pair<int, int> entry{configuration.position(), static_cast<int>(id)};
+    positional_parameters_.insert(
+        std::upper_bound(positional_parameters_.begin(),
+                         positional_parameters_.end(), entry),
+        entry);
+  }
+}
+
+// ParameterMap::Reserve
+//
+void ParameterMap::Reserve(size_type num_parameters, size_type num_names) {
+  parameter_configurations_.reserve(num_parameters);
+  converters_.reserve(num_parameters);
+  value_converters_.reserve(num_parameters);
+  heap_footprints_.reserve(num_parameters);
+  name_to_id_.Reserve(num_names);
+  if (allow_abbreviations_ && num_names > name_to_id_.size()) {
+    abbreviations_.Reserve(num_names - name_to_id_.size());
+  }
+  layout_.records_.reserve(num_parameters);
+}
+
+// ParameterMap::AllowAbbreviations
+//
+void ParameterMap::AllowAbbreviations() {
+  if (allow_abbreviations_) {
+    return;
+  }
+  internal::PrefixTrie abbreviations;
+  abbreviations.Reserve(name_to_id_.size());
+  for (size_type id = 0; id < parameter_configurations_.size(); ++id) {
+    // Positional parameters are not named on the command line.
+    if (parameter_configurations_[id].category()
+        == ParameterCategory::kPositionalParameter) {
+      continue;
+    }
+    for (const std::string& name : parameter_configurations_[id].names()) {
+      abbreviations.Insert(name, static_cast<int>(id));
+    }
+  }
+  abbreviations_ = std::move(abbreviations);
+  allow_abbreviations_ = true;
+}
+
+// ParameterMap::Suggest
+//
+std::vector<std::string> ParameterMap::Suggest(std::string_view name,
+                                               size_type max_suggestions)
+    const {
+  if (parameter_configurations_.empty()) {
+    return {};
+  }
+  std::shared_ptr<const internal::SuggestionIndex> index{suggestions_.Get()};
+  if (index == nullptr) {
+    std::vector<std::string_view> names;
+    names.reserve(name_to_id_.size());
+    for (const ParameterConfiguration& configuration
+         : parameter_configurations_) {
+      // Positional parameters are not named on the command line.
+      if (configuration.category()
+          == ParameterCategory::kPositionalParameter) {
+        continue;
+      }
+      // Copies sharing the index also share the names it views.
+      names.insert(names.end(), configuration.names().begin(),
+                   configuration.names().end());
+    }
+    index = suggestions_.Publish(
+        std::make_shared<const internal::SuggestionIndex>(std::move(names)));
+  }
+  return index->Nearest(name, max_suggestions, (name.size() > 4 ? 2 : 1));
+}
+
+// ParameterMap::SubcommandName
+//
+std::string_view ParameterMap::SubcommandName(int id) const {
+  if (id < 0 || id >= static_cast<int>(subcommands_.size())) {
+    std::stringstream error_message;
+    error_message << "Unable to find subcommand with id: '" << id << "'.";
+    throw exceptions::ParameterAccessError(error_message.str());
+  }
+  return subcommands_[id].name;
+}
+
+// ParameterMap::SubcommandParameters
+//
+std::shared_ptr<const ParameterMap> ParameterMap::SubcommandParameters(
+    int id) const {
+  if (id < 0 || id >= static_cast<int>(subcommands_.size())) {
+    std::stringstream error_message;
+    error_message << "Unable to find subcommand with id: '" << id << "'.";
+    throw exceptions::ParameterAccessError(error_message.str());
+  }
+  const Subcommand& subcommand{subcommands_[id]};
+  std::shared_ptr<const ParameterMap> parameters{subcommand.parameters.Get()};
+  if (parameters == nullptr) {
+    parameters = subcommand.parameters.Publish(
+        std::make_shared<const ParameterMap>(subcommand.factory()));
+  }
+  return parameters;
+}
+
 // ParameterMap::DebugString
 //
 std::string ParameterMap::DebugString() const {
   std::stringstream ss;
+  auto print_names = [&ss, this](int id) {
+    ss << '{';
+    for (const std::string& name : parameter_configurations_.at(id).names()) {
+      ss << name << ',';
+    }
+    ss << '}';
+  };
+  int num_parameters{static_cast<int>(size())};
   ss << "{size: " << size() << ", required: [";
-  if (required_parameters_.size() > 0) {
-    for (int id : required_parameters_) {
-      ss << '{';
-      for (const std::string& name
-           : parameter_configurations_.at(id).names()) {
-        ss << name << ',';
-      }
-      ss << "}";
+  for (int id = 0; id < num_parameters; ++id) {
+    if (layout_.IsRequired(id)) {
+      print_names(id);
     }
   }
   ss << "], positional: [";
-  if (positional_parameters_.size() > 0) {
-    for (auto pair : positional_parameters_) {
-      ss << '(' << pair.first << ',';
-      ss << '{';
-      for (const std::string& name
-           : parameter_configurations_.at(pair.second).names()) {
-        ss << name << ',';
-      }
-      ss << "})";
-    }
+  for (auto pair : layout_.positional_parameters()) {
+    ss << '(' << pair.first << ',';
+    print_names(pair.second);
+    ss << ')';
   }
   ss << "], keyword: [";
-  if (keyword_parameters_.size() > 0) {
-    for (int id : keyword_parameters_) {
-      ss << '{';
-      for (const std::string& name
-           : parameter_configurations_.at(id).names()) {
-        ss << name << ',';
-      }
-      ss << "}";
+  for (int id = 0; id < num_parameters; ++id) {
+    if (layout_.IsKeyword(id)) {
+      print_names(id);
     }
   }
   ss << "], flags: [";
-  if (flags_.size() > 0) {
-    for (int id : flags_) {
-      ss << '{';
-      for (const std::string& name
-           : parameter_configurations_.at(id).names()) {
-        ss << name << ',';
-      }
-      ss << "}";
+  for (int id = 0; id < num_parameters; ++id) {
+    if (layout_.IsFlag(id)) {
+      print_names(id);
     }
   }
   ss << "]}";
   return ss.str();
 }
 
+// ParameterMap::CheckRegistration
+//
+void ParameterMap::CheckRegistration(
+    const ParameterConfiguration& configuration) const {
+  if (configuration.names().empty()) {
+    std::stringstream error_message;
+    error_message << "Parameter must be given at least one name.";
+    throw exceptions::ParameterRegistrationError(error_message.str());
+  }
+  for (const std::string& name : configuration.names()) {
+    if (name_to_id_.Find(name) != internal::NameTable::kNotFound) {
+      std::stringstream error_message;
+      error_message << "Name '" << name << "' already taken by another"
+                    << " parameter.";
+      throw exceptions::ParameterRegistrationError(error_message.str());
+    }
+  }
+  const std::vector<std::pair<int, int>>& positional_parameters{
+      layout_.positional_parameters()};
+  auto position_it = std::lower_bound(
+      positional_parameters.begin(), positional_parameters.end(),
+      std::make_pair(configuration.position(),
+                     std::numeric_limits<int>::min()));
+  if (configuration.category() == ParameterCategory::kPositionalParameter
+      && position_it != positional_parameters.end()
+      && position_it->first == configuration.position()) {
+    int other_id{position_it->second};
+    std::stringstream error_message;
+    error_message << "Position '" << configuration.position() << "' for"
+                  << " parameter named '" << configuration.names().at(0)
+                  << "' already taken by parameter named: '"
+                  << parameter_configurations_.at(other_id).names().at(0)
+                  << "'.";
+    throw exceptions::ParameterRegistrationError(error_message.str());
+  }
+}
+
+// ParameterMap::InsertSubcommand
+//
+void ParameterMap::InsertSubcommand(const std::string& name,
+                                    std::function<ParameterMap()> factory,
+                                    std::size_t factory_heap_size) {
+  if (name.empty() || name.front() == '-') {
+    std::stringstream error_message;
+    error_message << "Subcommand name '" << name << "' must be non-empty and"
+                  << " must not start with '-'.";
+    throw exceptions::ParameterRegistrationError(error_message.str());
+  }
+  if (subcommand_ids_.Find(name) != internal::NameTable::kNotFound) {
+    std::stringstream error_message;
+    error_message << "Name '" << name << "' already taken by another"
+                  << " subcommand.";
+    throw exceptions::ParameterRegistrationError(error_message.str());
+  }
+  if (strings_ == nullptr) {
+    strings_ = std::make_shared<StringPool>();
+  }
+  GrowVector(subcommands_, subcommands_.size() + 1);
+  subcommand_ids_.Reserve(subcommand_ids_.size() + 1);
+  std::string_view interned_name{strings_->Intern(name)};
+
+  // Space was reserved, so neither insertion throws.
+  subcommands_.emplace_back();
+  subcommands_.back().name = interned_name;
+  subcommands_.back().factory.swap(factory);
+  subcommands_.back().factory_heap_size = factory_heap_size;
+  subcommand_ids_.Insert(interned_name,
+                         static_cast<int>(subcommands_.size() - 1));
+}
+
+// ParameterMap::ReserveAdditional
+//
+void ParameterMap::ReserveAdditional(size_type num_parameters,
+                                     size_type num_names,
+                                     size_type num_positional) {
+  size_type size{parameter_configurations_.size() + num_parameters};
+  GrowVector(parameter_configurations_, size);
+  GrowVector(converters_, size);
+  GrowVector(value_converters_, size);
+  GrowVector(heap_footprints_, size);
+  name_to_id_.Reserve(name_to_id_.size() + num_names);
+  if (allow_abbreviations_) {
+    abbreviations_.Reserve(num_names);
+  }
+  layout_.Reserve(size,
+                  layout_.positional_parameters().size() + num_positional);
+}
+
+// ParameterMap::CategorySets
+//
+const ParameterMap::Categories& ParameterMap::CategorySets() const {
+  std::shared_ptr<const Categories> categories{category_sets_.Get()};
+  if (categories == nullptr) {
+    auto built = std::make_shared<Categories>();
+    int num_parameters{static_cast<int>(size())};
+    for (int id = 0; id < num_parameters; ++id) {
+      if (layout_.IsRequired(id)) {
+        built->required_parameters.insert(id);
+      }
+      if (layout_.IsKeyword(id)) {
+        built->keyword_parameters.insert(id);
+      } else if (layout_.IsFlag(id)) {
+        built->flags.insert(id);
+      }
+    }
+    built->positional_parameters.insert(
+        layout_.positional_parameters().begin(),
+        layout_.positional_parameters().end());
+    categories = category_sets_.Publish(std::move(built));
+  }
+  return *categories;
+}
+
+// ParameterMap::MemoryUsage
+//
+MemoryReport ParameterMap::MemoryUsage() const {
+  MemoryReport report;
+  for (const ParameterConfiguration& configuration
+       : parameter_configurations_) {
+    report.names += (internal::SharedHeapSize<std::vector<std::string>>()
+                     + internal::HeapSize(configuration.names()));
+    report.descriptions += configuration.description_text().HeapSize()
+                           + configuration.placeholder_text().HeapSize();
+    report.defaults += internal::HeapSize(configuration.default_arguments());
+  }
+  if (strings_ != nullptr) {
+    report.names += (internal::SharedHeapSize<StringPool>()
+                     + strings_->HeapSize());
+  }
+  report.converters = internal::HeapSize(converters_)
+                      + internal::HeapSize(value_converters_);
+  for (const HeapFootprint& heap_footprint : heap_footprints_) {
+    report.converters += heap_footprint.converters;
+  }
+  report.hash_tables = name_to_id_.HeapSize() + abbreviations_.HeapSize();
+  if (std::shared_ptr<const Categories> categories{category_sets_.Get()}) {
+    report.hash_tables +=
+        (internal::SharedHeapSize<Categories>()
+         + internal::HeapSize(categories->required_parameters)
+         + internal::HeapSize(categories->positional_parameters)
+         + internal::HeapSize(categories->keyword_parameters)
+         + internal::HeapSize(categories->flags));
+  }
+  if (std::shared_ptr<const internal::SuggestionIndex> index{
+          suggestions_.Get()}) {
+    report.hash_tables += (internal::SharedHeapSize<internal::SuggestionIndex>()
+                           + index->HeapSize());
+  }
+  report.hash_tables += subcommand_ids_.HeapSize();
+  report.other = internal::HeapSize(parameter_configurations_)
+                 + internal::HeapSize(subcommands_)
+                 + internal::HeapSize(heap_footprints_)
+                 + internal::HeapSize(layout_.records_)
+                 + internal::HeapSize(layout_.required_)
+                 + internal::HeapSize(layout_.flags_)
+                 + internal::HeapSize(layout_.positional_parameters_);
+  for (const Subcommand& subcommand : subcommands_) {
+    report.other += subcommand.factory_heap_size;
+    // Parameters of subcommands are only owned by this object and its
+    // copies, once created.
+    if (std::shared_ptr<const ParameterMap> parameters{
+            subcommand.parameters.Get()}) {
+      MemoryReport subcommand_report{parameters->MemoryUsage()};
+      report.names += subcommand_report.names;
+      report.descriptions += subcommand_report.descriptions;
+      report.defaults += subcommand_report.defaults;
+      report.converters += subcommand_report.converters;
+      report.hash_tables += subcommand_report.hash_tables;
+      report.other += (internal::SharedHeapSize<ParameterMap>()
+                       + subcommand_report.other);
+    }
+  }
+  return report;
+}
+
 } // namespace arg_parse_convert
\ No newline at end of file
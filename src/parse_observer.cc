@@ -0,0 +1,118 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "parse_observer.h"
+
+#include <sstream>
+
+namespace arg_parse_convert {
+
+// ParsePhaseName
+//
+const char* ParsePhaseName(ParsePhase phase) {
+  switch (phase) {
+    case ParsePhase::kTokenize: return "tokenize";
+    case ParsePhase::kLookup: return "lookup";
+    case ParsePhase::kAssign: return "assign";
+    case ParsePhase::kConvert: return "convert";
+  }
+  return "unknown";
+}
+
+// HistogramParseObserver::OnPhase
+//
+void HistogramParseObserver::OnPhase(
+    ParsePhase phase, const PhaseStatistics& statistics) noexcept {
+  AtomicHistogram& histogram{histograms_[static_cast<std::size_t>(phase)]};
+  std::int64_t elapsed{statistics.elapsed.count()};
+  std::size_t bucket{0};
+  for (std::int64_t ns = elapsed; ns > 0; ns >>= 1) {
+    ++bucket;
+  }
+  histogram.count.fetch_add(1, std::memory_order_relaxed);
+  histogram.tokens.fetch_add(statistics.tokens, std::memory_order_relaxed);
+  histogram.lookups.fetch_add(statistics.lookups, std::memory_order_relaxed);
+  histogram.bytes.fetch_add(statistics.bytes, std::memory_order_relaxed);
+  histogram.elapsed.fetch_add(elapsed, std::memory_order_relaxed);
+  histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+// HistogramParseObserver::Histogram
+//
+PhaseHistogram HistogramParseObserver::Histogram(ParsePhase phase) const {
+  const AtomicHistogram& histogram{
+      histograms_[static_cast<std::size_t>(phase)]};
+  PhaseHistogram result;
+  result.count = histogram.count.load(std::memory_order_relaxed);
+  result.tokens = histogram.tokens.load(std::memory_order_relaxed);
+  result.lookups = histogram.lookups.load(std::memory_order_relaxed);
+  result.bytes = histogram.bytes.load(std::memory_order_relaxed);
+  result.elapsed = std::chrono::nanoseconds{
+      histogram.elapsed.load(std::memory_order_relaxed)};
+  for (std::size_t i = 0; i < PhaseHistogram::kNumBuckets; ++i) {
+    result.buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+// HistogramParseObserver::Reset
+//
+void HistogramParseObserver::Reset() {
+  for (AtomicHistogram& histogram : histograms_) {
+    histogram.count.store(0, std::memory_order_relaxed);
+    histogram.tokens.store(0, std::memory_order_relaxed);
+    histogram.lookups.store(0, std::memory_order_relaxed);
+    histogram.bytes.store(0, std::memory_order_relaxed);
+    histogram.elapsed.store(0, std::memory_order_relaxed);
+    for (std::atomic<std::uint64_t>& bucket : histogram.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+// HistogramParseObserver::ToJson
+//
+std::string HistogramParseObserver::ToJson() const {
+  std::stringstream ss;
+  ss << '{';
+  for (std::size_t i = 0; i < kNumParsePhases; ++i) {
+    ParsePhase phase{static_cast<ParsePhase>(i)};
+    PhaseHistogram histogram{Histogram(phase)};
+    std::size_t num_buckets{PhaseHistogram::kNumBuckets};
+    while (num_buckets > 0 && histogram.buckets[num_buckets - 1] == 0) {
+      --num_buckets;
+    }
+    ss << (i > 0 ? ", " : "") << '"' << ParsePhaseName(phase) << "\": {"
+       << "\"count\": " << histogram.count
+       << ", \"tokens\": " << histogram.tokens
+       << ", \"lookups\": " << histogram.lookups
+       << ", \"bytes\": " << histogram.bytes
+       << ", \"elapsed_ns\": " << histogram.elapsed.count()
+       << ", \"buckets\": [";
+    for (std::size_t j = 0; j < num_buckets; ++j) {
+      ss << (j > 0 ? ", " : "") << histogram.buckets[j];
+    }
+    ss << "]}";
+  }
+  ss << '}';
+  return ss.str();
+}
+
+} // namespace arg_parse_convert
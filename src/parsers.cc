@@ -22,7 +22,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iterator>
+#include <string_view>
+
+#include "trace.h"
+#include "trace_events.h"
 
 namespace arg_parse_convert {
 
@@ -48,32 +53,37 @@ int NumHyphens(const std::string& arg) {
 //
 bool IsFull(int id, int num_arguments, const ParameterMap& parameters) {
   assert(0 <= id && id < static_cast<int>(parameters.size()));
-  return (parameters.GetConfiguration(id).max_num_arguments() > 0
-          && num_arguments >= parameters.GetConfiguration(id)
-                                        .max_num_arguments());
+  return parameters.layout().IsFull(id, num_arguments);
 }
 
-// Closes a keyword parameter's argument list by setting `it` to `cend`.
+// Identifies no keyword parameter; the state of `open_keyword` while no
+// keyword parameter's argument list is open.
+//
+constexpr int kNoKeyword{-1};
+
+// Positional parameters ordered by position, as (position, id) pairs.
 //
-void CloseKeyword(std::unordered_set<int>::const_iterator& it,
-                  const ParameterMap& parameters) {
-  it = parameters.keyword_parameters().cend();
+using PositionalList = std::vector<std::pair<int, int>>;
+
+// Closes a keyword parameter's argument list.
+//
+void CloseKeyword(int& open_keyword) {
+  open_keyword = kNoKeyword;
 }
 
-// Opens a keyword parameter's argument list by setting `it` to point to it.
+// Opens the argument list of keyword parameter identified by `id`.
 //
-void OpenKeyword(std::unordered_set<int>::const_iterator& it,
-    const ParameterMap& parameters, int id) {
-  it = parameters.keyword_parameters().find(id);
-  assert(it != parameters.keyword_parameters().cend());
+void OpenKeyword(int& open_keyword, const ParameterMap& parameters, int id) {
+  assert(parameters.layout().IsKeyword(id));
+  open_keyword = id;
 }
 
-// Closes a positional parameter's argument list by incrementing it and setting
-// `positional_open` to false.
+// Closes a positional parameter's argument list by incrementing `it` and
+// setting `positional_open` to false.
 //
-void ClosePositional(std::map<int, int>::const_iterator& it,
+void ClosePositional(PositionalList::const_iterator& it,
                      const ParameterMap& parameters, bool& positional_open) {
-  assert(it != parameters.positional_parameters().cend());
+  assert(it != parameters.layout().positional_parameters().cend());
   ++it;
   positional_open = false;
 }
@@ -81,39 +91,107 @@ void ClosePositional(std::map<int, int>::const_iterator& it,
 // Moves `argument` to the end of `arg_list` item at parameter's identifier
 // referred to by `it`. Closes argument list if full.
 //
-void AddPositionalArgument(std::map<int, int>::const_iterator& it,
+void AddPositionalArgument(PositionalList::const_iterator& it,
     std::string&& argument, const ParameterMap& parameters,
     bool& positional_open,
     std::unordered_map<int, std::vector<std::string>>& arg_lists) {
-  assert(it != parameters.positional_parameters().cend());
-  arg_lists[it->second].emplace_back(argument);
-  if (IsFull(it->second, arg_lists.at(it->second).size(), parameters)) {
+  assert(it != parameters.layout().positional_parameters().cend());
+  std::vector<std::string>& arg_list{arg_lists[it->second]};
+  arg_list.emplace_back(std::move(argument));
+  if (IsFull(it->second, arg_list.size(), parameters)) {
     ClosePositional(it, parameters, positional_open);
   } else {
     positional_open = true;
   }
 }
 
-// Moves `argument` to the end of `arg_list` item at parameter's identifier
-// referred to by `it`. Closes argument list if full.
+// Moves `argument` to the end of `arg_list` item of the keyword parameter
+// identified by `open_keyword`. Closes argument list if full.
 //
-void AddKeywordArgument(std::unordered_set<int>::const_iterator& it,
-    std::string&& argument, const ParameterMap& parameters,
+void AddKeywordArgument(int& open_keyword, std::string&& argument,
+    const ParameterMap& parameters,
     std::unordered_map<int, std::vector<std::string>>& arg_lists) {
-  assert(it != parameters.keyword_parameters().cend());
-  arg_lists[*it].emplace_back(argument);
-  if (IsFull(*it, arg_lists.at(*it).size(), parameters)) {
-    CloseKeyword(it, parameters);
+  assert(open_keyword != kNoKeyword);
+  std::vector<std::string>& arg_list{arg_lists[open_keyword]};
+  arg_list.emplace_back(std::move(argument));
+  if (IsFull(open_keyword, arg_list.size(), parameters)) {
+    CloseKeyword(open_keyword);
   }
 }
 
 // Sets the flag. A flag is considered set if it has at least one argument.
 //
 void SetFlag(std::vector<std::string>& flag_argument_list,
-             const std::string& name) {
+             std::string_view name) {
   flag_argument_list.emplace_back(name);
 }
 
+// Returns the current time if `observer` is set; avoids reading the clock
+// otherwise.
+//
+std::chrono::steady_clock::time_point Now(const ParseObserver* observer) {
+  return (observer != nullptr ? std::chrono::steady_clock::now()
+                              : std::chrono::steady_clock::time_point{});
+}
+
+// Notifies `observer`, if set, of the phases of a completed parse. `scan`
+// contains the time spent in tokenizing and lookup together.
+//
+void ReportPhases(ParseObserver* observer, PhaseStatistics scan,
+                  std::chrono::nanoseconds lookup_elapsed,
+                  PhaseStatistics assign) {
+  if (observer == nullptr) {
+    return;
+  }
+  PhaseStatistics lookup;
+  lookup.lookups = scan.lookups;
+  lookup.elapsed = lookup_elapsed;
+  scan.lookups = 0;
+  scan.elapsed -= lookup_elapsed;
+  observer->OnPhase(ParsePhase::kTokenize, scan);
+  observer->OnPhase(ParsePhase::kLookup, lookup);
+  observer->OnPhase(ParsePhase::kAssign, assign);
+}
+
+// Returns the total number of arguments in `tmp_args`.
+//
+std::size_t NumArguments(
+    const std::unordered_map<int, std::vector<std::string>>& tmp_args) {
+  std::size_t result{0};
+  for (const auto& id_args_pair : tmp_args) {
+    result += id_args_pair.second.size();
+  }
+  return result;
+}
+
+// Collects the lines read by `ParseFile` and writes them to `writer` when
+// destroyed, also if parsing failed.
+//
+class FileCapture {
+ public:
+  explicit FileCapture(TraceWriter* writer) : writer_{writer} {}
+
+  ~FileCapture() {
+    if (writer_ != nullptr) {
+      try {
+        writer_->Write(TraceRecordKind::kFile, lines_);
+      } catch (...) {
+        // Capturing must not affect parsing.
+      }
+    }
+  }
+
+  inline void AddLine(const std::string& line) {
+    if (writer_ != nullptr) {
+      lines_.push_back(line);
+    }
+  }
+
+ private:
+  TraceWriter* writer_;
+  std::vector<std::string> lines_;
+};
+
 // Assigns list of arguments of each entry in `tmp_args` to the parameter
 // identified by the entry's key, unless that parameter already has arguments
 // assiged to it. If the list of arguments exceeds the parameter's maximum
@@ -127,11 +205,11 @@ void AssignArguments(
     const ParameterMap& parameters,
     std::vector<std::vector<std::string>>& map_args,
     std::vector<std::string>& additional_args) {
+  TraceEventScope trace_event{"AssignArguments"};
   assert(parameters.size() == map_args.size());
   int num_args, max_num_args;
   for (auto& id_args_pair : tmp_args) {
-    max_num_args = parameters.GetConfiguration(id_args_pair.first)
-                             .max_num_arguments();
+    max_num_args = parameters.layout().max_num_arguments(id_args_pair.first);
     num_args = id_args_pair.second.size();
     if (map_args.at(id_args_pair.first).size()) {
       additional_args.reserve(additional_args.size() + num_args);
@@ -180,6 +258,24 @@ void AddArgumentList(
     }
   } while (end != std::string_view::npos && start < argument_list.length());
 }
+
+// Appends a question listing `suggestions`, each preceded by `prefix`, to
+// `error_message` if there are any.
+//
+void AppendSuggestions(std::stringstream& error_message,
+                       const std::vector<std::string>& suggestions,
+                       const char* prefix) {
+  if (suggestions.empty()) {
+    return;
+  }
+  error_message << " Did you mean:";
+  for (std::vector<std::string>::size_type i = 0; i < suggestions.size();
+       ++i) {
+    error_message << (i == 0 ? " '" : ", '") << prefix << suggestions[i]
+                  << "'";
+  }
+  error_message << "?";
+}
   
 } // namespace
 
@@ -187,26 +283,45 @@ void AddArgumentList(
 //
 std::vector<std::string> ParseArgs(int argc, const char** argv,
                                    ArgumentMap& arguments) {
+  TraceEventScope trace_event{"ParseArgs"};
   std::unordered_map<int, std::vector<std::string>> tmp_args;
   std::vector<std::string> additional_args;
   std::string argument;
-  std::string short_name, long_name;
+  std::string_view short_name, long_name;
   int num_hyphens;
   std::stringstream error_message;
 
-  auto positional_it = arguments.Parameters().positional_parameters().cbegin();
-  auto positional_end = arguments.Parameters().positional_parameters().cend();
-  auto keyword_it = arguments.Parameters().keyword_parameters().cend();
-  auto keyword_end = arguments.Parameters().keyword_parameters().cend();
+  const ParameterLayout& layout{arguments.Parameters().layout()};
+  const PositionalList& positional_parameters{layout.positional_parameters()};
+  auto positional_it = positional_parameters.cbegin();
+  auto positional_end = positional_parameters.cend();
+  int open_keyword{kNoKeyword};
   bool positional_only = false;
   bool positional_open = false;
 
-  // Scan arguments from left-to-right.
-  for (int i = 1; i < argc; ++i) {
+  if (arguments.trace_writer() != nullptr) {
+    try {
+      arguments.trace_writer()->WriteArguments(argc, argv);
+    } catch (...) {
+      // Capturing must not affect parsing.
+    }
+  }
+  ParseObserver* observer{arguments.parse_observer()};
+  PhaseStatistics scan, assign;
+  std::chrono::nanoseconds lookup_elapsed{0};
+  std::chrono::steady_clock::time_point start{Now(observer)}, lookup_start;
+  bool is_flag, is_keyword;
+  int id;
+  int subcommand{ParameterMap::kNoMatch};
+  int end{argc};
+
+  // Scan arguments from left-to-right, up to the name of a subcommand.
+  for (int i = 1; i < end; ++i) {
     argument = argv[i];
+    scan.bytes += argument.size();
     if (argument == "--") {
       // No more flags and keyword parameters from this point on.
-      keyword_it = keyword_end;
+      CloseKeyword(open_keyword);
       positional_only = true;
     } else if (positional_only) {
       if (positional_it != positional_end) {
@@ -223,9 +338,22 @@ std::vector<std::string> ParseArgs(int argc, const char** argv,
           // positional parameter argument lists. When keyword parameter's
           // argument list opens, any argument list of positional parameter is
           // closed.
-          if (keyword_it != keyword_end) {
-            AddKeywordArgument(keyword_it, std::move(argument),
+          if (open_keyword != kNoKeyword) {
+            AddKeywordArgument(open_keyword, std::move(argument),
                 arguments.Parameters(), tmp_args);
+          // The remaining arguments belong to a subcommand named by this
+          // argument.
+          } else if ((subcommand
+                      = arguments.Parameters().FindSubcommand(argument))
+                     != ParameterMap::kNoMatch) {
+            if (arguments.HasSubcommand()
+                && arguments.subcommand_ != subcommand) {
+              error_message << "Subcommand '" << argument << "' follows"
+                            << " subcommand '" << arguments.SubcommandName()
+                            << "'.";
+              throw exceptions::ArgumentParsingError(error_message.str());
+            }
+            end = i;
           // Positional parameter argument list is open once an argument was
           // added and it expects more.
           } else if (positional_it != positional_end) {
@@ -238,7 +366,7 @@ std::vector<std::string> ParseArgs(int argc, const char** argv,
         }
         case 1: {
           // Close current open parameter argument lists.
-          CloseKeyword(keyword_it, arguments.Parameters());
+          CloseKeyword(open_keyword);
           if (positional_open) {
             ClosePositional(positional_it, arguments.Parameters(),
                             positional_open);
@@ -246,16 +374,19 @@ std::vector<std::string> ParseArgs(int argc, const char** argv,
           // Set each flag character, or open keyword parameter argument list
           // for the last character.
           for (int j = 1; j < static_cast<int>(argument.length()); ++j) {
-            short_name = std::string(1, argument.at(j));
-            if (arguments.Parameters().Contains(short_name)
-                && arguments.Parameters().IsFlag(short_name)) {
-              SetFlag(tmp_args[arguments.Parameters().GetId(short_name)],
-                      short_name);
-            } else if (arguments.Parameters().Contains(short_name)
-                       && j == static_cast<int>(argument.length()) - 1
-                       && arguments.Parameters().IsKeyword(short_name)) {
-              OpenKeyword(keyword_it, arguments.Parameters(),
-                  arguments.Parameters().GetId(short_name));
+            short_name = std::string_view{argument}.substr(j, 1);
+            lookup_start = Now(observer);
+            id = arguments.Parameters().FindId(short_name);
+            is_flag = (id >= 0 && layout.IsFlag(id));
+            is_keyword = (id >= 0 && !is_flag
+                          && j == static_cast<int>(argument.length()) - 1
+                          && layout.IsKeyword(id));
+            lookup_elapsed += Now(observer) - lookup_start;
+            ++scan.lookups;
+            if (is_flag) {
+              SetFlag(tmp_args[id], short_name);
+            } else if (is_keyword) {
+              OpenKeyword(open_keyword, arguments.Parameters(), id);
             } else {
               error_message << "Invalid option: '" << argument.at(j) << "' in"
                             << " option list: '" << argument << "'. Option must"
@@ -268,24 +399,40 @@ std::vector<std::string> ParseArgs(int argc, const char** argv,
         }
         case 2: {
           // Close current open parameter argument lists.
-          CloseKeyword(keyword_it, arguments.Parameters());
+          CloseKeyword(open_keyword);
           if (positional_open) {
             ClosePositional(positional_it, arguments.Parameters(),
                             positional_open);
           }
-          // Remove hyphens prefix and test whether flag or keyword.
-          long_name = argument.substr(2);
-          if (arguments.Parameters().Contains(long_name)
-              && arguments.Parameters().IsFlag(long_name)) {
-            SetFlag(tmp_args[arguments.Parameters().GetId(long_name)],
-                    long_name);
-          } else if (arguments.Parameters().Contains(long_name)
-                     && arguments.Parameters().IsKeyword(long_name)) {
-            OpenKeyword(keyword_it, arguments.Parameters(),
-                        arguments.Parameters().GetId(long_name));
+          // Remove hyphens prefix and test whether flag or keyword, possibly
+          // abbreviated.
+          long_name = std::string_view{argument}.substr(2);
+          lookup_start = Now(observer);
+          id = arguments.Parameters().MatchAbbreviation(long_name);
+          is_flag = (id >= 0 && layout.IsFlag(id));
+          is_keyword = (id >= 0 && !is_flag && layout.IsKeyword(id));
+          lookup_elapsed += Now(observer) - lookup_start;
+          ++scan.lookups;
+          if (id == ParameterMap::kAmbiguousMatch) {
+            error_message << "Ambiguous argument: '" << argv[i] << "'. It"
+                          << " abbreviates:";
+            for (const std::string& name
+                 : arguments.Parameters().NamesStartingWith(long_name)) {
+              error_message << " '--" << name << "'";
+            }
+            error_message << ".";
+            throw exceptions::ArgumentParsingError(error_message.str());
+          } else if (is_flag) {
+            SetFlag(tmp_args[id], long_name);
+          } else if (is_keyword) {
+            OpenKeyword(open_keyword, arguments.Parameters(), id);
           } else {
+            std::vector<std::string> suggestions{
+                arguments.Parameters().Suggest(long_name)};
             error_message << "Invalid argument: '" << argv[i] << "'.";
-            throw exceptions::ArgumentParsingError(error_message.str());
+            AppendSuggestions(error_message, suggestions, "--");
+            throw exceptions::ArgumentParsingError(error_message.str(),
+                                                   std::move(suggestions));
           }
           break;
         }
@@ -296,8 +443,33 @@ std::vector<std::string> ParseArgs(int argc, const char** argv,
       }
     }
   }
+  scan.tokens = (end > 1 ? end - 1 : 0);
+  scan.elapsed = Now(observer) - start;
+  start = Now(observer);
+  assign.tokens = (observer != nullptr ? NumArguments(tmp_args) : 0);
   AssignArguments(tmp_args, arguments.Parameters(), arguments.arguments_,
                   additional_args);
+  arguments.ResizeValueLists();
+  assign.elapsed = Now(observer) - start;
+  ReportPhases(observer, scan, lookup_elapsed, assign);
+
+  // Parse the arguments following the subcommand's name for its parameters,
+  // which are only created now.
+  if (end < argc) {
+    if (!arguments.HasSubcommand()) {
+      arguments.subcommand_arguments_ = std::make_unique<ArgumentMap>(
+          arguments.Parameters().SubcommandParameters(subcommand));
+      arguments.subcommand_arguments_->SetParseObserver(observer);
+      arguments.subcommand_ = subcommand;
+    }
+    std::vector<std::string> subcommand_additional_args{
+        ParseArgs(argc - end, argv + end,
+                  *arguments.subcommand_arguments_)};
+    additional_args.insert(
+        additional_args.end(),
+        std::make_move_iterator(subcommand_additional_args.begin()),
+        std::make_move_iterator(subcommand_additional_args.end()));
+  }
   return additional_args;
 }
 
@@ -305,6 +477,7 @@ std::vector<std::string> ParseArgs(int argc, const char** argv,
 //
 std::vector<std::string> ParseFile(std::istream& config_is,
                                    ArgumentMap& arguments) {
+  TraceEventScope trace_event{"ParseFile"};
   std::unordered_map<int, std::vector<std::string>> tmp_args;
   std::vector<std::string> additional_args;
 
@@ -316,32 +489,50 @@ std::vector<std::string> ParseFile(std::istream& config_is,
 
   std::stringstream error_message;
 
+  ParseObserver* observer{arguments.parse_observer()};
+  PhaseStatistics scan, assign;
+  std::chrono::nanoseconds lookup_elapsed{0};
+  std::chrono::steady_clock::time_point start{Now(observer)}, lookup_start;
+  bool is_flag;
+  FileCapture capture{arguments.trace_writer()};
+
   while (std::getline(config_is, line)) {
+    capture.AddLine(line);
     row_num += 1;
+    ++scan.tokens;
+    scan.bytes += line.size();
     line_view = std::string_view{line};
     // Only care about non-empty, non-comment lines.
     if (line_view.length() > 0 && line_view.at(0) != '#') {
 
       end = line_view.find('=');
       parameter_name = line_view.substr(0, end);
+      lookup_start = Now(observer);
+      id = arguments.Parameters().FindId(parameter_name);
+      is_flag = (id >= 0 && arguments.Parameters().layout().IsFlag(id));
+      lookup_elapsed += Now(observer) - lookup_start;
+      ++scan.lookups;
       if (end == std::string_view::npos) {
         error_message << "Invalid configuration file formatting. Non-empty"
                          " lines which don't begin with '#' must contain '='."
                          " Row: '" << row_num << "', line: '" << line << "'.";
         throw exceptions::ArgumentParsingError(error_message.str());
-      } else if (!arguments.Parameters().Contains(parameter_name)) {
+      } else if (id < 0) {
+        std::vector<std::string> suggestions{
+            arguments.Parameters().Suggest(parameter_name)};
         error_message << "Unknown parameter name in configuration file. Row: '"
                       << row_num << "', name: '" << parameter_name << "'.";
-        throw exceptions::ArgumentParsingError(error_message.str());
+        AppendSuggestions(error_message, suggestions, "");
+        throw exceptions::ArgumentParsingError(error_message.str(),
+                                               std::move(suggestions));
       } else if (end + 1 == line_view.length()) {
         error_message << "Empty argument list in configuration file. Row: '"
                       << row_num << "', line: '" << line << "'.";
         throw exceptions::ArgumentParsingError(error_message.str());
       } else {
-        id = arguments.Parameters().GetId(parameter_name);
         begin = end + 1;
         // Flags take only one argument: true or false.
-        if (arguments.Parameters().IsFlag(parameter_name)) {
+        if (is_flag) {
           if (line_view.substr(begin) == "TRUE"
               || line_view.substr(begin) == "true"
               || line_view.substr(begin) == "True"
@@ -363,8 +554,14 @@ std::vector<std::string> ParseFile(std::istream& config_is,
       }
     }
   }
+  scan.elapsed = Now(observer) - start;
+  start = Now(observer);
+  assign.tokens = (observer != nullptr ? NumArguments(tmp_args) : 0);
   AssignArguments(tmp_args, arguments.Parameters(), arguments.arguments_,
                   additional_args);
+  arguments.ResizeValueLists();
+  assign.elapsed = Now(observer) - start;
+  ReportPhases(observer, scan, lookup_elapsed, assign);
   return additional_args;
 }
 
@@ -0,0 +1,206 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "prefix_trie.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace arg_parse_convert {
+
+namespace internal {
+
+namespace {
+
+// Merges integer-identifier `id` into the identifier shared by a set of names.
+//
+std::int32_t MergeId(std::int32_t shared_id, int id) {
+  if (shared_id == PrefixTrie::kNotFound || shared_id == id) {
+    return id;
+  }
+  return PrefixTrie::kAmbiguous;
+}
+
+} // namespace
+
+// PrefixTrie::Match
+//
+int PrefixTrie::Match(std::string_view prefix) const {
+  if (nodes_.empty()) {
+    return kNotFound;
+  }
+  std::int32_t node{0};
+  while (!prefix.empty()) {
+    node = FindChild(node, prefix.front());
+    if (node == kNoNode) {
+      return kNotFound;
+    }
+    std::string_view label{nodes_[node].label};
+    if (prefix.size() < label.size()) {
+      // `prefix` ends inside the edge.
+      return (label.compare(0, prefix.size(), prefix) == 0
+              ? nodes_[node].subtree_id : kNotFound);
+    }
+    if (prefix.compare(0, label.size(), label) != 0) {
+      return kNotFound;
+    }
+    prefix.remove_prefix(label.size());
+  }
+  return (nodes_[node].exact_id != kNotFound ? nodes_[node].exact_id
+                                             : nodes_[node].subtree_id);
+}
+
+// PrefixTrie::Names
+//
+std::vector<std::string> PrefixTrie::Names(std::string_view prefix) const {
+  std::vector<std::string> result;
+  if (nodes_.empty()) {
+    return result;
+  }
+  std::string path;
+  std::int32_t node{0};
+  while (!prefix.empty()) {
+    node = FindChild(node, prefix.front());
+    if (node == kNoNode) {
+      return result;
+    }
+    std::string_view label{nodes_[node].label};
+    std::size_t length{std::min(prefix.size(), label.size())};
+    if (label.compare(0, length, prefix.substr(0, length)) != 0) {
+      return result;
+    }
+    path.append(label);
+    prefix.remove_prefix(length);
+  }
+  if (node == 0) {
+    // Collect the names below the root without its empty label.
+    for (std::int32_t child = nodes_[0].first_child; child != kNoNode;
+         child = nodes_[child].next_sibling) {
+      CollectNames(child, path, result);
+    }
+    return result;
+  }
+  path.erase(path.size() - nodes_[node].label.size());
+  CollectNames(node, path, result);
+  return result;
+}
+
+// PrefixTrie::Reserve
+//
+void PrefixTrie::Reserve(size_type num_names) {
+  // Each name adds at most a leaf and a node splitting an edge.
+  size_type size{(nodes_.empty() ? 1 : nodes_.size()) + 2 * num_names};
+  if (size > nodes_.capacity()) {
+    nodes_.reserve(std::max(size, 2 * nodes_.capacity()));
+  }
+}
+
+// PrefixTrie::Insert
+//
+void PrefixTrie::Insert(std::string_view name, int id) {
+  Reserve(1);
+  if (nodes_.empty()) {
+    nodes_.emplace_back();
+  }
+  std::int32_t node{0};
+  while (true) {
+    nodes_[node].subtree_id = MergeId(nodes_[node].subtree_id, id);
+    if (name.empty()) {
+      assert(nodes_[node].exact_id == kNotFound);
+      nodes_[node].exact_id = id;
+      break;
+    }
+    // Find the child to descend into, and the sibling preceding it.
+    std::int32_t previous{kNoNode}, child{nodes_[node].first_child};
+    while (child != kNoNode
+           && static_cast<unsigned char>(nodes_[child].label.front())
+              < static_cast<unsigned char>(name.front())) {
+      previous = child;
+      child = nodes_[child].next_sibling;
+    }
+    if (child == kNoNode || nodes_[child].label.front() != name.front()) {
+      // Add a leaf in front of `child`.
+      Node leaf;
+      leaf.label = name;
+      leaf.next_sibling = child;
+      leaf.exact_id = id;
+      leaf.subtree_id = id;
+      nodes_.push_back(leaf);
+      std::int32_t new_node{static_cast<std::int32_t>(nodes_.size() - 1)};
+      (previous == kNoNode ? nodes_[node].first_child
+                           : nodes_[previous].next_sibling) = new_node;
+      break;
+    }
+    std::string_view label{nodes_[child].label};
+    std::size_t common{static_cast<std::size_t>(
+        std::mismatch(label.begin(), label.end(), name.begin(),
+                      name.begin() + std::min(label.size(), name.size()))
+            .first - label.begin())};
+    if (common < label.size()) {
+      // Split the edge to `child` after the common characters.
+      Node middle;
+      middle.label = label.substr(0, common);
+      middle.first_child = child;
+      middle.next_sibling = nodes_[child].next_sibling;
+      middle.subtree_id = nodes_[child].subtree_id;
+      nodes_.push_back(middle);
+      std::int32_t new_node{static_cast<std::int32_t>(nodes_.size() - 1)};
+      nodes_[child].label = label.substr(common);
+      nodes_[child].next_sibling = kNoNode;
+      (previous == kNoNode ? nodes_[node].first_child
+                           : nodes_[previous].next_sibling) = new_node;
+      child = new_node;
+    }
+    node = child;
+    name.remove_prefix(common);
+  }
+  ++num_names_;
+}
+
+// PrefixTrie::FindChild
+//
+std::int32_t PrefixTrie::FindChild(std::int32_t node, char c) const {
+  for (std::int32_t child = nodes_[node].first_child; child != kNoNode;
+       child = nodes_[child].next_sibling) {
+    if (nodes_[child].label.front() == c) {
+      return child;
+    }
+  }
+  return kNoNode;
+}
+
+// PrefixTrie::CollectNames
+//
+void PrefixTrie::CollectNames(std::int32_t node, std::string& prefix,
+                              std::vector<std::string>& names) const {
+  prefix.append(nodes_[node].label);
+  if (nodes_[node].exact_id != kNotFound) {
+    names.push_back(prefix);
+  }
+  for (std::int32_t child = nodes_[node].first_child; child != kNoNode;
+       child = nodes_[child].next_sibling) {
+    CollectNames(child, prefix, names);
+  }
+  prefix.erase(prefix.size() - nodes_[node].label.size());
+}
+
+} // namespace internal
+
+} // namespace arg_parse_convert
@@ -0,0 +1,79 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "string_pool.h"
+
+#include <algorithm>
+
+#include "memory_report.h"
+
+namespace arg_parse_convert {
+
+// StringPool::Intern
+//
+std::string_view StringPool::Intern(std::string_view s) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto it = index_.find(s);
+  if (it != index_.end()) {
+    return *it;
+  }
+  // Make room for all allocations first, so that a failing one leaves the
+  // pool unchanged. Containers grow geometrically.
+  if (index_.size() + 1 > index_.bucket_count() * index_.max_load_factor()) {
+    index_.reserve(2 * index_.size() + 1);
+  }
+  if (blocks_.size() == blocks_.capacity()) {
+    blocks_.reserve(2 * blocks_.size() + 1);
+  }
+  char* data;
+  if (s.size() > kBlockSize / 2) {
+    blocks_.emplace_back(new char[s.size()]);
+    block_bytes_ += s.size();
+    data = blocks_.back().get();
+  } else {
+    if (static_cast<std::size_t>(free_end_ - free_begin_) < s.size()) {
+      blocks_.emplace_back(new char[kBlockSize]);
+      block_bytes_ += kBlockSize;
+      free_begin_ = blocks_.back().get();
+      free_end_ = free_begin_ + kBlockSize;
+    }
+    data = free_begin_;
+    free_begin_ += s.size();
+  }
+  std::copy(s.begin(), s.end(), data);
+  return *index_.emplace(data, s.size()).first;
+}
+
+// StringPool::size
+//
+StringPool::size_type StringPool::size() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return index_.size();
+}
+
+// StringPool::HeapSize
+//
+std::size_t StringPool::HeapSize() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return (block_bytes_ + internal::HeapSize(blocks_)
+          + internal::HeapSize(index_));
+}
+
+} // namespace arg_parse_convert
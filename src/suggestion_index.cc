@@ -0,0 +1,255 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "suggestion_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace arg_parse_convert {
+
+namespace internal {
+
+namespace {
+
+// Same as `EditDistance`, using `rows` as scratch space.
+//
+std::size_t EditDistance(std::string_view a, std::string_view b,
+                         std::size_t limit, std::vector<std::size_t>& rows) {
+  if (a.size() < b.size()) {
+    std::swap(a, b);
+  }
+  if (a.size() - b.size() > limit) {
+    return limit + 1;
+  }
+  // Rows of the distance matrix for prefixes of `a` of length i - 2, i - 1
+  // and i, over prefixes of `b`. Only cells within `limit` of the diagonal
+  // can be at most `limit`; each row computes those, and sets the cells
+  // next to them, which the following rows read, to `limit + 1`.
+  if (rows.size() < 3 * (b.size() + 1)) {
+    rows.resize(3 * (b.size() + 1));
+  }
+  std::size_t* before_previous{rows.data()};
+  std::size_t* previous{before_previous + b.size() + 1};
+  std::size_t* current{previous + b.size() + 1};
+  for (std::size_t j = 0; j <= b.size(); ++j) {
+    previous[j] = j;
+  }
+  for (std::size_t i = 1; i <= a.size(); ++i) {
+    std::size_t first{i > limit ? i - limit : 1};
+    std::size_t last{std::min(b.size(), i + limit)};
+    current[first - 1] = (first == 1 ? i : limit + 1);
+    if (last < b.size()) {
+      current[last + 1] = limit + 1;
+    }
+    std::size_t row_minimum{current[first - 1]};
+    for (std::size_t j = first; j <= last; ++j) {
+      std::size_t cost{a[i - 1] == b[j - 1] ? 0u : 1u};
+      current[j] = std::min({previous[j] + 1, current[j - 1] + 1,
+                             previous[j - 1] + cost});
+      if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+        current[j] = std::min(current[j], before_previous[j - 2] + 1);
+      }
+      row_minimum = std::min(row_minimum, current[j]);
+    }
+    if (row_minimum > limit) {
+      return limit + 1;
+    }
+    std::swap(before_previous, previous);
+    std::swap(previous, current);
+  }
+  return std::min(previous[b.size()], limit + 1);
+}
+
+// Hashes of a string and of the strings obtained by deleting one or two of
+// its characters. Uses a polynomial hash, so that each variant's hash is
+// computed in constant time from the hashes of the string's prefixes.
+//
+class VariantHasher {
+ public:
+  // Prepares hashing variants of `s`.
+  //
+  void Assign(std::string_view s) {
+    prefixes_.resize(s.size() + 1);
+    while (powers_.size() < s.size() + 1) {
+      powers_.push_back(powers_.empty() ? 1 : powers_.back() * kBase);
+    }
+    for (std::size_t i = 0; i < s.size(); ++i) {
+      prefixes_[i + 1] = (prefixes_[i] * kBase
+                          + static_cast<unsigned char>(s[i]) + 1);
+    }
+  }
+
+  // Returns the hash of the string without the characters at `first` and
+  // `second`, where `first < second`; either may equal the string's length
+  // to delete fewer characters. Never zero.
+  //
+  std::uint32_t operator()(std::size_t first, std::size_t second) const {
+    std::size_t size{prefixes_.size() - 1};
+    std::uint64_t result{Append(0, 0, first)};
+    if (first < size) {
+      result = Append(result, first + 1, second);
+      if (second < size) {
+        result = Append(result, second + 1, size);
+      }
+    }
+    // Finalize, so that the low bits used to pick entries are well mixed.
+    result ^= result >> 33;
+    result *= 0xff51afd7ed558ccd;
+    result ^= result >> 33;
+    auto folded = static_cast<std::uint32_t>(result ^ (result >> 32));
+    return (folded == 0 ? 1 : folded);
+  }
+
+ private:
+  static constexpr std::uint64_t kBase{0x100000001b3};
+
+  // Returns `hash` extended by the characters in [begin, end).
+  //
+  std::uint64_t Append(std::uint64_t hash, std::size_t begin,
+                       std::size_t end) const {
+    if (begin >= end) {
+      return hash;
+    }
+    std::uint64_t length{powers_[end - begin]};
+    return (hash * length + prefixes_[end] - prefixes_[begin] * length);
+  }
+
+  // Hashes of the string's prefixes by length.
+  //
+  std::vector<std::uint64_t> prefixes_{0};
+
+  // Powers of `kBase`.
+  //
+  std::vector<std::uint64_t> powers_;
+};
+
+} // namespace
+
+// EditDistance
+//
+std::size_t EditDistance(std::string_view a, std::string_view b,
+                         std::size_t limit) {
+  std::vector<std::size_t> rows;
+  return EditDistance(a, b, limit, rows);
+}
+
+// SuggestionIndex::SuggestionIndex
+//
+SuggestionIndex::SuggestionIndex(std::vector<std::string_view> names)
+    : names_{std::move(names)} {
+  size_type num_entries{0};
+  for (std::string_view name : names_) {
+    num_entries += name.size() + 1;
+  }
+  size_type capacity{1};
+  while (4 * num_entries > 3 * capacity) {
+    capacity *= 2;
+  }
+  entries_.resize(capacity);
+  std::vector<std::uint32_t> hashes;
+  VariantHasher variant_hash;
+  for (size_type i = 0; i < names_.size(); ++i) {
+    std::string_view name{names_[i]};
+    variant_hash.Assign(name);
+    hashes.clear();
+    hashes.push_back(variant_hash(name.size(), name.size()));
+    for (size_type j = 0; j < name.size(); ++j) {
+      hashes.push_back(variant_hash(j, name.size()));
+    }
+    // Deleting either of two equal adjacent characters gives the same
+    // variant; index it once.
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    for (std::uint32_t hash : hashes) {
+      Add(Entry{hash, static_cast<std::uint32_t>(i)});
+    }
+  }
+}
+
+// SuggestionIndex::Nearest
+//
+std::vector<std::string> SuggestionIndex::Nearest(std::string_view name,
+    size_type max_suggestions, size_type max_distance) const {
+  assert(max_distance <= 2);
+  VariantHasher variant_hash;
+  variant_hash.Assign(name);
+  std::vector<std::uint32_t> candidates;
+  Find(variant_hash(name.size(), name.size()), candidates);
+  if (max_distance >= 1) {
+    for (size_type i = 0; i < name.size(); ++i) {
+      Find(variant_hash(i, name.size()), candidates);
+      if (max_distance >= 2) {
+        for (size_type j = i + 1; j < name.size(); ++j) {
+          Find(variant_hash(i, j), candidates);
+        }
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  std::vector<std::pair<std::size_t, std::string_view>> matches;
+  std::vector<std::size_t> rows;
+  for (std::uint32_t candidate : candidates) {
+    std::size_t distance{EditDistance(name, names_[candidate], max_distance,
+                                      rows)};
+    if (distance <= max_distance) {
+      matches.emplace_back(distance, names_[candidate]);
+    }
+  }
+  size_type num_suggestions{std::min(max_suggestions, matches.size())};
+  std::partial_sort(matches.begin(), matches.begin() + num_suggestions,
+                    matches.end());
+  std::vector<std::string> result;
+  result.reserve(num_suggestions);
+  for (size_type i = 0; i < num_suggestions; ++i) {
+    result.emplace_back(matches[i].second);
+  }
+  return result;
+}
+
+// SuggestionIndex::Add
+//
+void SuggestionIndex::Add(Entry entry) {
+  size_type mask{entries_.size() - 1};
+  size_type i{entry.hash & mask};
+  while (entries_[i].hash != 0) {
+    i = (i + 1) & mask;
+  }
+  entries_[i] = entry;
+}
+
+// SuggestionIndex::Find
+//
+void SuggestionIndex::Find(std::uint32_t hash,
+                           std::vector<std::uint32_t>& names) const {
+  size_type mask{entries_.size() - 1};
+  for (size_type i = hash & mask; entries_[i].hash != 0; i = (i + 1) & mask) {
+    if (entries_[i].hash == hash) {
+      names.push_back(entries_[i].name);
+    }
+  }
+}
+
+} // namespace internal
+
+} // namespace arg_parse_convert
@@ -0,0 +1,316 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "trace.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "conversion_functions.h"
+#include "parameter.h"
+
+namespace arg_parse_convert {
+
+// Trace helpers.
+//
+namespace {
+
+constexpr char kMagic[4]{'A', 'P', 'C', 'T'};
+constexpr char kVersion{1};
+
+// Number of bytes of a token read at once.
+constexpr std::size_t kReadChunkSize{4096};
+
+// Names of parameter categories in serialized schemas.
+//
+constexpr std::string_view kFlag{"flag"};
+constexpr std::string_view kKeyword{"keyword"};
+constexpr std::string_view kPositional{"positional"};
+
+// Reads the token at `pos` of `tokens` and advances `pos`.
+//
+const std::string& NextToken(const std::vector<std::string>& tokens,
+                             std::size_t& pos) {
+  if (pos >= tokens.size()) {
+    throw exceptions::TraceFormatError("Truncated schema.");
+  }
+  return tokens[pos++];
+}
+
+int NextInt(const std::vector<std::string>& tokens, std::size_t& pos) {
+  const std::string& token{NextToken(tokens, pos)};
+  int value;
+  if (converters::ParseNumber(token, value) != std::errc{}) {
+    throw exceptions::TraceFormatError("Invalid number in schema: '" + token
+                                       + "'.");
+  }
+  return value;
+}
+
+std::vector<std::string> NextList(const std::vector<std::string>& tokens,
+                                  std::size_t& pos) {
+  int size{NextInt(tokens, pos)};
+  if (size < 0 || tokens.size() - pos < static_cast<std::size_t>(size)) {
+    throw exceptions::TraceFormatError("Truncated schema.");
+  }
+  std::vector<std::string> result(tokens.begin() + pos,
+                                  tokens.begin() + pos + size);
+  pos += size;
+  return result;
+}
+
+// Applies the serialized settings shared by all categories to `parameter`.
+//
+template <class ParameterType>
+void Configure(Parameter<ParameterType>& parameter, int min_num_arguments,
+               int max_num_arguments, std::string description,
+               std::string placeholder, std::vector<std::string> defaults) {
+  parameter.MinArgs(min_num_arguments)
+           .MaxArgs(max_num_arguments)
+           .Description(std::move(description))
+           .Placeholder(std::move(placeholder));
+  for (std::string& argument : defaults) {
+    parameter.AddDefault(std::move(argument));
+  }
+}
+
+// Returns `text`, or an empty string if it is returned by a function.
+//
+std::string TextUnlessProvided(const HelpText& text) {
+  return (text.IsProvided() ? std::string{} : text.str());
+}
+
+} // namespace
+
+// TraceWriter::TraceWriter
+//
+TraceWriter::TraceWriter(std::ostream& os) : os_{os} {
+  os_.write(kMagic, sizeof(kMagic));
+  os_.put(kVersion);
+}
+
+// TraceWriter::Write
+//
+void TraceWriter::Write(TraceRecordKind kind,
+                        const std::vector<std::string>& tokens) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  os_.put(static_cast<char>(kind));
+  WriteVarint(tokens.size());
+  for (const std::string& token : tokens) {
+    WriteToken(token);
+  }
+}
+
+// TraceWriter::WriteArguments
+//
+void TraceWriter::WriteArguments(int argc, const char** argv) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  os_.put(static_cast<char>(TraceRecordKind::kArguments));
+  WriteVarint(argc > 0 ? argc : 0);
+  for (int i = 0; i < argc; ++i) {
+    WriteToken(argv[i]);
+  }
+}
+
+// TraceWriter::WriteSchema
+//
+void TraceWriter::WriteSchema(const ParameterMap& parameters) {
+  Write(TraceRecordKind::kSchema, SerializeSchema(parameters));
+}
+
+// TraceWriter::WriteVarint
+//
+void TraceWriter::WriteVarint(std::uint64_t value) {
+  while (value >= 0x80) {
+    os_.put(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  os_.put(static_cast<char>(value));
+}
+
+// TraceWriter::WriteToken
+//
+void TraceWriter::WriteToken(std::string_view token) {
+  WriteVarint(token.size());
+  os_.write(token.data(), token.size());
+}
+
+// TraceReader::TraceReader
+//
+TraceReader::TraceReader(std::istream& is) : is_{is} {
+  char header[sizeof(kMagic) + 1];
+  if (!is_.read(header, sizeof(header))
+      || std::string_view(header, sizeof(kMagic))
+             != std::string_view(kMagic, sizeof(kMagic))) {
+    throw exceptions::TraceFormatError("Missing trace header.");
+  }
+  if (header[sizeof(kMagic)] != kVersion) {
+    throw exceptions::TraceFormatError("Unsupported trace version.");
+  }
+}
+
+// TraceReader::Next
+//
+bool TraceReader::Next(TraceRecord& record) {
+  int kind{is_.get()};
+  if (kind == std::char_traits<char>::eof()) {
+    return false;
+  }
+  if (kind > static_cast<int>(TraceRecordKind::kFile)) {
+    throw exceptions::TraceFormatError("Unknown trace record kind.");
+  }
+  std::uint64_t num_tokens, length;
+  if (!ReadVarint(num_tokens)) {
+    throw exceptions::TraceFormatError("Truncated trace record.");
+  }
+  record.kind = static_cast<TraceRecordKind>(kind);
+  record.tokens.clear();
+  for (std::uint64_t i = 0; i < num_tokens; ++i) {
+    if (!ReadVarint(length)) {
+      throw exceptions::TraceFormatError("Truncated trace record.");
+    }
+    // The length is not trusted, so the token only grows by the bytes
+    // actually read, and a corrupt length fails as a truncated record.
+    std::string& token{record.tokens.emplace_back()};
+    char chunk[kReadChunkSize];
+    while (length > 0) {
+      std::size_t count{static_cast<std::size_t>(
+          std::min<std::uint64_t>(length, sizeof(chunk)))};
+      if (!is_.read(chunk, count)) {
+        throw exceptions::TraceFormatError("Truncated trace record.");
+      }
+      token.append(chunk, count);
+      length -= count;
+    }
+  }
+  return true;
+}
+
+// TraceReader::ReadVarint
+//
+bool TraceReader::ReadVarint(std::uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte{is_.get()};
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// SerializeSchema
+//
+std::vector<std::string> SerializeSchema(const ParameterMap& parameters) {
+  // Arguments following a subcommand's name could not be replayed against
+  // the flattened schema.
+  if (parameters.num_subcommands() > 0) {
+    std::stringstream error_message;
+    error_message << "Unable to capture schema with "
+                  << parameters.num_subcommands() << " subcommand(s): traces"
+                  << " cannot represent subcommands.";
+    throw exceptions::TraceFormatError(error_message.str());
+  }
+  std::vector<std::string> result;
+  for (ParameterMap::size_type id = 0; id < parameters.size(); ++id) {
+    const ParameterConfiguration& configuration{
+        parameters.GetConfiguration(id)};
+    switch (configuration.category()) {
+      case ParameterCategory::kFlag: {
+        result.emplace_back(kFlag);
+        break;
+      }
+      case ParameterCategory::kKeywordParameter: {
+        result.emplace_back(kKeyword);
+        break;
+      }
+      default: {
+        result.emplace_back(kPositional);
+      }
+    }
+    result.push_back(std::to_string(configuration.position()));
+    result.push_back(std::to_string(configuration.min_num_arguments()));
+    result.push_back(std::to_string(configuration.max_num_arguments()));
+    // Provided text is left out, so that capturing calls no provider.
+    result.push_back(TextUnlessProvided(configuration.description_text()));
+    result.push_back(TextUnlessProvided(configuration.placeholder_text()));
+    result.push_back(std::to_string(configuration.names().size()));
+    result.insert(result.end(), configuration.names().begin(),
+                  configuration.names().end());
+    result.push_back(std::to_string(
+        configuration.default_arguments().size()));
+    result.insert(result.end(), configuration.default_arguments().begin(),
+                  configuration.default_arguments().end());
+  }
+  return result;
+}
+
+// DeserializeSchema
+//
+ParameterMap DeserializeSchema(const std::vector<std::string>& tokens) {
+  ParameterMap result;
+  std::size_t pos{0};
+  while (pos < tokens.size()) {
+    std::string category{NextToken(tokens, pos)};
+    int position{NextInt(tokens, pos)};
+    int min_num_arguments{NextInt(tokens, pos)};
+    int max_num_arguments{NextInt(tokens, pos)};
+    std::string description{NextToken(tokens, pos)};
+    std::string placeholder{NextToken(tokens, pos)};
+    std::vector<std::string> names{NextList(tokens, pos)};
+    std::vector<std::string> defaults{NextList(tokens, pos)};
+    try {
+      if (category == kFlag) {
+        result(Parameter<bool>::Flag(std::move(names))
+                   .Description(std::move(description)));
+      } else if (category == kKeyword) {
+        Parameter<std::string> parameter{Parameter<std::string>::Keyword<
+            converters::StringIdentity>(std::move(names))};
+        Configure(parameter, min_num_arguments, max_num_arguments,
+                  std::move(description), std::move(placeholder),
+                  std::move(defaults));
+        result(std::move(parameter));
+      } else if (category == kPositional) {
+        Parameter<std::string> parameter{Parameter<std::string>::Positional<
+            converters::StringIdentity>(names.empty() ? "" : names.front(),
+                                        position)};
+        Configure(parameter, min_num_arguments, max_num_arguments,
+                  std::move(description), std::move(placeholder),
+                  std::move(defaults));
+        result(std::move(parameter));
+      } else {
+        throw exceptions::TraceFormatError("Unknown parameter category in"
+                                           " schema: '" + category + "'.");
+      }
+    } catch (const exceptions::TraceFormatError&) {
+      throw;
+    } catch (const exceptions::BaseError& e) {
+      throw exceptions::TraceFormatError(std::string{"Invalid parameter in"
+                                                     " schema: "} + e.what());
+    }
+  }
+  return result;
+}
+
+} // namespace arg_parse_convert
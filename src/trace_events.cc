@@ -0,0 +1,209 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "trace_events.h"
+
+#include "parameter_map.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace arg_parse_convert {
+
+namespace {
+
+// Buffers of all threads which recorded events, kept after the threads exit
+// so their events can still be flushed, and the buffers of exited threads.
+//
+struct BufferRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<internal::TraceEventBuffer>> buffers;
+  std::vector<internal::TraceEventBuffer*> free_buffers;
+};
+
+BufferRegistry& Registry() {
+  static BufferRegistry registry;
+  return registry;
+}
+
+// Buffer of a thread, which is returned to the registry when the thread
+// exits.
+//
+struct ThreadBuffer {
+  ~ThreadBuffer() {
+    if (buffer != nullptr) {
+      BufferRegistry& registry{Registry()};
+      std::lock_guard<std::mutex> lock{registry.mutex};
+      registry.free_buffers.push_back(buffer);
+    }
+  }
+
+  internal::TraceEventBuffer* buffer{nullptr};
+};
+
+// Writes `s` as a JSON string.
+//
+void WriteJsonString(std::ostream& os, const char* s) {
+  os << '"';
+  for (; *s != '\0'; ++s) {
+    if (*s == '"' || *s == '\\') {
+      os << '\\' << *s;
+    } else if (static_cast<unsigned char>(*s) < 0x20) {
+      os << ' ';
+    } else {
+      os << *s;
+    }
+  }
+  os << '"';
+}
+
+} // namespace
+
+namespace internal {
+
+// TraceEventBuffer::Record
+//
+void TraceEventBuffer::Record(const char* name, const std::string* detail,
+                              std::chrono::steady_clock::time_point start,
+                              std::chrono::steady_clock::time_point end) {
+  std::uint64_t index{head_.load(std::memory_order_relaxed)};
+  Slot& slot{slots_[index % kCapacity]};
+  char characters[kMaxDetailLength + 1]{};
+  if (detail != nullptr) {
+    std::memcpy(characters, detail->data(),
+                std::min(detail->size(), kMaxDetailLength));
+  }
+  std::uint64_t words[(kMaxDetailLength + 1) / 8];
+  std::memcpy(words, characters, sizeof(words));
+
+  // Readers skip the slot until its sequence number is published again.
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      start.time_since_epoch()).count(), std::memory_order_relaxed);
+  slot.duration.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start).count(), std::memory_order_relaxed);
+  for (std::size_t i = 0; i < slot.detail.size(); ++i) {
+    slot.detail[i].store(words[i], std::memory_order_relaxed);
+  }
+  slot.sequence.store(index + 1, std::memory_order_release);
+  head_.store(index + 1, std::memory_order_release);
+}
+
+// TraceEventBuffer::Drain
+//
+std::uint64_t TraceEventBuffer::Drain(std::ostream& os, bool* first) {
+  std::uint64_t head{head_.load(std::memory_order_acquire)};
+  std::uint64_t begin{std::max(tail_, head > kCapacity ? head - kCapacity
+                                                       : std::uint64_t{0})};
+  std::uint64_t dropped{begin - tail_};
+  tail_ = head;
+  for (std::uint64_t index = begin; index < head; ++index) {
+    const Slot& slot{slots_[index % kCapacity]};
+    std::uint64_t sequence{slot.sequence.load(std::memory_order_acquire)};
+    const char* name{slot.name.load(std::memory_order_relaxed)};
+    std::int64_t start{slot.start.load(std::memory_order_relaxed)};
+    std::int64_t duration{slot.duration.load(std::memory_order_relaxed)};
+    std::uint64_t words[(kMaxDetailLength + 1) / 8];
+    for (std::size_t i = 0; i < slot.detail.size(); ++i) {
+      words[i] = slot.detail[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence != index + 1
+        || slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      // Overwritten by the owning thread meanwhile.
+      ++dropped;
+      continue;
+    }
+    char detail[kMaxDetailLength + 1];
+    std::memcpy(detail, words, sizeof(words));
+    detail[kMaxDetailLength] = '\0';
+
+    os << (*first ? "\n    " : ",\n    ") << "{\"name\": ";
+    WriteJsonString(os, name);
+    os << ", \"cat\": \"arg_parse_convert\", \"ph\": \"X\", \"pid\": 1"
+       << ", \"tid\": " << thread_id_ << ", \"ts\": " << start / 1000 << '.'
+       << std::to_string(1000 + start % 1000).substr(1)
+       << ", \"dur\": " << duration / 1000 << '.'
+       << std::to_string(1000 + duration % 1000).substr(1);
+    if (detail[0] != '\0') {
+      os << ", \"args\": {\"detail\": ";
+      WriteJsonString(os, detail);
+      os << '}';
+    }
+    os << '}';
+    *first = false;
+  }
+  return dropped;
+}
+
+// ThreadTraceEventBuffer
+//
+TraceEventBuffer& ThreadTraceEventBuffer() {
+  thread_local ThreadBuffer thread_buffer;
+  if (thread_buffer.buffer == nullptr) {
+    BufferRegistry& registry{Registry()};
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    if (!registry.free_buffers.empty()) {
+      thread_buffer.buffer = registry.free_buffers.back();
+      registry.free_buffers.pop_back();
+    } else {
+      // Room for every buffer, so returning one when its thread exits does
+      // not allocate.
+      registry.free_buffers.reserve(registry.buffers.size() + 1);
+      registry.buffers.push_back(std::make_unique<TraceEventBuffer>(
+          static_cast<int>(registry.buffers.size()) + 1));
+      thread_buffer.buffer = registry.buffers.back().get();
+    }
+  }
+  return *thread_buffer.buffer;
+}
+
+// TraceEventDetail
+//
+const std::string* TraceEventDetail(const ParameterMap& parameters, int id) {
+  return &parameters.GetPrimaryName(id);
+}
+
+} // namespace internal
+
+// FlushTraceEvents
+//
+void FlushTraceEvents(std::ostream& os) {
+  std::uint64_t dropped{0};
+  bool first{true};
+  os << "{\n  \"traceEvents\": [";
+  if (kTraceEventsEnabled) {
+    BufferRegistry& registry{Registry()};
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    for (const std::unique_ptr<internal::TraceEventBuffer>& buffer
+         : registry.buffers) {
+      dropped += buffer->Drain(os, &first);
+    }
+  }
+  os << "\n  ],\n  \"displayTimeUnit\": \"ns\",\n  \"otherData\": "
+     << "{\"dropped_events\": " << dropped << "}\n}\n";
+}
+
+} // namespace arg_parse_convert
@@ -0,0 +1,145 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ARG_PARSE_CONVERT_TEST_ALLOCATION_COUNTER_H_
+#define ARG_PARSE_CONVERT_TEST_ALLOCATION_COUNTER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions with ones that count allocations.
+// Include in exactly one translation unit of a test executable.
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace internal {
+
+// Allocation statistics since program start.
+//
+inline std::atomic<std::size_t> num_allocations{0};
+inline std::atomic<std::size_t> allocated_bytes{0};
+inline std::atomic<std::size_t> live_bytes{0};
+
+// Each allocation is preceded by a header storing its size.
+//
+constexpr std::size_t kHeaderSize{alignof(std::max_align_t)};
+
+inline void* Allocate(std::size_t size) {
+  void* block{std::malloc(size + kHeaderSize)};
+  if (block == nullptr) {
+    throw std::bad_alloc{};
+  }
+  *static_cast<std::size_t*>(block) = size;
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  live_bytes.fetch_add(size, std::memory_order_relaxed);
+  return static_cast<char*>(block) + kHeaderSize;
+}
+
+inline void Deallocate(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  void* block{static_cast<char*>(pointer) - kHeaderSize};
+  live_bytes.fetch_sub(*static_cast<std::size_t*>(block),
+                       std::memory_order_relaxed);
+  std::free(block);
+}
+
+} // namespace internal
+
+/// @brief Counts allocations made through the global `operator new` since
+///  construction of the object, by all threads.
+///
+class AllocationCounter {
+ public:
+  AllocationCounter()
+      : num_allocations_{internal::num_allocations.load()},
+        allocated_bytes_{internal::allocated_bytes.load()},
+        live_bytes_{internal::live_bytes.load()} {}
+
+  /// @brief Number of allocations.
+  ///
+  std::size_t allocations() const {
+    return internal::num_allocations.load() - num_allocations_;
+  }
+
+  /// @brief Number of bytes allocated.
+  ///
+  std::size_t bytes() const {
+    return internal::allocated_bytes.load() - allocated_bytes_;
+  }
+
+  /// @brief Number of bytes allocated and not freed yet, minus the number of
+  ///  bytes freed that were allocated before construction.
+  ///
+  long long live_bytes() const {
+    return (static_cast<long long>(internal::live_bytes.load())
+            - static_cast<long long>(live_bytes_));
+  }
+
+ private:
+  std::size_t num_allocations_;
+  std::size_t allocated_bytes_;
+  std::size_t live_bytes_;
+};
+
+/// @brief Returns the number of allocations made by evaluating `function`.
+///
+template <class Function>
+std::size_t CountAllocations(Function&& function) {
+  AllocationCounter counter;
+  function();
+  return counter.allocations();
+}
+
+} // namespace test
+
+} // namespace arg_parse_convert
+
+void* operator new(std::size_t size) {
+  return arg_parse_convert::test::internal::Allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return arg_parse_convert::test::internal::Allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  arg_parse_convert::test::internal::Deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  arg_parse_convert::test::internal::Deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  arg_parse_convert::test::internal::Deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  arg_parse_convert::test::internal::Deallocate(pointer);
+}
+
+#endif // ARG_PARSE_CONVERT_TEST_ALLOCATION_COUNTER_H_
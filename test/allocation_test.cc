@@ -0,0 +1,205 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "argument_map.h"
+#include "parameter_map.h"
+#include "parsers.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include "allocation_counter.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Test allocation budgets for:
+// * ParameterMap::Contains
+// * ParameterMap::IsFlag
+// * ParameterMap::IsKeyword
+// * ParameterMap::GetId
+// * ParameterMap::GetPrimaryName
+// * ParameterMap::GetConfiguration
+// * ParameterMap::ConversionFunction
+// * ParameterMap::ValueConversionFunction
+// * ArgumentMap::ArgumentsOf
+// * ArgumentMap::IsSet
+// * ArgumentMap::GetValue
+// * ArgumentMap::GetAllValues
+// * ArgumentMap::GetAllValuesInto
+// * ArgumentMap::ConvertAll
+// * ParseArgs
+// * ParseFile
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+// Long enough to exceed the small string buffer of common implementations.
+//
+constexpr char kLongName[]{"a_parameter_name_longer_than_small_strings"};
+
+ParameterMap MakeParameterMap() {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<bool>::Flag({"v", "verbose"}))
+               (Parameter<int>::Keyword(converters::stoi, {"n", kLongName})
+                    .MaxArgs(1))
+               (Parameter<int>::Keyword<converters::FromChars<int>>(
+                    {"static"}).AddDefault("7"))
+               (Parameter<std::string>::Positional(
+                    converters::StringIdentity, "files", 0).MaxArgs(0));
+  return parameter_map;
+}
+
+SCENARIO("Test allocations of ParameterMap lookups.",
+         "[ParameterMap][allocations]") {
+
+  GIVEN("A ParameterMap object.") {
+    ParameterMap parameter_map{MakeParameterMap()};
+    const std::string name{kLongName};
+    const std::string unknown{"an_unknown_parameter_name_of_some_length"};
+    int id{parameter_map.GetId(name)};
+
+    THEN("Lookups by name and id do not allocate.") {
+      CHECK(CountAllocations([&] {
+        parameter_map.Contains(name);
+        parameter_map.Contains(unknown);
+        parameter_map.IsFlag(name);
+        parameter_map.IsKeyword(name);
+        parameter_map.IsFlag(unknown);
+        parameter_map.GetId(name);
+        parameter_map.GetPrimaryName(id);
+        parameter_map.GetConfiguration(name);
+        parameter_map.GetConfiguration(id);
+        parameter_map.ConversionFunction<int>(name);
+        parameter_map.ConversionFunction<int>(id);
+        parameter_map.ValueConversionFunction(id);
+      }) == 0);
+    }
+  }
+}
+
+SCENARIO("Test allocations of ArgumentMap value access.",
+         "[ArgumentMap][allocations]") {
+
+  GIVEN("An ArgumentMap object with parsed arguments.") {
+    ArgumentMap argument_map{MakeParameterMap()};
+    const char* argv[]{"command", "-v", "-n", "42", "first_file_of_some_length",
+                       "second_file_of_some_length"};
+    ParseArgs(6, argv, argument_map);
+    argument_map.SetDefaultArguments();
+    const std::string verbose{"verbose"}, name{kLongName}, files{"files"};
+    int id{argument_map.Parameters().GetId(name)};
+
+    WHEN("A value is computed for the first time.") {
+      THEN("Values stored in place do not allocate.") {
+        CHECK(CountAllocations([&] {
+          argument_map.GetValue<int>(name);
+          argument_map.GetValue<int>("static");
+        }) == 0);
+      }
+    }
+
+    WHEN("Values were computed before.") {
+      argument_map.ConvertAll();
+
+      THEN("Accessing them does not allocate.") {
+        int values[1];
+        std::vector<int> value_list;
+        value_list.reserve(1);
+        CHECK(CountAllocations([&] {argument_map.ArgumentsOf(name);}) == 0);
+        CHECK(CountAllocations([&] {argument_map.IsSet(verbose);}) == 0);
+        CHECK(CountAllocations([&] {argument_map.IsSet("v");}) == 0);
+        CHECK(CountAllocations([&] {argument_map.GetValue<int>(name);}) == 0);
+        CHECK(CountAllocations([&] {argument_map.GetValue<int>(id);}) == 0);
+        CHECK(CountAllocations([&] {
+          argument_map.GetValue<int>("static");
+        }) == 0);
+        CHECK(CountAllocations([&] {
+          argument_map.GetAllValuesInto(name, values, 1);
+        }) == 0);
+        CHECK(CountAllocations([&] {
+          argument_map.GetAllValuesInto(name, value_list);
+        }) == 0);
+        CHECK(CountAllocations([&] {argument_map.ConvertAll();}) == 0);
+      }
+
+      THEN("Copying values allocates only for the copies.") {
+        CHECK(CountAllocations([&] {
+          argument_map.GetValue<std::string>(files);
+        }) == 1);
+        CHECK(CountAllocations([&] {
+          argument_map.GetAllValues<int>(name);
+        }) == 1);
+        CHECK(CountAllocations([&] {
+          argument_map.GetAllValues<std::string>(files);
+        }) == 3);
+      }
+    }
+  }
+}
+
+SCENARIO("Test allocations of parsers.", "[parsers][allocations]") {
+
+  GIVEN("An ArgumentMap object and many arguments.") {
+    ArgumentMap argument_map{MakeParameterMap()};
+    std::vector<std::string> arguments{"command", "-v", "-n", "42"};
+    for (int i = 0; i < 1000; ++i) {
+      arguments.push_back("file_" + std::to_string(i));
+    }
+    std::vector<const char*> argv;
+    for (const std::string& argument : arguments) {
+      argv.push_back(argument.c_str());
+    }
+
+    WHEN("They are parsed by ParseArgs.") {
+      AllocationCounter counter;
+      ParseArgs(argv.size(), argv.data(), argument_map);
+
+      THEN("Allocations do not grow with each argument.") {
+        CHECK(counter.allocations() < 100);
+      }
+    }
+
+    WHEN("They are parsed by ParseFile.") {
+      std::string file{"verbose=true\nn=42\nfiles="};
+      for (std::size_t i = 4; i < arguments.size(); ++i) {
+        file.append(arguments[i]).push_back(' ');
+      }
+      std::istringstream iss{file};
+      AllocationCounter counter;
+      ParseFile(iss, argument_map);
+
+      THEN("Allocations do not grow with each argument.") {
+        CHECK(counter.allocations() < 100);
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
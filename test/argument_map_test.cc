@@ -20,6 +20,9 @@
 
 #include "argument_map.h"
 
+#include <atomic>
+#include <thread>
+
 #define CATCH_CONFIG_MAIN
 #define CATCH_CONFIG_COLOUR_NONE
 #include "catch.h"
@@ -28,6 +31,7 @@
 
 // Test correctness for:
 // * ArgumentMap(ParameterMap)
+// * ArgumentMap(std::shared_ptr<const ParameterMap>)
 // * SetDefaultArguments
 // * AddArgument
 // * GetUnfilledParameters
@@ -36,17 +40,24 @@
 // * GetValue
 // * GetAllValues
 // * IsSet
+// * ConvertAll
+// * GetValue, GetAllValues, and ConvertAll from concurrent threads
+// * ValuesSnapshot and copies after concurrent conversions
+// * GetValue and GetAllValues with delimited list conversion functions
 //
 // Test invariants for:
 // * ArgumentMap(ParameterMap)
 // 
 // Test exceptions for:
+// * ArgumentMap(std::shared_ptr<const ParameterMap>)
 // * AddArgument
 // * HasArgument
 // * ArgumentsOf
 // * GetValue
 // * GetAllValues
+// * GetAllValuesInto
 // * IsSet
+// * ConvertAll
 
 namespace arg_parse_convert {
 
@@ -218,6 +229,57 @@ SCENARIO("Test invariant preservation by"
   }
 }
 
+SCENARIO("Test correctness of"
+         " ArgumentMap::ArgumentMap(std::shared_ptr<const ParameterMap>).",
+         "[ArgumentMap][ArgumentMap(std::shared_ptr<const ParameterMap>)]"
+         "[correctness]") {
+
+  GIVEN("A shared `ParameterMap` object containing various parameters.") {
+    ParameterMap parameter_map;
+    parameter_map(kNoMinNoMaxNoArgs)(kYesMinYesMaxMinArgs)(kSetFlag)
+                 (kNoConverterPositional);
+    auto shared = std::make_shared<const ParameterMap>(
+        std::move(parameter_map));
+
+    WHEN("Multiple objects are constructed from and copied with it.") {
+      ArgumentMap first(shared), second(shared);
+      first.AddArgument("kNoMinNoMaxNoArgs", "1");
+      ArgumentMap copy{first};
+      copy.AddArgument("kNoMinNoMaxNoArgs", "2");
+
+      THEN("All objects share the parameters.") {
+        CHECK(&first.Parameters() == shared.get());
+        CHECK(&second.Parameters() == shared.get());
+        CHECK(&copy.Parameters() == shared.get());
+        CHECK(first.SharedParameters() == shared);
+        CHECK(shared.use_count() == 4);
+      }
+
+      THEN("Arguments are not shared.") {
+        CHECK(first.ArgumentsOf("kNoMinNoMaxNoArgs")
+              == std::vector<std::string>{"1"});
+        CHECK(second.ArgumentsOf("kNoMinNoMaxNoArgs").empty());
+        CHECK(copy.ArgumentsOf("kNoMinNoMaxNoArgs")
+              == std::vector<std::string>{"1", "2"});
+        CHECK(copy.GetAllValues<std::string>("kNoMinNoMaxNoArgs")
+              == std::vector<std::string>{"1", "2"});
+        CHECK(second.size() == shared->size());
+      }
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by"
+         " ArgumentMap::ArgumentMap(std::shared_ptr<const ParameterMap>).",
+         "[ArgumentMap][ArgumentMap(std::shared_ptr<const ParameterMap>)]"
+         "[exceptions]") {
+
+  THEN("Constructing from a null pointer causes exception.") {
+    CHECK_THROWS_AS(ArgumentMap(std::shared_ptr<const ParameterMap>{}),
+                    exceptions::ParameterAccessError);
+  }
+}
+
 SCENARIO("Test correctness of ArgumentMap::SetDefaultArguments.",
          "[ArgumentMap][SetDefaultArguments][correctness]") {
 
@@ -2401,6 +2463,402 @@ SCENARIO("Test exceptions thrown by ArgumentMap::IsSet.",
   }
 }
 
+SCENARIO("Test correctness of ArgumentMap::ConvertAll.",
+         "[ArgumentMap][ConvertAll][correctness]") {
+
+  GIVEN("An `ArgumentMap` object with long argument lists.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional(converters::stoi, "ints", 0))
+                 (Parameter<double>::Keyword(converters::stod, {"doubles"}))
+                 (Parameter<std::string>::Keyword(converters::StringIdentity,
+                                                  {"strings"}))
+                 (kSetFlag)(kNoConverterKeyword);
+    ArgumentMap argument_map(std::move(parameter_map));
+    int size = GENERATE(0, 1, 7, 1000);
+    for (int i = 0; i < size; ++i) {
+      argument_map.AddArgument("ints", std::to_string(i));
+      argument_map.AddArgument("doubles", std::to_string(i) + ".5");
+      argument_map.AddArgument("strings", "s" + std::to_string(i));
+    }
+    argument_map.AddArgument("kSetFlag", "kSetFlag");
+    argument_map.AddArgument("kNoConverterKeyword", "1");
+
+    WHEN("All values are converted on the calling thread.") {
+      argument_map.ConvertAll();
+
+      THEN("All values are stored.") {
+        CHECK(static_cast<int>(argument_map.Values().at(0).size()) == size);
+        CHECK(static_cast<int>(argument_map.Values().at(1).size()) == size);
+        CHECK(static_cast<int>(argument_map.Values().at(2).size()) == size);
+        for (int i = 0; i < size; ++i) {
+          CHECK(argument_map.GetValue<int>("ints", i) == i);
+          CHECK(argument_map.GetValue<double>("doubles", i) == i + 0.5);
+          CHECK(argument_map.GetValue<std::string>("strings", i)
+                == "s" + std::to_string(i));
+        }
+      }
+
+      THEN("Flags and parameters without conversion function are skipped.") {
+        CHECK(argument_map.Values().at(3).empty());
+        CHECK(argument_map.Values().at(4).empty());
+      }
+    }
+
+    WHEN("All values are converted by multiple threads in small chunks.") {
+      std::vector<std::thread> threads;
+      argument_map.ConvertAll([&threads](std::function<void()> task) {
+        threads.emplace_back(std::move(task));
+      }, 16);
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+
+      THEN("All values are stored.") {
+        CHECK(static_cast<int>(argument_map.GetAllValues<int>("ints").size())
+              == size);
+        for (int i = 0; i < size; ++i) {
+          CHECK(std::any_cast<int>(argument_map.Values().at(0).at(i)) == i);
+          CHECK(std::any_cast<double>(argument_map.Values().at(1).at(i))
+                == i + 0.5);
+          CHECK(std::any_cast<std::string>(argument_map.Values().at(2).at(i))
+                == "s" + std::to_string(i));
+        }
+      }
+    }
+
+    WHEN("Some values were computed before.") {
+      if (size > 0) {
+        argument_map.GetValue<int>("ints", size - 1);
+      }
+      argument_map.ConvertAll();
+
+      THEN("All values are stored.") {
+        CHECK(static_cast<int>(argument_map.Values().at(0).size()) == size);
+        CHECK(static_cast<int>(argument_map.GetAllValues<int>("ints").size())
+              == size);
+      }
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by ArgumentMap::ConvertAll.",
+         "[ArgumentMap][ConvertAll][exceptions]") {
+
+  GIVEN("An `ArgumentMap` object with some invalid arguments.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional(converters::stoi, "ints", 0))
+                 (Parameter<long>::Keyword(converters::stol, {"longs"}));
+    ArgumentMap argument_map(std::move(parameter_map));
+    argument_map.AddArgument("ints", "1");
+    argument_map.AddArgument("ints", "one");
+    argument_map.AddArgument("ints", "3");
+    argument_map.AddArgument("longs", "four");
+
+    WHEN("All values are converted.") {
+
+      THEN("All failures are reported and all other values stored.") {
+        try {
+          argument_map.ConvertAll();
+          FAIL("Expected `exceptions::ValueConversionError`.");
+        } catch (const exceptions::ValueConversionError& e) {
+          std::string message{e.what()};
+          CHECK(message.find("2 argument(s)") != std::string::npos);
+          CHECK(message.find("'one'") != std::string::npos);
+          CHECK(message.find("'four'") != std::string::npos);
+        }
+        CHECK(argument_map.Values().at(0).at(0).has_value());
+        CHECK_FALSE(argument_map.Values().at(0).at(1).has_value());
+        CHECK(argument_map.Values().at(0).at(2).has_value());
+        CHECK(argument_map.GetValue<int>("ints", 2) == 3);
+        CHECK_THROWS_AS(argument_map.GetValue<int>("ints", 1),
+                        std::invalid_argument);
+      }
+    }
+
+    WHEN("The chunk size is 0.") {
+
+      THEN("An exception is thrown.") {
+        CHECK_THROWS_AS(argument_map.ConvertAll(
+                            [](std::function<void()> task) {task();}, 0),
+                        exceptions::ValueAccessError);
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of concurrent value access.",
+         "[ArgumentMap][GetValue][GetAllValues][ConvertAll][concurrency]") {
+
+  GIVEN("An `ArgumentMap` object whose converter counts its evaluations.") {
+    static std::atomic<int> num_conversions;
+    num_conversions = 0;
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional([](const std::string& s) {
+                    num_conversions.fetch_add(1);
+                    return std::stoi(s);
+                  }, "ints", 0));
+    ArgumentMap argument_map(std::move(parameter_map));
+    for (int i = 0; i < 512; ++i) {
+      argument_map.AddArgument("ints", std::to_string(i));
+    }
+    const ArgumentMap& const_map{argument_map};
+
+    WHEN("Many threads read all values at the same time.") {
+      std::vector<std::thread> threads;
+      std::atomic<int> num_mismatches{0};
+      for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&const_map, &num_mismatches, t] {
+          if (t % 2 == 0) {
+            for (int i = 0; i < 512; ++i) {
+              if (const_map.GetValue<int>("ints", i) != i) {
+                num_mismatches.fetch_add(1);
+              }
+            }
+          } else if (t == 1) {
+            const_map.ConvertAll();
+          } else {
+            std::vector<int> values{const_map.GetAllValues<int>("ints")};
+            for (int i = 0; i < 512; ++i) {
+              if (values.at(i) != i) {
+                num_mismatches.fetch_add(1);
+              }
+            }
+          }
+        });
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+
+      THEN("Each value is computed exactly once and read correctly.") {
+        CHECK(num_mismatches == 0);
+        CHECK(num_conversions == 512);
+      }
+
+      THEN("Snapshots and copies hold the computed values.") {
+        std::vector<std::vector<std::any>> snapshot{
+            const_map.ValuesSnapshot()};
+        ArgumentMap copy{const_map};
+        REQUIRE(snapshot.at(0).size() == 512);
+        REQUIRE(copy.Values().at(0).size() == 512);
+        for (int i = 0; i < 512; ++i) {
+          CHECK(std::any_cast<int>(snapshot.at(0).at(i)) == i);
+          CHECK(std::any_cast<int>(copy.Values().at(0).at(i)) == i);
+        }
+        CHECK(copy.GetValue<int>("ints", 7) == 7);
+        CHECK(num_conversions == 512);
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ArgumentMap::GetAllValuesInto.",
+         "[ArgumentMap][GetAllValuesInto][correctness]") {
+
+  GIVEN("An `ArgumentMap` object with a long argument list.") {
+    ParameterMap parameter_map;
+    parameter_map(kSetFlag)
+                 (Parameter<int>::Keyword(converters::stoi, {"ints", "i"}));
+    ArgumentMap argument_map(std::move(parameter_map));
+    int size = GENERATE(0, 1, 100);
+    for (int i = 0; i < size; ++i) {
+      argument_map.AddArgument("ints", std::to_string(i));
+    }
+    int id{argument_map.Parameters().GetId("ints")};
+    std::vector<int> expected;
+    for (int i = 0; i < size; ++i) {
+      expected.push_back(i);
+    }
+
+    WHEN("Values are written to an array.") {
+      std::vector<int> out(size + 2, -1);
+      ArgumentMap::size_type num_values{argument_map.GetAllValuesInto(
+          "i", out.data(), out.size())};
+
+      THEN("Values fill the beginning of the array.") {
+        CHECK(static_cast<int>(num_values) == size);
+        CHECK(std::vector<int>(out.begin(), out.begin() + size) == expected);
+        CHECK(out.at(size) == -1);
+        CHECK(out.at(size + 1) == -1);
+      }
+    }
+
+    WHEN("Values are appended to a vector.") {
+      std::vector<int> out{-1};
+      argument_map.GetAllValuesInto("ints", out);
+      argument_map.GetAllValuesInto(id, out);
+
+      THEN("Values follow the vector's previous content.") {
+        CHECK(static_cast<int>(out.size()) == 2 * size + 1);
+        CHECK(out.at(0) == -1);
+        CHECK(std::vector<int>(out.begin() + 1, out.begin() + 1 + size)
+              == expected);
+        CHECK(std::vector<int>(out.begin() + 1 + size, out.end())
+              == expected);
+      }
+
+      THEN("Values are cached and match the other accessors.") {
+        CHECK(argument_map.GetAllValues<int>("ints") == expected);
+        CHECK(argument_map.GetAllValues<int>(id) == expected);
+        for (int i = 0; i < size; ++i) {
+          CHECK(argument_map.Values().at(id).at(i).has_value());
+          CHECK(argument_map.GetValue<int>(id, i) == i);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by ArgumentMap::GetAllValuesInto.",
+         "[ArgumentMap][GetAllValuesInto][exceptions]") {
+
+  GIVEN("An `ArgumentMap` object with various parameters.") {
+    ParameterMap parameter_map;
+    parameter_map(kSetFlag)(kNoConverterKeyword)
+                 (Parameter<int>::Keyword(converters::stoi, {"ints"}));
+    ArgumentMap argument_map(std::move(parameter_map));
+    argument_map.AddArgument("kSetFlag", "kSetFlag");
+    argument_map.AddArgument("kNoConverterKeyword", "1");
+    argument_map.AddArgument("ints", "1");
+    argument_map.AddArgument("ints", "two");
+    std::vector<int> out{-1};
+    int array[2];
+
+    THEN("Invalid requests cause exceptions.") {
+      CHECK_THROWS_AS(argument_map.GetAllValuesInto("unknown", out),
+                      exceptions::ParameterAccessError);
+      CHECK_THROWS_AS(argument_map.GetAllValuesInto(ArgumentMap::size_type{3},
+                                                    out),
+                      exceptions::ParameterAccessError);
+      CHECK_THROWS_AS(argument_map.GetAllValuesInto<long>("ints", nullptr, 0),
+                      exceptions::ParameterAccessError);
+      CHECK_THROWS_AS(argument_map.GetAllValuesInto<bool>("kSetFlag",
+                                                          nullptr, 0),
+                      exceptions::ValueAccessError);
+      CHECK_THROWS_AS(argument_map.GetAllValuesInto<TestType>(
+                          "kNoConverterKeyword", nullptr, 0),
+                      exceptions::ValueAccessError);
+      CHECK_THROWS_AS(argument_map.GetAllValuesInto("ints", array, 1),
+                      exceptions::ValueAccessError);
+    }
+
+    THEN("A failed conversion leaves the vector unchanged.") {
+      CHECK_THROWS_AS(argument_map.GetAllValuesInto("ints", out),
+                      std::invalid_argument);
+      CHECK(out == std::vector<int>{-1});
+    }
+  }
+}
+
+SCENARIO("Test correctness of value access with compile-time conversion"
+         " functions.",
+         "[ArgumentMap][GetValue][GetAllValues][ConvertAll][correctness]") {
+
+  GIVEN("Parameters with conversion functions bound at compile time.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional<converters::FromChars<int>>(
+                      "ints", 0))
+                 (Parameter<double>::Keyword<converters::stod>({"doubles"}));
+    ArgumentMap argument_map(std::move(parameter_map));
+    argument_map.AddArgument("ints", "0x1f");
+    argument_map.AddArgument("ints", "-3");
+    argument_map.AddArgument("doubles", "2.5");
+
+    WHEN("Values are converted.") {
+      argument_map.ConvertAll();
+
+      THEN("The bound conversion functions are used.") {
+        CHECK(argument_map.GetAllValues<int>("ints")
+              == std::vector<int>{31, -3});
+        CHECK(argument_map.GetValue<double>("doubles") == 2.5);
+        CHECK_THROWS_AS(argument_map.GetValue<long>("ints"),
+                        exceptions::ParameterAccessError);
+      }
+    }
+
+    WHEN("Values are read with the bound conversion functions.") {
+      int ints_id{argument_map.Parameters().GetId("ints")};
+
+      THEN("They are converted by those functions and cached.") {
+        CHECK(argument_map.GetValue<converters::FromChars<int>>("ints", 1)
+              == -3);
+        CHECK(argument_map.GetValue<converters::FromChars<int>>(ints_id)
+              == 31);
+        CHECK(argument_map.GetValue<converters::stod>("doubles") == 2.5);
+        CHECK(argument_map.GetValue<int>("ints", 1) == -3);
+        CHECK(argument_map.GetAllValues<int>("ints")
+              == std::vector<int>{31, -3});
+      }
+
+      THEN("Other conversion functions and positions cause exception.") {
+        CHECK_THROWS_AS(argument_map.GetValue<converters::stoi>("ints"),
+                        exceptions::ValueAccessError);
+        CHECK_THROWS_AS(argument_map.GetValue<converters::FromChars<int>>(
+                            "ints", 2),
+                        exceptions::ValueAccessError);
+        CHECK_THROWS_AS(argument_map.GetValue<converters::FromChars<long>>(
+                            "ints"),
+                        exceptions::ParameterAccessError);
+      }
+    }
+  }
+
+  GIVEN("A parameter with a conversion function provided at runtime.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Keyword(converters::stoi, {"int"}));
+    ArgumentMap argument_map(std::move(parameter_map));
+    argument_map.AddArgument("int", "1");
+
+    THEN("Reading values with a bound conversion function causes"
+         " exception.") {
+      CHECK_THROWS_AS(argument_map.GetValue<converters::stoi>("int"),
+                      exceptions::ValueAccessError);
+      CHECK(argument_map.GetValue<int>("int") == 1);
+    }
+  }
+}
+
+SCENARIO("Test correctness of value access with delimited list conversion"
+         " functions.",
+         "[ArgumentMap][GetValue][GetAllValues][DelimitedList][correctness]") {
+
+  GIVEN("List parameters with comma and semicolon delimited arguments.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<std::vector<int>>::Keyword<
+                      converters::DelimitedList<int>>({"ints"}))
+                 (Parameter<std::vector<double>>::Keyword<
+                      converters::DelimitedList<double, ';'>>({"doubles"}));
+    ArgumentMap argument_map(std::move(parameter_map));
+    argument_map.AddArgument("ints", "1,2,3");
+    argument_map.AddArgument("ints", "");
+    argument_map.AddArgument("doubles", "0.5;-2");
+
+    WHEN("Values are converted.") {
+      argument_map.ConvertAll();
+
+      THEN("Each argument is converted into one list.") {
+        CHECK(argument_map.GetAllValues<std::vector<int>>("ints")
+              == std::vector<std::vector<int>>{{1, 2, 3}, {}});
+        CHECK(argument_map.GetValue<std::vector<double>>("doubles")
+              == std::vector<double>{0.5, -2.0});
+      }
+    }
+  }
+
+  GIVEN("A list parameter with an invalid element.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<std::vector<int>>::Keyword<
+                      converters::DelimitedList<int>>({"ints"}));
+    ArgumentMap argument_map(std::move(parameter_map));
+    argument_map.AddArgument("ints", "1,x,3");
+
+    THEN("The conversion function's exception is propagated.") {
+      CHECK_THROWS_AS(argument_map.GetValue<std::vector<int>>("ints"),
+                      std::invalid_argument);
+    }
+  }
+}
+
 } // namespace
 
 } // namespace test
@@ -0,0 +1,287 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "conversion_functions.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Test correctness for:
+// * ParseNumber
+// * FromChars
+// * ParseDelimitedList
+// * DelimitedList
+//
+// Test exceptions for:
+// * FromChars
+// * DelimitedList
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+SCENARIO("Test correctness of converters::ParseNumber.",
+         "[converters][ParseNumber][correctness]") {
+
+  GIVEN("Well-formed integers.") {
+
+    THEN("Decimal integers with optional sign are parsed.") {
+      int value{-1};
+      CHECK(converters::ParseNumber("0", value) == std::errc{});
+      CHECK(value == 0);
+      CHECK(converters::ParseNumber("+42", value) == std::errc{});
+      CHECK(value == 42);
+      CHECK(converters::ParseNumber("-42", value) == std::errc{});
+      CHECK(value == -42);
+      CHECK(converters::ParseNumber("007", value) == std::errc{});
+      CHECK(value == 7);
+    }
+
+    THEN("Base prefixes are recognized.") {
+      long value{0};
+      CHECK(converters::ParseNumber("0x1F", value) == std::errc{});
+      CHECK(value == 31);
+      CHECK(converters::ParseNumber("0Xff", value) == std::errc{});
+      CHECK(value == 255);
+      CHECK(converters::ParseNumber("-0o17", value) == std::errc{});
+      CHECK(value == -15);
+      CHECK(converters::ParseNumber("0b101", value) == std::errc{});
+      CHECK(value == 5);
+    }
+
+    THEN("Limits of the type are parsed.") {
+      std::int8_t small{0};
+      CHECK(converters::ParseNumber("-128", small) == std::errc{});
+      CHECK(small == -128);
+      CHECK(converters::ParseNumber("127", small) == std::errc{});
+      CHECK(small == 127);
+      long long big{0};
+      CHECK(converters::ParseNumber("-9223372036854775808", big)
+            == std::errc{});
+      CHECK(big == std::numeric_limits<long long>::min());
+      unsigned long long ubig{0};
+      CHECK(converters::ParseNumber("0xffffffffffffffff", ubig)
+            == std::errc{});
+      CHECK(ubig == std::numeric_limits<unsigned long long>::max());
+    }
+
+    THEN("Digit separators are ignored when enabled.") {
+      int value{0};
+      CHECK(converters::ParseNumber<int, '\''>("1'000'000", value)
+            == std::errc{});
+      CHECK(value == 1000000);
+      CHECK(converters::ParseNumber<int, '_'>("0b1010_1010", value)
+            == std::errc{});
+      CHECK(value == 170);
+    }
+  }
+
+  GIVEN("Well-formed floating point numbers.") {
+
+    THEN("Decimal and hexadecimal notation are parsed.") {
+      double value{0.0};
+      CHECK(converters::ParseNumber("1.5", value) == std::errc{});
+      CHECK(value == 1.5);
+      CHECK(converters::ParseNumber("+2.5e3", value) == std::errc{});
+      CHECK(value == 2500.0);
+      CHECK(converters::ParseNumber("-.25", value) == std::errc{});
+      CHECK(value == -0.25);
+      CHECK(converters::ParseNumber("0x1p4", value) == std::errc{});
+      CHECK(value == 16.0);
+      float single{0.0f};
+      CHECK(converters::ParseNumber<float, '_'>("1_000.5", single)
+            == std::errc{});
+      CHECK(single == 1000.5f);
+    }
+  }
+
+  GIVEN("Malformed or out of range numbers.") {
+
+    THEN("Errors are reported and the value is unchanged.") {
+      int value{13};
+      CHECK(converters::ParseNumber("", value) == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("-", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("12abc", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber(" 12", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("+-12", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("0x", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("1.0", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("1'000", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber<int, '\''>("'1", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber<int, '\''>("1''0", value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("2147483648", value)
+            == std::errc::result_out_of_range);
+      CHECK(converters::ParseNumber("-2147483649", value)
+            == std::errc::result_out_of_range);
+      CHECK(value == 13);
+      unsigned unsigned_value{13};
+      CHECK(converters::ParseNumber("-1", unsigned_value)
+            == std::errc::result_out_of_range);
+      CHECK(unsigned_value == 13);
+      double double_value{13.0};
+      CHECK(converters::ParseNumber("1.5x", double_value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("--1.5", double_value)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseNumber("1e999", double_value)
+            == std::errc::result_out_of_range);
+      CHECK(double_value == 13.0);
+    }
+  }
+}
+
+SCENARIO("Test correctness of converters::FromChars.",
+         "[converters][FromChars][correctness]") {
+
+  GIVEN("Well-formed numbers.") {
+
+    THEN("They are converted.") {
+      CHECK(converters::FromChars<int>("-17") == -17);
+      CHECK(converters::FromChars<unsigned long>("0x10") == 16ul);
+      CHECK(converters::FromChars<long long, ','>("1,000,000") == 1000000ll);
+      CHECK(converters::FromChars<double>("0.125") == 0.125);
+      CHECK(converters::FromChars<long double>("-3.5") == -3.5l);
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by converters::FromChars.",
+         "[converters][FromChars][exceptions]") {
+
+  GIVEN("Malformed or out of range numbers.") {
+
+    THEN("Standard exceptions are thrown.") {
+      CHECK_THROWS_AS(converters::FromChars<int>("12 "), std::invalid_argument);
+      CHECK_THROWS_AS(converters::FromChars<int>("abc"), std::invalid_argument);
+      CHECK_THROWS_AS(converters::FromChars<short>("40000"),
+                      std::out_of_range);
+      CHECK_THROWS_AS(converters::FromChars<float>("1e99"), std::out_of_range);
+    }
+  }
+}
+
+SCENARIO("Test correctness of converters::ParseDelimitedList.",
+         "[converters][ParseDelimitedList][correctness]") {
+
+  GIVEN("Well-formed lists.") {
+    std::vector<int> ints{7};
+    std::vector<double> doubles;
+    std::vector<std::string> strings;
+
+    THEN("Elements are appended.") {
+      CHECK(converters::ParseDelimitedList("1,-2,0x1f", ints) == std::errc{});
+      CHECK(ints == std::vector<int>{7, 1, -2, 31});
+      CHECK(converters::ParseDelimitedList<double, ';'>("0.5;2", doubles)
+            == std::errc{});
+      CHECK(doubles == std::vector<double>{0.5, 2.0});
+      CHECK(converters::ParseDelimitedList<std::string>("a,,b", strings)
+            == std::errc{});
+      CHECK(strings == std::vector<std::string>{"a", "", "b"});
+    }
+
+    THEN("Digit separators are ignored.") {
+      CHECK(converters::ParseDelimitedList<int, ';', ','>("1,000;2", ints)
+            == std::errc{});
+      CHECK(ints == std::vector<int>{7, 1000, 2});
+    }
+
+    THEN("An empty string is an empty list.") {
+      CHECK(converters::ParseDelimitedList("", ints) == std::errc{});
+      CHECK(ints == std::vector<int>{7});
+    }
+  }
+
+  GIVEN("Malformed lists.") {
+    std::vector<int> ints{7};
+    std::string_view invalid_element;
+
+    THEN("Errors are returned and the list is unchanged.") {
+      CHECK(converters::ParseDelimitedList("1,x,3", ints, &invalid_element)
+            == std::errc::invalid_argument);
+      CHECK(invalid_element == "x");
+      CHECK(converters::ParseDelimitedList("1,2,", ints, &invalid_element)
+            == std::errc::invalid_argument);
+      CHECK(invalid_element.empty());
+      CHECK(converters::ParseDelimitedList("1, 2", ints)
+            == std::errc::invalid_argument);
+      CHECK(converters::ParseDelimitedList("1,99999999999", ints,
+                                           &invalid_element)
+            == std::errc::result_out_of_range);
+      CHECK(invalid_element == "99999999999");
+      CHECK(ints == std::vector<int>{7});
+    }
+  }
+}
+
+SCENARIO("Test correctness of converters::DelimitedList.",
+         "[converters][DelimitedList][correctness]") {
+
+  GIVEN("Well-formed lists.") {
+
+    THEN("They are converted.") {
+      CHECK(converters::DelimitedList<int>("3,2,1")
+            == std::vector<int>{3, 2, 1});
+      CHECK(converters::DelimitedList<long, ':'>("10:-10")
+            == std::vector<long>{10, -10});
+      CHECK(converters::DelimitedList<float>("").empty());
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by converters::DelimitedList.",
+         "[converters][DelimitedList][exceptions]") {
+
+  GIVEN("Malformed lists.") {
+
+    THEN("Standard exceptions are thrown.") {
+      CHECK_THROWS_AS(converters::DelimitedList<int>("1,2,a"),
+                      std::invalid_argument);
+      CHECK_THROWS_WITH(converters::DelimitedList<int>("1,2,a"),
+                        "Not a valid number: 'a' (element 2 of list).");
+      CHECK_THROWS_AS(converters::DelimitedList<short>("1,40000"),
+                      std::out_of_range);
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
\ No newline at end of file
@@ -410,6 +410,27 @@ SCENARIO("Test correctness of FormattedHelpString(ParameterMap).",
       }
     }
 
+    WHEN("Descriptions are static or provided.") {
+      std::string text{"Description. Line breaks are attempted between"
+                       " words."};
+      ParameterMap owned_map;
+      owned_map(Parameter<int>(kw_min_nodefault).Description(text))
+               (Parameter<float>(kw_nomin).Description(text)
+                    .Placeholder("<X>"));
+      ParameterMap lazy_map;
+      lazy_map(Parameter<int>(kw_min_nodefault).StaticDescription(text))
+              (Parameter<float>(kw_nomin)
+                   .Description([&text]() {return text;})
+                   .Placeholder([]() {return std::string{"<X>"};}));
+
+      THEN("The help-string matches that of owned descriptions.") {
+        CHECK(FormattedHelpString(lazy_map, "", "", 40)
+              == FormattedHelpString(owned_map, "", "", 40));
+        CHECK(FormattedHelpString(lazy_map, "", "", 40).find(
+                  "    --kw_nomin, --kwno, -k <X>\n") != std::string::npos);
+      }
+    }
+
     WHEN("Description is given and width and whitespace are modified.") {
       pos_min_nodefault.Description(
           "Description of pos_min_nodefault. The description will be broken up"
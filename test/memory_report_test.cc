@@ -0,0 +1,149 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "argument_map.h"
+#include "parameter_map.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include "allocation_counter.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Test correctness for:
+// * ParameterMap::MemoryUsage
+// * ArgumentMap::MemoryUsage
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+// Registers `size` parameters of each category with long names, descriptions
+// and default arguments.
+//
+void AddParameters(ParameterMap& parameter_map, int size) {
+  for (int i = 0; i < size; ++i) {
+    std::string suffix{"_with_a_long_name_" + std::to_string(i)};
+    parameter_map(Parameter<int>::Keyword(converters::stoi,
+                                          {"keyword" + suffix, "k" + suffix})
+                      .Description("Description too long for a short string.")
+                      .AddDefault("1234567890123456789"))
+                 (Parameter<std::string>::Positional(
+                      converters::StringIdentity, "positional" + suffix, i)
+                      .MinArgs(1))
+                 (Parameter<double>::Keyword<converters::FromChars<double>>(
+                      {"static" + suffix}))
+                 (Parameter<bool>::Flag({"flag" + suffix}));
+  }
+}
+
+SCENARIO("Test correctness of ParameterMap::MemoryUsage.",
+         "[ParameterMap][MemoryUsage][correctness]") {
+
+  GIVEN("A number of parameters.") {
+    int size = GENERATE(0, 1, 10, 100);
+
+    WHEN("They are registered with an object.") {
+      AllocationCounter counter;
+      ParameterMap parameter_map;
+      AddParameters(parameter_map, size);
+      long long live_bytes{counter.live_bytes()};
+      MemoryReport report{parameter_map.MemoryUsage()};
+
+      THEN("The report matches the memory allocated by the object.") {
+        CHECK(static_cast<long long>(report.Total()) == live_bytes);
+        CHECK(report.arguments == 0);
+        CHECK(report.values == 0);
+        if (size > 0) {
+          CHECK(report.names > 0);
+          CHECK(report.descriptions > 0);
+          CHECK(report.defaults > 0);
+          CHECK(report.converters > 0);
+          CHECK(report.hash_tables > 0);
+        }
+      }
+
+      THEN("Copies use the same amount of memory.") {
+        ParameterMap copy{parameter_map};
+        CHECK(copy.MemoryUsage().Total() <= report.Total());
+      }
+
+      THEN("The report includes the index built for suggestions.") {
+        long long live_bytes_before{counter.live_bytes()};
+        parameter_map.Suggest("flag_with_a_long_nmae_0");
+        long long index_bytes{counter.live_bytes() - live_bytes_before};
+        MemoryReport suggest_report{parameter_map.MemoryUsage()};
+        CHECK(static_cast<long long>(suggest_report.Total() - report.Total())
+              == index_bytes);
+        CHECK(suggest_report.hash_tables - report.hash_tables
+              == static_cast<std::size_t>(index_bytes));
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ArgumentMap::MemoryUsage.",
+         "[ArgumentMap][MemoryUsage][correctness]") {
+
+  GIVEN("A shared `ParameterMap` object.") {
+    int size = GENERATE(1, 10, 100);
+    ParameterMap parameter_map;
+    AddParameters(parameter_map, size);
+    auto shared = std::make_shared<const ParameterMap>(
+        std::move(parameter_map));
+
+    WHEN("Arguments are added and values are computed.") {
+      AllocationCounter counter;
+      ArgumentMap argument_map{shared};
+      for (int i = 0; i < size; ++i) {
+        std::string suffix{"_with_a_long_name_" + std::to_string(i)};
+        argument_map.AddArgument("keyword" + suffix, std::to_string(i));
+        argument_map.AddArgument("positional" + suffix,
+                                 "argument too long for a short string");
+        argument_map.AddArgument("static" + suffix, "0.5");
+        argument_map.AddArgument("flag" + suffix, "");
+      }
+      argument_map.SetDefaultArguments();
+      argument_map.ConvertAll();
+      long long live_bytes{counter.live_bytes()};
+      MemoryReport report{argument_map.MemoryUsage()};
+
+      THEN("The report matches the memory allocated by the object.") {
+        CHECK(static_cast<long long>(report.Total()) == live_bytes);
+        CHECK(report.arguments > 0);
+        CHECK(report.values > 0);
+        CHECK(report.names == 0);
+        CHECK(report.converters == 0);
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
@@ -0,0 +1,118 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "name_table.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Test correctness for:
+// * NameTable::Find
+// * NameTable::Insert
+// * NameTable::Reserve
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+using internal::NameTable;
+
+SCENARIO("Test correctness of NameTable::Find and NameTable::Insert.",
+         "[NameTable][Find][Insert][correctness]") {
+
+  GIVEN("An empty `NameTable` object.") {
+    NameTable table;
+
+    THEN("No name is found.") {
+      CHECK(table.size() == 0);
+      CHECK(table.Find("a") == NameTable::kNotFound);
+      CHECK(table.Find("") == NameTable::kNotFound);
+    }
+
+    WHEN("Short and long names are inserted.") {
+      std::vector<std::string> names;
+      for (int i = 0; i < 1000; ++i) {
+        names.push_back(std::string(i % 40 + 1, 'a' + i % 26)
+                        + std::to_string(i));
+      }
+      for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+        table.Insert(names.at(i), i);
+      }
+
+      THEN("Each name is found with its integer-identifier.") {
+        CHECK(table.size() == names.size());
+        for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+          CHECK(table.Find(names.at(i)) == i);
+        }
+      }
+
+      THEN("Other names are not found.") {
+        for (const std::string& name : names) {
+          CHECK(table.Find(name + "_") == NameTable::kNotFound);
+          CHECK(table.Find(name.substr(1)) == NameTable::kNotFound);
+        }
+        CHECK(table.Find("") == NameTable::kNotFound);
+      }
+
+      THEN("Copies find the same names.") {
+        NameTable copy{table};
+        for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+          CHECK(copy.Find(names.at(i)) == i);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of NameTable::Reserve.",
+         "[NameTable][Reserve][correctness]") {
+
+  GIVEN("A `NameTable` object containing a name.") {
+    NameTable table;
+    table.Insert("v", 0);
+
+    WHEN("Room for more names is reserved.") {
+      table.Reserve(100);
+      std::size_t heap_size{table.HeapSize()};
+      for (int i = 1; i < 100; ++i) {
+        table.Insert("name_" + std::to_string(i), i);
+      }
+
+      THEN("Inserting them does not grow the table.") {
+        CHECK(table.HeapSize() == heap_size);
+        CHECK(table.Find("v") == 0);
+        CHECK(table.Find("name_99") == 99);
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
@@ -37,6 +37,16 @@
 // * GetConfiguration(int)
 // * ConversionFunction
 // * operator()
+// * Register
+// * Reserve
+// * layout
+// * FindId
+// * MatchAbbreviation
+// * NamesStartingWith
+// * Suggest
+// * AddSubcommand
+// * FindSubcommand
+// * SubcommandParameters
 //
 // Test invariants for:
 // * operator()
@@ -49,6 +59,10 @@
 // * GetConfiguration(int)
 // * ConversionFunction
 // * operator()
+// * Register
+// * AddSubcommand
+// * SubcommandName
+// * SubcommandParameters
 
 namespace arg_parse_convert {
 
@@ -289,6 +303,466 @@ SCENARIO("Test exceptions thrown by ParameterMap::operator().",
   }
 }
 
+SCENARIO("Test correctness of ParameterMap::Register.",
+         "[ParameterMap][Register][correctness]") {
+
+  GIVEN("A `ParameterMap` object and a list of parameters.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"v"}));
+    std::vector<Parameter<int>> parameters{
+        Parameter<int>::Positional(converters::stoi, "first", 0).MinArgs(1),
+        Parameter<int>::Keyword(converters::stoi, {"k", "keyword"}),
+        Parameter<int>::Positional(converters::stoi, "second", 1)};
+
+    WHEN("The list is registered at once.") {
+      parameter_map.Register(parameters);
+
+      THEN("The parameters are inserted in order.") {
+        CHECK(parameter_map.size() == 4);
+        CHECK(parameter_map.GetId("first") == 1);
+        CHECK(parameter_map.GetId("k") == 2);
+        CHECK(parameter_map.GetId("keyword") == 2);
+        CHECK(parameter_map.GetId("second") == 3);
+        CHECK(parameter_map.IsKeyword("keyword"));
+        CHECK(parameter_map.required_parameters().count(1));
+        CHECK(parameter_map.positional_parameters().at(0) == 1);
+        CHECK(parameter_map.positional_parameters().at(1) == 3);
+        CHECK(parameter_map.ConversionFunction<int>("second")("12") == 12);
+      }
+
+      THEN("The categories follow parameters inserted after reading them.") {
+        CHECK(parameter_map.flags().size() == 1);
+        ParameterMap copy{parameter_map};
+        copy(Parameter<bool>::Flag({"q"}));
+        CHECK(copy.flags().size() == 2);
+        CHECK(copy.flags().count(4));
+        CHECK(parameter_map.flags().size() == 1);
+        CHECK(copy.keyword_parameters().count(2));
+        CHECK(copy.positional_parameters().size() == 2);
+      }
+
+      THEN("The list is unchanged.") {
+        CHECK(parameters.at(1).configuration().names().size() == 2);
+      }
+    }
+
+    WHEN("The list is moved into the object.") {
+      parameter_map.Register(std::make_move_iterator(parameters.begin()),
+                             std::make_move_iterator(parameters.end()));
+
+      THEN("The parameters are inserted in order.") {
+        CHECK(parameter_map.size() == 4);
+        CHECK(parameter_map.GetId("keyword") == 2);
+      }
+    }
+  }
+
+  GIVEN("An empty `ParameterMap` object and many parameters.") {
+    ParameterMap parameter_map;
+    std::vector<Parameter<bool>> flags;
+    for (int i = 0; i < 1000; ++i) {
+      flags.push_back(Parameter<bool>::Flag({"flag_" + std::to_string(i)}));
+    }
+
+    WHEN("They are registered at once, and one more parameter after them.") {
+      parameter_map.Register(flags);
+      parameter_map(Parameter<bool>::Flag({"last"}));
+
+      THEN("All of them are contained in the object.") {
+        CHECK(parameter_map.size() == 1001);
+        CHECK(parameter_map.flags().size() == 1001);
+        CHECK(parameter_map.GetId("flag_999") == 999);
+        CHECK(parameter_map.GetId("last") == 1000);
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ParameterMap::Reserve.",
+         "[ParameterMap][Reserve][correctness]") {
+
+  GIVEN("A `ParameterMap` object with reserved space.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"v"}));
+    parameter_map.Reserve(100, 200);
+
+    WHEN("Parameters are registered.") {
+      for (int i = 0; i < 100; ++i) {
+        parameter_map(Parameter<bool>::Flag({"flag_" + std::to_string(i)}));
+      }
+
+      THEN("They are contained in the object.") {
+        CHECK(parameter_map.size() == 101);
+        CHECK(parameter_map.GetId("v") == 0);
+        CHECK(parameter_map.GetId("flag_99") == 100);
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ParameterMap::layout.",
+         "[ParameterMap][layout][correctness]") {
+
+  GIVEN("A `ParameterMap` object with parameters of all categories.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional(converters::stoi, "third", 3))
+                 (Parameter<int>::Keyword(converters::stoi, {"k"}).MinArgs(1))
+                 (Parameter<int>::Positional(converters::stoi, "first", 1))
+                 (Parameter<bool>::Flag({"v"}))
+                 (Parameter<int>::Keyword(converters::stoi, {"o"})
+                      .MaxArgs(2).AddDefault("7"))
+                 (Parameter<int>::Positional(converters::stoi, "second", 2)
+                      .MinArgs(0));
+    const ParameterLayout& layout{parameter_map.layout()};
+
+    THEN("The layout agrees with the configurations.") {
+      REQUIRE(layout.size() == parameter_map.size());
+      for (int id = 0; id < static_cast<int>(parameter_map.size()); ++id) {
+        const ParameterConfiguration& configuration{
+            parameter_map.GetConfiguration(id)};
+        CHECK(layout.category(id) == configuration.category());
+        CHECK(layout.IsRequired(id) == configuration.IsRequired());
+        CHECK(layout.position(id) == configuration.position());
+        CHECK(layout.min_num_arguments(id)
+              == configuration.min_num_arguments());
+        CHECK(layout.max_num_arguments(id)
+              == configuration.max_num_arguments());
+        CHECK(layout.HasDefaults(id)
+              == !configuration.default_arguments().empty());
+        CHECK(layout.IsFlag(id)
+              == (configuration.category() == ParameterCategory::kFlag));
+        CHECK(layout.IsKeyword(id)
+              == (configuration.category()
+                  == ParameterCategory::kKeywordParameter));
+      }
+    }
+
+    THEN("Argument lists are full at the maximum number of arguments.") {
+      int id{parameter_map.GetId("o")};
+      CHECK_FALSE(layout.IsFull(id, 1));
+      CHECK(layout.IsFull(id, 2));
+      CHECK_FALSE(layout.IsFull(parameter_map.GetId("k"), 100));
+    }
+
+    THEN("Positional parameters are ordered by position.") {
+      std::vector<std::pair<int, int>> expected{{1, 2}, {2, 5}, {3, 0}};
+      CHECK(layout.positional_parameters() == expected);
+    }
+
+    WHEN("More parameters than fit into a single bitset word are added.") {
+      for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+          parameter_map(Parameter<bool>::Flag({"flag_" + std::to_string(i)}));
+        } else {
+          parameter_map(Parameter<int>::Keyword(
+              converters::stoi, {"keyword_" + std::to_string(i)})
+                  .MinArgs(i % 3 - 1));
+        }
+      }
+
+      THEN("The bits of all parameters are set correctly.") {
+        REQUIRE(layout.size() == 106);
+        for (int i = 0; i < 100; ++i) {
+          CHECK(layout.IsFlag(i + 6) == (i % 3 == 0));
+          CHECK(layout.IsRequired(i + 6) == (i % 3 == 2));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ParameterMap::MatchAbbreviation.",
+         "[ParameterMap][MatchAbbreviation][correctness]") {
+
+  GIVEN("A `ParameterMap` object with names sharing prefixes.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"verbose", "v", "verbosity"}))
+                 (Parameter<bool>::Flag({"version"}))
+                 (Parameter<int>::Keyword(converters::stoi, {"ver"}));
+
+    THEN("Only exact names match before abbreviations are allowed.") {
+      CHECK_FALSE(parameter_map.AllowsAbbreviations());
+      CHECK(parameter_map.FindId("verbose") == 0);
+      CHECK(parameter_map.FindId("verb") == ParameterMap::kNoMatch);
+      CHECK(parameter_map.MatchAbbreviation("verb") == ParameterMap::kNoMatch);
+      CHECK(parameter_map.NamesStartingWith("ver").empty());
+    }
+
+    WHEN("Abbreviations are allowed and more parameters are added.") {
+      parameter_map.AllowAbbreviations();
+      parameter_map(Parameter<int>::Keyword(converters::stoi, {"zebra"}));
+
+      THEN("Unique prefixes match their parameters.") {
+        CHECK(parameter_map.AllowsAbbreviations());
+        CHECK(parameter_map.MatchAbbreviation("verb") == 0);
+        CHECK(parameter_map.MatchAbbreviation("verbos") == 0);
+        CHECK(parameter_map.MatchAbbreviation("vers") == 1);
+        CHECK(parameter_map.MatchAbbreviation("z") == 3);
+      }
+
+      THEN("Exact names take precedence over prefixes.") {
+        CHECK(parameter_map.MatchAbbreviation("v") == 0);
+        CHECK(parameter_map.MatchAbbreviation("ver") == 2);
+        CHECK(parameter_map.MatchAbbreviation("zebra") == 3);
+      }
+
+      THEN("Other prefixes are ambiguous or do not match.") {
+        CHECK(parameter_map.MatchAbbreviation("ve")
+              == ParameterMap::kAmbiguousMatch);
+        CHECK(parameter_map.MatchAbbreviation("")
+              == ParameterMap::kAmbiguousMatch);
+        CHECK(parameter_map.MatchAbbreviation("verbs")
+              == ParameterMap::kNoMatch);
+        CHECK(parameter_map.MatchAbbreviation("zebras")
+              == ParameterMap::kNoMatch);
+        CHECK(parameter_map.MatchAbbreviation("x") == ParameterMap::kNoMatch);
+      }
+
+      THEN("Names starting with a prefix are listed in order.") {
+        CHECK(parameter_map.NamesStartingWith("ve")
+              == std::vector<std::string>{"ver", "verbose", "verbosity",
+                                          "version"});
+        CHECK(parameter_map.NamesStartingWith("verbo")
+              == std::vector<std::string>{"verbose", "verbosity"});
+        CHECK(parameter_map.NamesStartingWith("y").empty());
+      }
+    }
+  }
+
+  GIVEN("A positional and a keyword parameter whose names share a prefix.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional(converters::stoi, "input", 0));
+
+    WHEN("Abbreviations are allowed before or after they are inserted.") {
+      bool allow_first = GENERATE(true, false);
+      if (allow_first) {
+        parameter_map.AllowAbbreviations();
+      }
+      parameter_map(Parameter<int>::Keyword(converters::stoi, {"include"}))
+                   (Parameter<int>::Positional(converters::stoi, "inputs", 1));
+      if (!allow_first) {
+        parameter_map.AllowAbbreviations();
+      }
+
+      THEN("Prefixes only match the keyword parameter.") {
+        CHECK(parameter_map.MatchAbbreviation("in") == 1);
+        CHECK(parameter_map.MatchAbbreviation("inc") == 1);
+        CHECK(parameter_map.MatchAbbreviation("inp") == ParameterMap::kNoMatch);
+        CHECK(parameter_map.NamesStartingWith("in")
+              == std::vector<std::string>{"include"});
+      }
+
+      THEN("Names of positional parameters still match exactly.") {
+        CHECK(parameter_map.MatchAbbreviation("input") == 0);
+        CHECK(parameter_map.MatchAbbreviation("inputs") == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ParameterMap::Suggest.",
+         "[ParameterMap][Suggest][correctness]") {
+
+  GIVEN("A `ParameterMap` object with similar names.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"verbose", "v"}))
+                 (Parameter<bool>::Flag({"version"}))
+                 (Parameter<int>::Keyword(converters::stoi, {"level", "lvl"}));
+
+    THEN("Names close to misspelled ones are suggested, nearest first.") {
+      CHECK(parameter_map.Suggest("verbsoe")
+            == std::vector<std::string>{"verbose"});
+      CHECK(parameter_map.Suggest("versoin")
+            == std::vector<std::string>{"version"});
+      CHECK(parameter_map.Suggest("verison")
+            == std::vector<std::string>{"version"});
+      CHECK(parameter_map.Suggest("vrsion")
+            == std::vector<std::string>{"version"});
+      CHECK(parameter_map.Suggest("levl")
+            == std::vector<std::string>{"level", "lvl"});
+      CHECK(parameter_map.Suggest("levl", 1)
+            == std::vector<std::string>{"level"});
+    }
+
+    THEN("Short names allow one edit, longer ones two.") {
+      CHECK(parameter_map.Suggest("lv")
+            == std::vector<std::string>{"lvl", "v"});
+      CHECK(parameter_map.Suggest("lx").empty());
+      CHECK(parameter_map.Suggest("levvell")
+            == std::vector<std::string>{"level"});
+      CHECK(parameter_map.Suggest("quiet").empty());
+    }
+
+    THEN("Names lacking two characters of a name are not suggested.") {
+      CHECK(parameter_map.Suggest("vrbse").empty());
+    }
+
+    WHEN("More parameters are added after suggestions were made.") {
+      CHECK(parameter_map.Suggest("quiett").empty());
+      parameter_map(Parameter<bool>::Flag({"quiet"}));
+
+      THEN("The new names are suggested too.") {
+        CHECK(parameter_map.Suggest("quiett")
+              == std::vector<std::string>{"quiet"});
+      }
+    }
+  }
+
+  GIVEN("A `ParameterMap` object with a positional parameter.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<std::string>::Positional(
+                      converters::StringIdentity, "input", 1))
+                 (Parameter<bool>::Flag({"inputs"}));
+
+    THEN("Only names of keyword parameters and flags are suggested.") {
+      CHECK(parameter_map.Suggest("inptu").empty());
+      CHECK(parameter_map.Suggest("inptus")
+            == std::vector<std::string>{"inputs"});
+    }
+  }
+
+  GIVEN("An empty `ParameterMap` object.") {
+    ParameterMap parameter_map;
+
+    THEN("Nothing is suggested.") {
+      CHECK(parameter_map.Suggest("verbose").empty());
+    }
+  }
+}
+
+SCENARIO("Test correctness of ParameterMap::AddSubcommand.",
+         "[ParameterMap][AddSubcommand][correctness]") {
+
+  GIVEN("A `ParameterMap` object with subcommands.") {
+    int num_calls{0};
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"verbose"}))
+                 .AddSubcommand("build", [&num_calls]() {
+                    ++num_calls;
+                    ParameterMap result;
+                    result(Parameter<bool>::Flag({"release"}));
+                    return result;
+                  })
+                 .AddSubcommand("test", []() {return ParameterMap{};});
+
+    THEN("Subcommands are found by name, separately from parameters.") {
+      CHECK(parameter_map.num_subcommands() == 2);
+      CHECK(parameter_map.FindSubcommand("build") == 0);
+      CHECK(parameter_map.FindSubcommand("test") == 1);
+      CHECK(parameter_map.FindSubcommand("verbose") == ParameterMap::kNoMatch);
+      CHECK(parameter_map.FindId("build") == ParameterMap::kNoMatch);
+      CHECK(parameter_map.SubcommandName(1) == "test");
+    }
+
+    THEN("Factories are only called when parameters are first requested.") {
+      CHECK(num_calls == 0);
+      std::shared_ptr<const ParameterMap> parameters{
+          parameter_map.SubcommandParameters(0)};
+      CHECK(num_calls == 1);
+      CHECK(parameters->Contains("release"));
+      CHECK(parameter_map.SubcommandParameters(0) == parameters);
+      CHECK(num_calls == 1);
+    }
+
+    THEN("Copies share parameters created before copying.") {
+      std::shared_ptr<const ParameterMap> parameters{
+          parameter_map.SubcommandParameters(0)};
+      ParameterMap copy{parameter_map};
+      CHECK(copy.SubcommandParameters(0) == parameters);
+      CHECK(copy.SubcommandParameters(1)->size() == 0);
+      CHECK(num_calls == 1);
+    }
+  }
+
+  GIVEN("An empty `ParameterMap` object.") {
+    ParameterMap parameter_map;
+
+    THEN("No subcommand is found.") {
+      CHECK(parameter_map.num_subcommands() == 0);
+      CHECK(parameter_map.FindSubcommand("build") == ParameterMap::kNoMatch);
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by ParameterMap::AddSubcommand.",
+         "[ParameterMap][AddSubcommand][exceptions]") {
+
+  GIVEN("A `ParameterMap` object with a subcommand.") {
+    ParameterMap parameter_map;
+    parameter_map.AddSubcommand("build", []() {return ParameterMap{};});
+
+    THEN("Empty, hyphenated and taken names cause exception.") {
+      auto factory = []() {return ParameterMap{};};
+      CHECK_THROWS_AS(parameter_map.AddSubcommand("", factory),
+                      exceptions::ParameterRegistrationError);
+      CHECK_THROWS_AS(parameter_map.AddSubcommand("-b", factory),
+                      exceptions::ParameterRegistrationError);
+      CHECK_THROWS_AS(parameter_map.AddSubcommand("build", factory),
+                      exceptions::ParameterRegistrationError);
+      CHECK(parameter_map.num_subcommands() == 1);
+    }
+
+    THEN("Unknown integer-identifiers cause exception.") {
+      CHECK_THROWS_AS(parameter_map.SubcommandName(1),
+                      exceptions::ParameterAccessError);
+      CHECK_THROWS_AS(parameter_map.SubcommandParameters(-1),
+                      exceptions::ParameterAccessError);
+    }
+
+    THEN("Exceptions thrown by factories are propagated.") {
+      parameter_map.AddSubcommand("fail", []() -> ParameterMap {
+        throw std::runtime_error{"factory failed"};
+      });
+      CHECK_THROWS_AS(parameter_map.SubcommandParameters(1),
+                      std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by ParameterMap::Register.",
+         "[ParameterMap][Register][exceptions]") {
+
+  GIVEN("A `ParameterMap` object containing some parameters.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional(converters::stoi, "foo", 1))
+                 (Parameter<int>::Keyword(converters::stoi, {"b", "bar"}));
+
+    THEN("Reusing stored names causes exception.") {
+      std::vector<Parameter<int>> parameters{
+          Parameter<int>::Keyword(converters::stoi, {"new"}),
+          Parameter<int>::Keyword(converters::stoi, {"c", "bar"})};
+      CHECK_THROWS_AS(parameter_map.Register(parameters),
+                      exceptions::ParameterRegistrationError);
+      CHECK_FALSE(parameter_map.Contains("new"));
+      CHECK(parameter_map.size() == 2);
+    }
+
+    THEN("Reusing names within the list causes exception.") {
+      std::vector<Parameter<int>> parameters{
+          Parameter<int>::Keyword(converters::stoi, {"new"}),
+          Parameter<int>::Keyword(converters::stoi, {"c", "new"})};
+      CHECK_THROWS_AS(parameter_map.Register(parameters),
+                      exceptions::ParameterRegistrationError);
+      CHECK_FALSE(parameter_map.Contains("new"));
+      CHECK(parameter_map.size() == 2);
+    }
+
+    THEN("Reusing positions causes exception.") {
+      std::vector<Parameter<int>> stored_position{
+          Parameter<int>::Positional(converters::stoi, "zip", 1)};
+      std::vector<Parameter<int>> repeated_position{
+          Parameter<int>::Positional(converters::stoi, "zip", 2),
+          Parameter<int>::Positional(converters::stoi, "zap", 2)};
+      CHECK_THROWS_AS(parameter_map.Register(stored_position),
+                      exceptions::ParameterRegistrationError);
+      CHECK_THROWS_AS(parameter_map.Register(repeated_position),
+                      exceptions::ParameterRegistrationError);
+      CHECK_FALSE(parameter_map.Contains("zip"));
+      CHECK(parameter_map.size() == 2);
+    }
+  }
+}
+
 SCENARIO("Test correctness of ParameterMap::GetPrimaryName.",
          "[ParameterMap][GetPrimaryName][correctness]") {
 
@@ -55,6 +55,8 @@
 // * Flag
 // * Keyword
 // * Positional
+// * Keyword and Positional with compile-time conversion function
+// * Description and Placeholder with providers or static storage
 //
 // Test invariants for:
 // * Flag
@@ -72,6 +74,12 @@ namespace test {
 
 int DummyConverter(const std::string& s) {return 2020;}
 
+struct SuffixConverter {
+  std::string operator()(const std::string& s) const {
+    return std::string{s}.append("_converted");
+  }
+};
+
 namespace {
 
 // ParameterConfiguration tests.
@@ -1003,6 +1011,151 @@ SCENARIO("Test exceptions thrown by Parameter::Positional factory.",
   }
 }
 
+SCENARIO("Test correctness of Parameter factories with compile-time conversion"
+         " functions.",
+         "[Parameter][Keyword][Positional][correctness]") {
+
+  WHEN("Conversion functions are bound at compile time.") {
+    Parameter<int> foo{Parameter<int>::Keyword<converters::FromChars<int>>(
+        {"foo", "f"})};
+    Parameter<std::string> bar{Parameter<std::string>::Keyword<
+        SuffixConverter>({"bar"})};
+    Parameter<int> baz{Parameter<int>::Positional<DummyConverter>("baz", 3)};
+    Parameter<std::string> qux{Parameter<std::string>::Positional<
+        SuffixConverter>("qux", 4)};
+
+    THEN("Configurations match those of the other factories.") {
+      CHECK(foo.configuration()
+            == Parameter<int>::Keyword(converters::stoi, {"foo", "f"})
+                   .configuration());
+      CHECK(bar.configuration()
+            == Parameter<std::string>::Keyword(converters::StringIdentity,
+                                               {"bar"}).configuration());
+      CHECK(baz.configuration()
+            == Parameter<int>::Positional(DummyConverter, "baz", 3)
+                   .configuration());
+      CHECK(qux.configuration()
+            == Parameter<std::string>::Positional(converters::StringIdentity,
+                                                  "qux", 4).configuration());
+    }
+
+    THEN("All conversion functions call the bound conversion function.") {
+      CHECK(foo.converter()("0x10") == 16);
+      CHECK(std::any_cast<int>(foo.value_converter()("-5")) == -5);
+      CHECK(bar.converter()("arg") == "arg_converted");
+      CHECK(std::any_cast<std::string>(bar.value_converter()("arg"))
+            == "arg_converted");
+      CHECK(baz.converter()("arg") == 2020);
+      CHECK(std::any_cast<int>(baz.value_converter()("arg")) == 2020);
+      CHECK(qux.converter()("arg") == "arg_converted");
+    }
+  }
+
+  WHEN("Conversion functions are provided at runtime.") {
+    Parameter<int> foo{Parameter<int>::Keyword(converters::stoi, {"foo"})};
+
+    THEN("No type-erased conversion function is stored.") {
+      CHECK(foo.value_converter() == nullptr);
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by Parameter factories with compile-time"
+         " conversion functions.",
+         "[Parameter][Keyword][Positional][exceptions]") {
+
+  THEN("Providing empty names causes exception.") {
+    CHECK_THROWS_AS(Parameter<int>::Keyword<DummyConverter>({}),
+                    exceptions::ParameterConfigurationError);
+    CHECK_THROWS_AS(Parameter<std::string>::Keyword<SuffixConverter>({""}),
+                    exceptions::ParameterConfigurationError);
+    CHECK_THROWS_AS(Parameter<int>::Positional<DummyConverter>("", 1),
+                    exceptions::ParameterConfigurationError);
+  }
+}
+
+SCENARIO("Test correctness of lazily provided and static help text.",
+         "[Parameter][Description][Placeholder][correctness]") {
+
+  GIVEN("Parameters with static and provided descriptions.") {
+    int num_calls{0};
+    static constexpr char kDescription[]{"Static description."};
+    Parameter<int> foo{Parameter<int>::Keyword(converters::stoi, {"foo"})
+                           .StaticDescription(kDescription)
+                           .StaticPlaceholder("<N>")};
+    Parameter<int> bar{Parameter<int>::Keyword(converters::stoi, {"bar"})
+                           .Description([&num_calls]() {
+                             ++num_calls;
+                             return std::string{"Provided description."};
+                           })
+                           .Placeholder([]() {return std::string{"<M>"};})};
+
+    THEN("Static text is viewed, not copied.") {
+      CHECK(foo.configuration().description_text().HeapSize() == 0);
+      CHECK(foo.configuration().placeholder_text().HeapSize() == 0);
+      CHECK(foo.configuration().description_text().str()
+            == "Static description.");
+      CHECK(foo.configuration().description_text().HeapSize() == 0);
+      CHECK_FALSE(foo.configuration().description_text().IsProvided());
+    }
+
+    THEN("Text returned by reference is built once and kept.") {
+      const std::string& description{foo.configuration().description()};
+      CHECK(description == "Static description.");
+      CHECK(&foo.configuration().description() == &description);
+      CHECK(foo.configuration().description_text().HeapSize() > 0);
+      CHECK(foo.configuration().placeholder() == "<N>");
+      CHECK(bar.configuration().description() == "Provided description.");
+      CHECK(bar.configuration().description() == "Provided description.");
+      CHECK(num_calls == 1);
+    }
+
+    THEN("Providers are only called when the text is read.") {
+      Parameter<int> bar_copy{bar};
+      CHECK(num_calls == 0);
+      CHECK(bar.configuration().description_text().IsProvided());
+      CHECK(bar.configuration().description_text().str()
+            == "Provided description.");
+      CHECK(num_calls == 1);
+      CHECK(bar_copy.configuration().description_text().str()
+            == "Provided description.");
+      CHECK(num_calls == 2);
+      CHECK(bar.configuration().placeholder_text().str() == "<M>");
+    }
+
+    THEN("Configurations with static text compare equal to those with owned"
+         " text.") {
+      CHECK(foo.configuration()
+            == Parameter<int>::Keyword(converters::stoi, {"foo"})
+                   .Description("Static description.").Placeholder("<N>")
+                   .configuration());
+    }
+
+    THEN("Configurations with provided text compare equal only if they share"
+         " the providers, which are not called.") {
+      Parameter<int> bar_copy{bar};
+      CHECK(bar.configuration() == bar_copy.configuration());
+      CHECK_FALSE(bar.configuration()
+                  == Parameter<int>::Keyword(converters::stoi, {"bar"})
+                         .Description("Provided description.")
+                         .Placeholder("<M>")
+                         .configuration());
+      CHECK(num_calls == 0);
+    }
+  }
+
+  GIVEN("A positional parameter.") {
+    Parameter<int> baz{Parameter<int>::Positional(converters::stoi, "baz", 0)};
+
+    THEN("Its name is the placeholder until another one is set.") {
+      CHECK(baz.configuration().placeholder() == "baz");
+      CHECK(baz.configuration().placeholder_text().HeapSize() == 0);
+      baz.StaticPlaceholder("<BAZ>");
+      CHECK(baz.configuration().placeholder() == "<BAZ>");
+    }
+  }
+}
+
 } // namespace
 
 } // namespace test
@@ -0,0 +1,225 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "parse_observer.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include <array>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parsers.h"
+
+// Test correctness for:
+// * ParseObserver notifications by ParseArgs, ParseFile, GetValue, and
+//   ConvertAll
+// * HistogramParseObserver
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+// Records all notifications.
+//
+class RecordingObserver final : public ParseObserver {
+ public:
+  void OnPhase(ParsePhase phase,
+               const PhaseStatistics& statistics) noexcept override {
+    phases.push_back(phase);
+    statistics_list.push_back(statistics);
+  }
+
+  std::vector<ParsePhase> phases;
+  std::vector<PhaseStatistics> statistics_list;
+};
+
+ParameterMap MakeParameters() {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<int>::Positional(converters::stoi, "pos", 0))
+               (Parameter<int>::Keyword(converters::stoi, {"key", "k"}))
+               (Parameter<bool>::Flag({"flag", "f"}));
+  return parameter_map;
+}
+
+SCENARIO("Test correctness of ParseObserver notifications.",
+         "[ParseObserver][correctness]") {
+
+  GIVEN("An `ArgumentMap` object with an observer.") {
+    RecordingObserver observer;
+    ArgumentMap argument_map{MakeParameters()};
+    argument_map.SetParseObserver(&observer);
+    REQUIRE(argument_map.parse_observer() == &observer);
+
+    WHEN("Command-line arguments are parsed.") {
+      std::array<const char*, 5> argv{"command", "12", "-f", "--key", "345"};
+      ParseArgs(argv.size(), argv.data(), argument_map);
+
+      THEN("Each phase is reported once.") {
+        REQUIRE(observer.phases == std::vector<ParsePhase>{
+                    ParsePhase::kTokenize, ParsePhase::kLookup,
+                    ParsePhase::kAssign});
+        CHECK(observer.statistics_list[0].tokens == 4);
+        CHECK(observer.statistics_list[0].bytes == 12);
+        CHECK(observer.statistics_list[1].lookups == 2);
+        CHECK(observer.statistics_list[2].tokens == 3);
+        for (const PhaseStatistics& statistics : observer.statistics_list) {
+          CHECK(statistics.elapsed.count() >= 0);
+        }
+      }
+
+      THEN("Each conversion is reported once.") {
+        observer.phases.clear();
+        observer.statistics_list.clear();
+        CHECK(argument_map.GetValue<int>("key") == 345);
+        CHECK(argument_map.GetValue<int>("key") == 345);
+        CHECK(argument_map.GetAllValues<int>("pos") == std::vector<int>{12});
+        REQUIRE(observer.phases == std::vector<ParsePhase>{
+                    ParsePhase::kConvert, ParsePhase::kConvert});
+        CHECK(observer.statistics_list[0].tokens == 1);
+        CHECK(observer.statistics_list[0].bytes == 3);
+      }
+    }
+
+    WHEN("A configuration file is parsed.") {
+      std::stringstream config{"# comment\npos=1 2\nkey=3\nflag=true\n"};
+      ParseFile(config, argument_map);
+
+      THEN("Each phase is reported once.") {
+        REQUIRE(observer.phases == std::vector<ParsePhase>{
+                    ParsePhase::kTokenize, ParsePhase::kLookup,
+                    ParsePhase::kAssign});
+        CHECK(observer.statistics_list[0].tokens == 4);
+        CHECK(observer.statistics_list[0].bytes == 30);
+        CHECK(observer.statistics_list[1].lookups == 3);
+        CHECK(observer.statistics_list[2].tokens == 4);
+      }
+    }
+
+    WHEN("All values of a parameter are read at once.") {
+      for (int i = 0; i < 10; ++i) {
+        argument_map.AddArgument("key", std::to_string(i));
+      }
+      CHECK(argument_map.GetValue<int>("key", 3) == 3);
+      observer.phases.clear();
+      observer.statistics_list.clear();
+      std::vector<int> values;
+      argument_map.GetAllValuesInto("key", values);
+      argument_map.GetAllValuesInto("key", values);
+
+      THEN("The conversions are reported as one phase.") {
+        CHECK(values.size() == 20);
+        REQUIRE(observer.phases == std::vector<ParsePhase>{
+                    ParsePhase::kConvert});
+        CHECK(observer.statistics_list[0].tokens == 9);
+        CHECK(observer.statistics_list[0].bytes == 9);
+      }
+    }
+
+    WHEN("All values are converted by tasks.") {
+      for (int i = 0; i < 10; ++i) {
+        argument_map.AddArgument("key", std::to_string(i));
+      }
+      argument_map.ConvertAll([](std::function<void()> task) {task();}, 4);
+
+      THEN("Each task is reported.") {
+        REQUIRE(observer.phases.size() == 3);
+        CHECK(observer.statistics_list[0].tokens
+              + observer.statistics_list[1].tokens
+              + observer.statistics_list[2].tokens == 10);
+      }
+    }
+  }
+
+  GIVEN("An `ArgumentMap` object without an observer.") {
+    ArgumentMap argument_map{MakeParameters()};
+    std::array<const char*, 3> argv{"command", "-f", "1"};
+
+    THEN("Parsing is unaffected.") {
+      CHECK(argument_map.parse_observer() == nullptr);
+      CHECK(ParseArgs(argv.size(), argv.data(), argument_map).empty());
+      CHECK(argument_map.GetValue<int>("pos") == 1);
+    }
+  }
+}
+
+SCENARIO("Test correctness of HistogramParseObserver.",
+         "[HistogramParseObserver][correctness]") {
+
+  GIVEN("A `HistogramParseObserver` object.") {
+    HistogramParseObserver observer;
+
+    WHEN("Notified from multiple threads.") {
+      std::vector<std::thread> threads;
+      for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&observer] {
+          for (int j = 0; j < 1000; ++j) {
+            PhaseStatistics statistics;
+            statistics.tokens = 2;
+            statistics.bytes = 10;
+            statistics.elapsed = std::chrono::nanoseconds{j};
+            observer.OnPhase(ParsePhase::kConvert, statistics);
+          }
+        });
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+
+      THEN("All notifications are aggregated.") {
+        PhaseHistogram histogram{observer.Histogram(ParsePhase::kConvert)};
+        CHECK(histogram.count == 4000);
+        CHECK(histogram.tokens == 8000);
+        CHECK(histogram.bytes == 40000);
+        CHECK(histogram.elapsed.count() == 4 * 999 * 1000 / 2);
+        CHECK(histogram.buckets[0] == 4);
+        CHECK(histogram.buckets[1] == 4);
+        CHECK(histogram.buckets[2] == 8);
+        CHECK(histogram.buckets[10] == 4 * (1000 - 512));
+        CHECK(observer.Histogram(ParsePhase::kTokenize).count == 0);
+      }
+
+      THEN("Histograms are exported.") {
+        std::string json{observer.ToJson()};
+        CHECK(json.find("\"convert\": {\"count\": 4000, \"tokens\": 8000")
+              != std::string::npos);
+        CHECK(json.find("\"tokenize\": {\"count\": 0") != std::string::npos);
+      }
+
+      THEN("Histograms can be reset.") {
+        observer.Reset();
+        CHECK(observer.Histogram(ParsePhase::kConvert).count == 0);
+        CHECK(observer.Histogram(ParsePhase::kConvert).buckets[10] == 0);
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
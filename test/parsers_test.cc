@@ -978,6 +978,50 @@ SCENARIO("Test correctness of ParseArgs.", "[ParseArgs][correctness]") {
   }
 }
 
+SCENARIO("Test correctness of ParseArgs with abbreviations.",
+         "[ParseArgs][correctness]") {
+
+  GIVEN("An ArgumentMap allowing abbreviations.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"verbose", "v", "verbosely"}))
+                 (Parameter<bool>::Flag({"version"}))
+                 (Parameter<std::string>::Keyword(
+                      converters::StringIdentity, {"output", "o"}))
+                 (Parameter<std::string>::Keyword(
+                      converters::StringIdentity, {"out"}));
+    parameter_map.AllowAbbreviations();
+    ArgumentMap argument_map{std::move(parameter_map)};
+
+    WHEN("Unique prefixes of long names are parsed.") {
+      const int argc{5};
+      const char* argv[argc] = {"command", "--verb", "--vers", "--outp",
+                                "file"};
+      std::vector<std::string> additional{
+          ParseArgs(argc, argv, argument_map)};
+
+      THEN("They are resolved to the parameters with those names.") {
+        CHECK(additional.empty());
+        CHECK(argument_map.IsSet("verbose"));
+        CHECK(argument_map.IsSet("version"));
+        CHECK(argument_map.ArgumentsOf("output")
+              == std::vector<std::string>{"file"});
+      }
+    }
+
+    WHEN("A name which is also a prefix of other names is parsed.") {
+      const int argc{3};
+      const char* argv[argc] = {"command", "--out", "file"};
+      ParseArgs(argc, argv, argument_map);
+
+      THEN("The exact name takes precedence.") {
+        CHECK(argument_map.ArgumentsOf("out")
+              == std::vector<std::string>{"file"});
+        CHECK(argument_map.ArgumentsOf("output").empty());
+      }
+    }
+  }
+}
+
 SCENARIO("Test invariant preservation by ParseArgs.",
          "[ParseArgs][invariants]") {
 
@@ -1241,6 +1285,239 @@ SCENARIO("Test exceptions thrown by ParseArgs.",
   }
 }
 
+SCENARIO("Test exceptions thrown by ParseArgs with abbreviations.",
+         "[ParseArgs][exceptions]") {
+
+  GIVEN("An ArgumentMap with flags sharing prefixes.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"verbose"}))
+                 (Parameter<bool>::Flag({"version"}));
+
+    THEN("Prefixes cause exception unless abbreviations are allowed.") {
+      ArgumentMap argument_map{ParameterMap{parameter_map}};
+      const int argc{2};
+      const char* argv[argc] = {"command", "--verb"};
+      CHECK_THROWS_AS(ParseArgs(argc, argv, argument_map),
+                      exceptions::ArgumentParsingError);
+    }
+
+    THEN("Ambiguous prefixes cause exception listing the candidates.") {
+      parameter_map.AllowAbbreviations();
+      ArgumentMap argument_map{ParameterMap{parameter_map}};
+      const int argc{2};
+      const char* argv[argc] = {"command", "--ver"};
+      CHECK_THROWS_WITH(ParseArgs(argc, argv, argument_map),
+                        "Ambiguous argument: '--ver'. It abbreviates:"
+                        " '--verbose' '--version'.");
+    }
+  }
+
+  GIVEN("A positional and a keyword parameter whose names share a prefix.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Positional(converters::stoi, "input", 0))
+                 (Parameter<int>::Keyword(converters::stoi, {"include"}));
+    parameter_map.AllowAbbreviations();
+    ArgumentMap argument_map{std::move(parameter_map)};
+
+    THEN("Prefixes only abbreviate the keyword parameter.") {
+      const int argc{3};
+      const char* argv[argc] = {"command", "--in", "1"};
+      ParseArgs(argc, argv, argument_map);
+      CHECK(argument_map.ArgumentsOf("include")
+            == std::vector<std::string>{"1"});
+      CHECK_FALSE(argument_map.HasArgument("input"));
+    }
+
+    THEN("Prefixes of the positional parameter's name cause exception.") {
+      const int argc{3};
+      const char* argv_prefix[argc] = {"command", "--inp", "1"};
+      const char* argv_name[argc] = {"command", "--input", "1"};
+      CHECK_THROWS_WITH(ParseArgs(argc, argv_prefix, argument_map),
+                        "Invalid argument: '--inp'.");
+      CHECK_THROWS_AS(ParseArgs(argc, argv_name, argument_map),
+                      exceptions::ArgumentParsingError);
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by ParseArgs with subcommands.",
+         "[ParseArgs][exceptions]") {
+
+  GIVEN("An ArgumentMap whose parameters have subcommands.") {
+    ParameterMap parameter_map;
+    parameter_map.AddSubcommand("build", []() {return ParameterMap{};})
+                 .AddSubcommand("test", []() {return ParameterMap{};});
+    ArgumentMap argument_map{std::move(parameter_map)};
+
+    THEN("Reaching a different subcommand than before causes exception.") {
+      const int argc{2};
+      const char* argv_build[argc] = {"command", "build"};
+      const char* argv_test[argc] = {"command", "test"};
+      ParseArgs(argc, argv_build, argument_map);
+      CHECK_THROWS_WITH(ParseArgs(argc, argv_test, argument_map),
+                        "Subcommand 'test' follows subcommand 'build'.");
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by ParseArgs for misspelled names.",
+         "[ParseArgs][exceptions]") {
+
+  GIVEN("An ArgumentMap with flags, keyword and positional parameters.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"verbose"}))
+                 (Parameter<bool>::Flag({"version"}))
+                 (Parameter<std::string>::Keyword(converters::StringIdentity,
+                                                  {"output"}))
+                 (Parameter<std::string>::Positional(
+                      converters::StringIdentity, "input", 1));
+    ArgumentMap argument_map{std::move(parameter_map)};
+
+    THEN("Misspelled names cause exception suggesting the nearest names.") {
+      const int argc{2};
+      const char* argv[argc] = {"command", "--verison"};
+      CHECK_THROWS_WITH(ParseArgs(argc, argv, argument_map),
+                        "Invalid argument: '--verison'. Did you mean:"
+                        " '--version'?");
+      try {
+        ParseArgs(argc, argv, argument_map);
+      } catch (const exceptions::ArgumentParsingError& error) {
+        CHECK(error.suggestions() == std::vector<std::string>{"version"});
+      }
+    }
+
+    THEN("Names unlike any parameter's cause exception without suggestions.") {
+      const int argc{2};
+      const char* argv[argc] = {"command", "--quiet"};
+      CHECK_THROWS_WITH(ParseArgs(argc, argv, argument_map),
+                        "Invalid argument: '--quiet'.");
+      const char* argv_positional[argc] = {"command", "--inptu"};
+      CHECK_THROWS_WITH(ParseArgs(argc, argv_positional, argument_map),
+                        "Invalid argument: '--inptu'.");
+      try {
+        ParseArgs(argc, argv, argument_map);
+      } catch (const exceptions::ArgumentParsingError& error) {
+        CHECK(error.suggestions().empty());
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ParseArgs with subcommands.",
+         "[ParseArgs][correctness]") {
+
+  GIVEN("An ArgumentMap whose parameters have subcommands.") {
+    std::array<int, 3> num_calls{0, 0, 0};
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"verbose", "v"}))
+                 (Parameter<std::string>::Keyword(converters::StringIdentity,
+                                                  {"config"})
+                      .MaxArgs(1))
+                 .AddSubcommand("build", [&num_calls]() {
+                    ++num_calls.at(0);
+                    ParameterMap result;
+                    result(Parameter<bool>::Flag({"release", "v"}))
+                          (Parameter<std::string>::Positional(
+                               converters::StringIdentity, "target", 0)
+                               .MaxArgs(1));
+                    return result;
+                  })
+                 .AddSubcommand("remote", [&num_calls]() {
+                    ++num_calls.at(1);
+                    ParameterMap result;
+                    result.AddSubcommand("add", [&num_calls]() {
+                      ++num_calls.at(2);
+                      ParameterMap add;
+                      add(Parameter<std::string>::Positional(
+                              converters::StringIdentity, "url", 0));
+                      return add;
+                    });
+                    return result;
+                  });
+    ArgumentMap argument_map{std::move(parameter_map)};
+
+    WHEN("Arguments name no subcommand.") {
+      const int argc{3};
+      const char* argv[argc] = {"command", "-v", "other"};
+      std::vector<std::string> additional_args{
+          ParseArgs(argc, argv, argument_map)};
+
+      THEN("No subcommand's parameters are created.") {
+        CHECK_FALSE(argument_map.HasSubcommand());
+        CHECK(argument_map.IsSet("verbose"));
+        CHECK(additional_args == std::vector<std::string>{"other"});
+        CHECK(num_calls == std::array<int, 3>{0, 0, 0});
+        CHECK_THROWS_AS(argument_map.SubcommandArguments(),
+                        exceptions::ValueAccessError);
+      }
+    }
+
+    WHEN("Arguments name a subcommand.") {
+      const int argc{7};
+      const char* argv[argc] = {"command", "--config", "build", "build",
+                                "-v", "app", "extra"};
+      std::vector<std::string> additional_args{
+          ParseArgs(argc, argv, argument_map)};
+
+      THEN("Arguments following it are parsed for its parameters only.") {
+        CHECK(argument_map.ArgumentsOf("config")
+              == std::vector<std::string>{"build"});
+        CHECK_FALSE(argument_map.IsSet("verbose"));
+        REQUIRE(argument_map.HasSubcommand());
+        CHECK(argument_map.SubcommandName() == "build");
+        const ArgumentMap& build{argument_map.SubcommandArguments()};
+        CHECK(build.IsSet("release"));
+        CHECK(build.GetValue<std::string>("target") == "app");
+        CHECK(additional_args == std::vector<std::string>{"extra"});
+        CHECK(num_calls == std::array<int, 3>{1, 0, 0});
+      }
+
+      THEN("Parsing the subcommand again adds to its arguments.") {
+        const int argc_again{3};
+        const char* argv_again[argc_again] = {"command", "build", "more"};
+        CHECK(ParseArgs(argc_again, argv_again, argument_map)
+              == std::vector<std::string>{"more"});
+        CHECK(num_calls == std::array<int, 3>{1, 0, 0});
+      }
+
+      THEN("Copies have their own copies of the subcommand's arguments.") {
+        ArgumentMap copy{argument_map};
+        copy.SubcommandArguments().AddArgument("target", "other");
+        CHECK(argument_map.SubcommandArguments().ArgumentsOf("target")
+              == std::vector<std::string>{"app"});
+      }
+    }
+
+    WHEN("Arguments name nested subcommands.") {
+      const int argc{4};
+      const char* argv[argc] = {"command", "remote", "add", "url"};
+      ParseArgs(argc, argv, argument_map);
+
+      THEN("Each level is parsed for its own parameters.") {
+        REQUIRE(argument_map.HasSubcommand());
+        const ArgumentMap& remote{argument_map.SubcommandArguments()};
+        REQUIRE(remote.HasSubcommand());
+        CHECK(remote.SubcommandName() == "add");
+        CHECK(remote.SubcommandArguments().GetValue<std::string>("url")
+              == "url");
+        CHECK(num_calls == std::array<int, 3>{0, 1, 1});
+      }
+    }
+
+    WHEN("The name of a subcommand follows the argument separator.") {
+      const int argc{3};
+      const char* argv[argc] = {"command", "--", "build"};
+
+      THEN("It is not a subcommand.") {
+        CHECK(ParseArgs(argc, argv, argument_map)
+              == std::vector<std::string>{"build"});
+        CHECK_FALSE(argument_map.HasSubcommand());
+        CHECK(num_calls == std::array<int, 3>{0, 0, 0});
+      }
+    }
+  }
+}
+
 SCENARIO("Test correctness of ParseFile.", "[ParseFile][correctness]") {
 
   GIVEN("An ArgumentMap with flags.") {
@@ -1954,6 +2231,14 @@ SCENARIO("Test exceptions thrown by ParseFile.", "[ParseFile][exceptions]") {
                       exceptions::ArgumentParsingError);
     }
 
+    THEN("Misspelled parameter name causes exception with suggestions.") {
+      std::istringstream iss{"kwarg_to_max=arg"};
+      CHECK_THROWS_WITH(ParseFile(iss, argument_map),
+                        "Unknown parameter name in configuration file. Row:"
+                        " '1', name: 'kwarg_to_max'. Did you mean:"
+                        " 'kwarg_no_max', 'kwarg_two_max'?");
+    }
+
     THEN("Parameter name without argument list causes exception.") {
       std::istringstream iss1{"kwarg_two_max="};
       std::istringstream iss2{"pos_no_max="};
@@ -0,0 +1,169 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "perf_counters.h"
+
+#include "argument_map.h"
+#include "parameter_map.h"
+#include "parsers.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compiled with `ARG_PARSE_CONVERT_PERF_COUNTERS` defined.
+//
+// Test correctness for:
+// * SnapshotPerfCounters
+// * PerfCounterSnapshot::operator[]
+// * PerfCounterSnapshot::operator-
+// * PerfCounterName
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+ParameterMap MakeParameterMap() {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<bool>::Flag({"v"}))
+               (Parameter<int>::Keyword(converters::stoi, {"n"}).MaxArgs(0));
+  return parameter_map;
+}
+
+SCENARIO("Test correctness of performance counters.",
+         "[PerfCounters][correctness]") {
+  REQUIRE(kPerfCountersEnabled);
+
+  GIVEN("An ArgumentMap object with parsed arguments.") {
+    ArgumentMap argument_map{MakeParameterMap()};
+    const char* argv[]{"command", "-n", "1", "x", "3"};
+    ParseArgs(5, argv, argument_map);
+    const std::string name{"n"}, unknown{"unknown"};
+
+    WHEN("Parameters are looked up by name.") {
+      PerfCounterSnapshot before{SnapshotPerfCounters()};
+      argument_map.Parameters().Contains(name);
+      argument_map.Parameters().IsFlag(unknown);
+      argument_map.Parameters().IsKeyword(name);
+      argument_map.Parameters().GetId(name);
+      PerfCounterSnapshot counts{SnapshotPerfCounters() - before};
+
+      THEN("Each lookup is counted.") {
+        CHECK(counts[PerfCounter::kLookups] == 4);
+        CHECK(counts[PerfCounter::kConversions] == 0);
+      }
+    }
+
+    WHEN("A configuration file is parsed.") {
+      std::stringstream config{"v=true\nn=2\n# Comment.\n"};
+      PerfCounterSnapshot before{SnapshotPerfCounters()};
+      ParseFile(config, argument_map);
+      PerfCounterSnapshot counts{SnapshotPerfCounters() - before};
+
+      THEN("One lookup is counted per line naming a parameter.") {
+        CHECK(counts[PerfCounter::kLookups] == 2);
+      }
+    }
+
+    WHEN("A value is accessed repeatedly.") {
+      PerfCounterSnapshot before{SnapshotPerfCounters()};
+      argument_map.GetValue<int>(name, 0);
+      argument_map.GetValue<int>(name, 0);
+      argument_map.GetValue<int>(name, 0);
+      PerfCounterSnapshot counts{SnapshotPerfCounters() - before};
+
+      THEN("One miss, one conversion and the remaining hits are counted.") {
+        CHECK(counts[PerfCounter::kCacheMisses] == 1);
+        CHECK(counts[PerfCounter::kConversions] == 1);
+        CHECK(counts[PerfCounter::kCacheHits] == 2);
+        CHECK(counts[PerfCounter::kConversionFailures] == 0);
+        CHECK(counts[PerfCounter::kLookups] == 3);
+      }
+    }
+
+    WHEN("A conversion fails.") {
+      PerfCounterSnapshot before{SnapshotPerfCounters()};
+      CHECK_THROWS(argument_map.GetValue<int>(name, 1));
+      CHECK_THROWS(argument_map.ConvertAll());
+      PerfCounterSnapshot counts{SnapshotPerfCounters() - before};
+
+      THEN("Each failed call is counted, as are the library exceptions.") {
+        CHECK(counts[PerfCounter::kConversions] == 4);
+        CHECK(counts[PerfCounter::kConversionFailures] == 2);
+        CHECK(counts[PerfCounter::kExceptions] == 1);
+      }
+    }
+
+    WHEN("Library exceptions are thrown.") {
+      PerfCounterSnapshot before{SnapshotPerfCounters()};
+      CHECK_THROWS_AS(argument_map.Parameters().GetId(unknown),
+                      exceptions::ParameterAccessError);
+      CHECK_THROWS_AS(argument_map.IsSet(name),
+                      exceptions::ValueAccessError);
+      PerfCounterSnapshot counts{SnapshotPerfCounters() - before};
+
+      THEN("They are counted.") {
+        CHECK(counts[PerfCounter::kExceptions] == 2);
+      }
+    }
+
+    WHEN("Values are accessed from several threads.") {
+      constexpr int kNumThreads{20};
+      PerfCounterSnapshot before{SnapshotPerfCounters()};
+      std::vector<std::thread> threads;
+      for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&argument_map] {
+          argument_map.GetValue<int>("n", 2);
+        });
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+      PerfCounterSnapshot counts{SnapshotPerfCounters() - before};
+
+      THEN("The counts of all threads are summed.") {
+        CHECK(counts[PerfCounter::kConversions] == 1);
+        CHECK(counts[PerfCounter::kCacheHits]
+              + counts[PerfCounter::kCacheMisses] == kNumThreads);
+      }
+    }
+  }
+
+  GIVEN("The counters.") {
+    THEN("Each has a name.") {
+      CHECK(std::string{PerfCounterName(PerfCounter::kLookups)} == "lookups");
+      CHECK(std::string{PerfCounterName(PerfCounter::kExceptions)}
+            == "exceptions");
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
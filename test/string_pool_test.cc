@@ -0,0 +1,172 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "string_pool.h"
+#include "parameter_map.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include "string_conversions.h" // include after catch.h
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Test correctness for:
+// * StringPool::Intern
+// * StringPool::size
+// * ParameterMap::strings
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+SCENARIO("Test correctness of StringPool::Intern.",
+         "[StringPool][Intern][correctness]") {
+
+  GIVEN("An empty `StringPool` object.") {
+    StringPool pool;
+
+    WHEN("Strings are interned.") {
+      std::string long_string(10000, 'x');
+      std::vector<std::string> strings{"a", "b", "parameter", long_string};
+      std::vector<std::string_view> views;
+      for (const std::string& s : strings) {
+        views.push_back(pool.Intern(s));
+      }
+
+      THEN("The views equal the strings, but do not refer to them.") {
+        REQUIRE(pool.size() == strings.size());
+        for (std::size_t i = 0; i < strings.size(); ++i) {
+          CHECK(views.at(i) == strings.at(i));
+          CHECK(views.at(i).data() != strings.at(i).data());
+        }
+      }
+
+      THEN("Interning equal strings returns the same views.") {
+        for (std::size_t i = 0; i < strings.size(); ++i) {
+          std::string copy{strings.at(i)};
+          CHECK(pool.Intern(copy).data() == views.at(i).data());
+        }
+        CHECK(pool.size() == strings.size());
+      }
+
+      THEN("The views remain valid while many more strings are interned.") {
+        for (int i = 0; i < 10000; ++i) {
+          pool.Intern("name_" + std::to_string(i));
+        }
+        for (std::size_t i = 0; i < strings.size(); ++i) {
+          CHECK(views.at(i) == strings.at(i));
+        }
+      }
+    }
+
+    WHEN("Several threads intern the same strings.") {
+      std::vector<std::vector<std::string_view>> views(4);
+      std::vector<std::thread> threads;
+      for (auto& thread_views : views) {
+        threads.emplace_back([&pool, &thread_views] {
+          for (int i = 0; i < 1000; ++i) {
+            thread_views.push_back(pool.Intern("name_" + std::to_string(i)));
+          }
+        });
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+
+      THEN("Each string is stored once.") {
+        CHECK(pool.size() == 1000);
+        for (const auto& thread_views : views) {
+          CHECK(thread_views == views.front());
+          for (std::size_t i = 0; i < thread_views.size(); ++i) {
+            CHECK(thread_views.at(i).data() == views.front().at(i).data());
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Test correctness of ParameterMap::strings.",
+         "[ParameterMap][strings][correctness]") {
+
+  GIVEN("A `StringPool` object shared by two `ParameterMap` objects.") {
+    auto pool = std::make_shared<StringPool>();
+    ParameterMap first{pool}, second{pool};
+    auto factory = []() {return ParameterMap{};};
+
+    WHEN("Subcommands with equal names are registered with both.") {
+      first.AddSubcommand("build", factory).AddSubcommand("test", factory);
+      second.AddSubcommand("test", factory).AddSubcommand("run", factory);
+
+      THEN("Each name is stored once.") {
+        CHECK(first.strings() == pool);
+        CHECK(second.strings() == pool);
+        CHECK(pool->size() == 3);
+        CHECK(first.SubcommandName(1).data()
+              == second.SubcommandName(0).data());
+      }
+    }
+
+    WHEN("Parameters are registered with both.") {
+      first(Parameter<int>::Keyword(converters::stoi, {"n", "number"}));
+      second(Parameter<bool>::Flag({"a_name_too_long_to_be_stored_inline"}));
+
+      THEN("Their names are not interned.") {
+        CHECK(pool->size() == 0);
+        CHECK(first.GetId("number") == 0);
+        CHECK(second.GetId("a_name_too_long_to_be_stored_inline") == 0);
+      }
+    }
+  }
+
+  GIVEN("A `ParameterMap` object containing a parameter.") {
+    ParameterMap parameter_map;
+    CHECK(parameter_map.strings() == nullptr);
+    parameter_map(Parameter<int>::Keyword(
+        converters::stoi, {"n", "a_name_too_long_to_be_stored_inline"}));
+
+    WHEN("It is copied.") {
+      ParameterMap copy{parameter_map};
+      copy(Parameter<bool>::Flag({"v"}));
+
+      THEN("The copy shares the names.") {
+        CHECK(copy.strings() == nullptr);
+        CHECK(copy.GetConfiguration(0).names().at(1).data()
+              == parameter_map.GetConfiguration(0).names().at(1).data());
+        CHECK(copy.GetId("a_name_too_long_to_be_stored_inline") == 0);
+        CHECK_FALSE(parameter_map.Contains("v"));
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
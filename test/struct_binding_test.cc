@@ -0,0 +1,185 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "struct_binding.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include "string_conversions.h" // include after catch.h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Test correctness for:
+// * operator()
+// * Bind
+//
+// Test exceptions for:
+// * operator()
+// * Bind
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+struct Options {
+  bool verbose{false};
+  int count{1};
+  double ratio{0.5};
+  std::string output{"out"};
+  std::vector<std::string> inputs;
+  int unbound{7};
+};
+
+void RegisterOptions(ParameterMap& parameter_map,
+                     StructBinding<Options>& binding) {
+  binding(&Options::verbose, Parameter<bool>::Flag({"verbose", "v"}))
+         (&Options::count, Parameter<int>::Keyword(converters::stoi,
+                                                   {"count", "c"}))
+         (&Options::ratio, Parameter<double>::Keyword(converters::stod,
+                                                      {"ratio"}))
+         (&Options::output, Parameter<std::string>::Positional(
+                                converters::StringIdentity, "output", 0))
+         (&Options::inputs, Parameter<std::string>::Positional(
+                                converters::StringIdentity, "inputs", 1));
+}
+
+SCENARIO("Test correctness of StructBinding::operator().",
+         "[StructBinding][operator()][correctness]") {
+
+  GIVEN("An empty `ParameterMap` object.") {
+    ParameterMap parameter_map;
+    StructBinding<Options> binding{parameter_map};
+
+    WHEN("Data members are bound.") {
+      RegisterOptions(parameter_map, binding);
+
+      THEN("The parameters are registered.") {
+        CHECK(binding.size() == 5);
+        CHECK(parameter_map.size() == 5);
+        CHECK(parameter_map.GetId("verbose") == 0);
+        CHECK(parameter_map.GetId("c") == 1);
+        CHECK(parameter_map.GetId("inputs") == 4);
+      }
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by StructBinding::operator().",
+         "[StructBinding][operator()][exceptions]") {
+
+  GIVEN("A `ParameterMap` object with bound data members.") {
+    ParameterMap parameter_map;
+    StructBinding<Options> binding{parameter_map};
+    RegisterOptions(parameter_map, binding);
+
+    THEN("Registering an invalid parameter causes exception.") {
+      CHECK_THROWS_AS(binding(&Options::unbound, Parameter<int>::Keyword(
+                                  converters::stoi, {"count"})),
+                      exceptions::ParameterRegistrationError);
+      CHECK(binding.size() == 5);
+      CHECK(parameter_map.size() == 5);
+    }
+  }
+}
+
+SCENARIO("Test correctness of StructBinding::Bind.",
+         "[StructBinding][Bind][correctness]") {
+
+  GIVEN("An `ArgumentMap` object for parameters bound to data members.") {
+    ParameterMap parameter_map;
+    StructBinding<Options> binding{parameter_map};
+    RegisterOptions(parameter_map, binding);
+    ArgumentMap argument_map{std::move(parameter_map)};
+
+    WHEN("No arguments were given.") {
+      Options options{binding.Bind(argument_map)};
+
+      THEN("All data members keep their initial values.") {
+        CHECK_FALSE(options.verbose);
+        CHECK(options.count == 1);
+        CHECK(options.ratio == 0.5);
+        CHECK(options.output == "out");
+        CHECK(options.inputs.empty());
+        CHECK(options.unbound == 7);
+      }
+    }
+
+    WHEN("Arguments were given.") {
+      argument_map.AddArgument("v", "");
+      argument_map.AddArgument("count", "3");
+      argument_map.AddArgument("output", "result.txt");
+      argument_map.AddArgument("inputs", "a.txt");
+      argument_map.AddArgument("inputs", "b.txt");
+      Options initial;
+      initial.ratio = 0.25;
+      initial.unbound = 8;
+      Options options{binding.Bind(argument_map, initial)};
+
+      THEN("Bound data members are set to the parameters' values.") {
+        CHECK(options.verbose);
+        CHECK(options.count == 3);
+        CHECK(options.output == "result.txt");
+        CHECK(options.inputs == std::vector<std::string>{"a.txt", "b.txt"});
+      }
+
+      THEN("Other data members are taken from the initial object.") {
+        CHECK(options.ratio == 0.25);
+        CHECK(options.unbound == 8);
+      }
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by StructBinding::Bind.",
+         "[StructBinding][Bind][exceptions]") {
+
+  GIVEN("Parameters bound to data members.") {
+    ParameterMap parameter_map;
+    StructBinding<Options> binding{parameter_map};
+    RegisterOptions(parameter_map, binding);
+
+    THEN("Binding arguments of other parameters causes exception.") {
+      ParameterMap other;
+      other(Parameter<bool>::Flag({"verbose"}));
+      CHECK_THROWS_AS(binding.Bind(ArgumentMap{std::move(other)}),
+                      exceptions::ParameterAccessError);
+      CHECK_THROWS_AS(binding.Bind(ArgumentMap{ParameterMap{}}),
+                      exceptions::ParameterAccessError);
+    }
+
+    THEN("Failed conversions cause exception.") {
+      ArgumentMap argument_map{std::move(parameter_map)};
+      argument_map.AddArgument("count", "three");
+      CHECK_THROWS_AS(binding.Bind(argument_map), std::invalid_argument);
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
@@ -0,0 +1,173 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "suggestion_index.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Test correctness for:
+// * EditDistance
+// * SuggestionIndex::Nearest
+// * LazyShared::Publish
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+using internal::EditDistance;
+using internal::LazySuggestionIndex;
+using internal::SuggestionIndex;
+
+SCENARIO("Test correctness of EditDistance.",
+         "[EditDistance][correctness]") {
+
+  GIVEN("Pairs of strings.") {
+
+    THEN("Insertions, deletions, substitutions and transpositions count as "
+         "one edit each.") {
+      CHECK(EditDistance("verbose", "verbose", 2) == 0);
+      CHECK(EditDistance("verbose", "verbse", 2) == 1);
+      CHECK(EditDistance("verbose", "verbosee", 2) == 1);
+      CHECK(EditDistance("verbose", "varbose", 2) == 1);
+      CHECK(EditDistance("verbose", "vebrose", 2) == 1);
+      CHECK(EditDistance("verbose", "vebrse", 2) == 2);
+      CHECK(EditDistance("", "ab", 2) == 2);
+    }
+
+    THEN("Distances over the limit are reported as the limit plus one.") {
+      CHECK(EditDistance("verbose", "version", 2) == 3);
+      CHECK(EditDistance("verbose", "v", 1) == 2);
+      CHECK(EditDistance("abcdef", "badcfe", 2) == 3);
+    }
+  }
+}
+
+SCENARIO("Test correctness of SuggestionIndex::Nearest.",
+         "[SuggestionIndex][Nearest][correctness]") {
+
+  GIVEN("An index over several names.") {
+    std::vector<std::string> names{"verbose", "version", "verify", "output",
+                                   "input", "in", "level", "levels"};
+    SuggestionIndex index{std::vector<std::string_view>(names.begin(),
+                                                        names.end())};
+
+    THEN("Names within the distance are returned, nearest first.") {
+      CHECK(index.size() == names.size());
+      CHECK(index.Nearest("verbos", 3, 2)
+            == std::vector<std::string>{"verbose"});
+      CHECK(index.Nearest("outptu", 3, 2)
+            == std::vector<std::string>{"output"});
+      CHECK(index.Nearest("levl", 3, 1)
+            == std::vector<std::string>{"level"});
+      CHECK(index.Nearest("levle", 3, 2)
+            == std::vector<std::string>{"level"});
+      CHECK(index.Nearest("versoin", 3, 2)
+            == std::vector<std::string>{"version"});
+    }
+
+    THEN("Equally near names are returned in lexicographic order.") {
+      CHECK(index.Nearest("levele", 3, 2)
+            == std::vector<std::string>{"level", "levels"});
+      CHECK(index.Nearest("i", 3, 1)
+            == std::vector<std::string>{"in"});
+      CHECK(index.Nearest("ver", 3, 2).empty());
+    }
+
+    THEN("At most the requested number of names is returned.") {
+      CHECK(index.Nearest("levelx", 1, 2)
+            == std::vector<std::string>{"level"});
+      CHECK(index.Nearest("levelx", 0, 2).empty());
+    }
+
+    THEN("Names farther away are not returned.") {
+      CHECK(index.Nearest("quiet", 3, 2).empty());
+      CHECK(index.Nearest("verbose", 3, 0)
+            == std::vector<std::string>{"verbose"});
+      CHECK(index.Nearest("verbse", 3, 0).empty());
+    }
+  }
+
+  GIVEN("An index over many names.") {
+    std::vector<std::string> names;
+    for (int i = 0; i < 5000; ++i) {
+      names.push_back("parameter-" + std::to_string(i) + "-name");
+    }
+    SuggestionIndex index{std::vector<std::string_view>(names.begin(),
+                                                        names.end())};
+
+    THEN("Misspelled names are matched to the nearest names.") {
+      CHECK(index.Nearest("parmaeter-1234-name", 1, 2)
+            == std::vector<std::string>{"parameter-1234-name"});
+      CHECK(index.Nearest("parameter-4999-nmae", 1, 2)
+            == std::vector<std::string>{"parameter-4999-name"});
+      CHECK(index.Nearest("parameter-77-nam", 3, 1)
+            == std::vector<std::string>{"parameter-77-name"});
+    }
+  }
+}
+
+SCENARIO("Test correctness of LazyShared::Publish.",
+         "[LazyShared][Publish][correctness]") {
+
+  GIVEN("An empty `LazySuggestionIndex` object.") {
+    LazySuggestionIndex lazy_index;
+
+    THEN("No index is held.") {
+      CHECK(lazy_index.Get() == nullptr);
+    }
+
+    WHEN("Two indices are published.") {
+      auto first = std::make_shared<const SuggestionIndex>(
+          std::vector<std::string_view>{"a"});
+      auto second = std::make_shared<const SuggestionIndex>(
+          std::vector<std::string_view>{"b"});
+
+      THEN("The first one is kept.") {
+        CHECK(lazy_index.Publish(first) == first);
+        CHECK(lazy_index.Publish(second) == first);
+        CHECK(lazy_index.Get() == first);
+      }
+
+      THEN("Copies share the index until it is reset.") {
+        lazy_index.Publish(first);
+        LazySuggestionIndex copy{lazy_index};
+        CHECK(copy.Get() == first);
+        copy.Reset();
+        CHECK(copy.Get() == nullptr);
+        CHECK(lazy_index.Get() == first);
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
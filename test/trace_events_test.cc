@@ -0,0 +1,196 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "trace_events.h"
+
+#include "argument_map.h"
+#include "help_string_formatters.h"
+#include "parameter_map.h"
+#include "parsers.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Compiled with `ARG_PARSE_CONVERT_TRACE_EVENTS` defined.
+//
+// Test correctness for:
+// * TraceEventScope
+// * FlushTraceEvents
+// * Recycling buffers of exited threads
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+// Returns the number of non-overlapping occurrences of `pattern` in `s`.
+//
+int Count(const std::string& s, const std::string& pattern) {
+  int result{0};
+  for (auto pos = s.find(pattern); pos != std::string::npos;
+       pos = s.find(pattern, pos + pattern.size())) {
+    ++result;
+  }
+  return result;
+}
+
+std::string Flush() {
+  std::ostringstream oss;
+  FlushTraceEvents(oss);
+  return oss.str();
+}
+
+SCENARIO("Test correctness of trace events.", "[TraceEvents][correctness]") {
+  REQUIRE(kTraceEventsEnabled);
+  Flush();
+
+  GIVEN("Arguments parsed and converted.") {
+    ParameterMap parameter_map;
+    parameter_map(Parameter<int>::Keyword(converters::stoi, {"num"})
+                      .Description("A number."));
+    std::string help{FormattedHelpString(parameter_map, "header", "footer")};
+    ArgumentMap argument_map{std::move(parameter_map)};
+    const char* argv[]{"command", "--num", "42"};
+    ParseArgs(3, argv, argument_map);
+    std::istringstream iss{"num=7"};
+    ParseFile(iss, argument_map);
+    argument_map.GetValue<int>("num");
+    argument_map.GetValue<int>("num");
+
+    WHEN("The trace events are flushed.") {
+      std::string trace{Flush()};
+
+      THEN("One complete event is written per span.") {
+        CHECK(trace.find("\"traceEvents\": [") != std::string::npos);
+        CHECK(Count(trace, "\"ph\": \"X\"") == 6);
+        CHECK(Count(trace, "\"name\": \"FormattedHelpString\"") == 1);
+        CHECK(Count(trace, "\"name\": \"ParseArgs\"") == 1);
+        CHECK(Count(trace, "\"name\": \"ParseFile\"") == 1);
+        CHECK(Count(trace, "\"name\": \"AssignArguments\"") == 2);
+        CHECK(Count(trace, "\"name\": \"Convert\", ") == 1);
+        CHECK(Count(trace, "\"args\": {\"detail\": \"num\"}") == 1);
+        CHECK(Count(trace, "\"dropped_events\": 0") == 1);
+      }
+
+      AND_WHEN("They are flushed again.") {
+        std::string second_trace{Flush()};
+
+        THEN("No event is written twice.") {
+          CHECK(Count(second_trace, "\"ph\": \"X\"") == 0);
+        }
+      }
+    }
+  }
+
+  GIVEN("Events recorded by two threads.") {
+    {
+      TraceEventScope trace_event{"main_thread"};
+    }
+    std::thread thread{[] {
+      TraceEventScope trace_event{"other_thread"};
+    }};
+    thread.join();
+
+    WHEN("The trace events are flushed.") {
+      std::string trace{Flush()};
+
+      THEN("The events of both threads are written with distinct ids.") {
+        auto main_pos = trace.find("\"main_thread\"");
+        auto other_pos = trace.find("\"other_thread\"");
+        REQUIRE(main_pos != std::string::npos);
+        REQUIRE(other_pos != std::string::npos);
+        auto main_tid = trace.substr(trace.find("\"tid\": ", main_pos), 10);
+        auto other_tid = trace.substr(trace.find("\"tid\": ", other_pos), 10);
+        CHECK(main_tid != other_tid);
+      }
+    }
+  }
+
+  GIVEN("Threads recording events one after another.") {
+    internal::TraceEventBuffer* first_buffer{nullptr};
+    internal::TraceEventBuffer* second_buffer{nullptr};
+    std::thread first{[&first_buffer] {
+      TraceEventScope trace_event{"first_thread"};
+      first_buffer = &internal::ThreadTraceEventBuffer();
+    }};
+    first.join();
+    std::thread second{[&second_buffer] {
+      TraceEventScope trace_event{"second_thread"};
+      second_buffer = &internal::ThreadTraceEventBuffer();
+    }};
+    second.join();
+
+    WHEN("The trace events are flushed.") {
+      std::string trace{Flush()};
+
+      THEN("The buffer of the exited thread is reused.") {
+        CHECK(first_buffer == second_buffer);
+        CHECK(Count(trace, "\"name\": \"first_thread\"") == 1);
+        CHECK(Count(trace, "\"name\": \"second_thread\"") == 1);
+      }
+    }
+  }
+
+  GIVEN("More events than a buffer holds.") {
+    std::size_t capacity{internal::TraceEventBuffer::kCapacity};
+    for (std::size_t i = 0; i < capacity + 10; ++i) {
+      TraceEventScope trace_event{"event"};
+    }
+
+    WHEN("The trace events are flushed.") {
+      std::string trace{Flush()};
+
+      THEN("The oldest events are dropped.") {
+        CHECK(Count(trace, "\"name\": \"event\"")
+              == static_cast<int>(capacity));
+        CHECK(Count(trace, "\"dropped_events\": 10") == 1);
+      }
+    }
+  }
+
+  GIVEN("An event with a long detail containing quotes.") {
+    std::string detail{"\"quoted\" and longer than thirty-one characters"};
+    {
+      TraceEventScope trace_event{"detailed", &detail};
+    }
+
+    WHEN("The trace events are flushed.") {
+      std::string trace{Flush()};
+
+      THEN("The detail is escaped and truncated.") {
+        CHECK(Count(trace,
+                    "{\"detail\": \"\\\"quoted\\\" and longer than thirty\"}")
+              == 1);
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert
@@ -0,0 +1,282 @@
+// Copyright (c) 2020 Jasper Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "trace.h"
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_COLOUR_NONE
+#include "catch.h"
+
+#include <array>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "parsers.h"
+
+// Test correctness for:
+// * TraceWriter and TraceReader
+// * SerializeSchema and DeserializeSchema
+// * Capturing inputs of ParseArgs and ParseFile
+//
+// Test exceptions for:
+// * TraceReader
+// * SerializeSchema and TraceWriter::WriteSchema
+// * DeserializeSchema
+
+namespace arg_parse_convert {
+
+namespace test {
+
+namespace {
+
+ParameterMap MakeParameters() {
+  ParameterMap parameter_map;
+  parameter_map(Parameter<int>::Positional(converters::stoi, "pos", 0)
+                    .MinArgs(1).MaxArgs(2).Description("Positional.")
+                    .Placeholder("N").AddDefault("1"))
+               (Parameter<int>::Keyword(converters::stoi, {"key", "k"})
+                    .MaxArgs(3).AddDefault("2").AddDefault("3"))
+               (Parameter<bool>::Flag({"flag", "f"}).Description("Flag."));
+  return parameter_map;
+}
+
+SCENARIO("Test correctness of TraceWriter and TraceReader.",
+         "[TraceWriter][TraceReader][correctness]") {
+
+  GIVEN("A trace with records of all kinds.") {
+    std::stringstream trace;
+    TraceWriter writer{trace};
+    std::array<const char*, 3> argv{"command", "--key", "1"};
+    std::string long_token(300, 'x');
+    writer.WriteSchema(MakeParameters());
+    writer.WriteArguments(argv.size(), argv.data());
+    writer.Write(TraceRecordKind::kFile, {"key=1", "", long_token});
+    writer.Write(TraceRecordKind::kArguments, {});
+
+    WHEN("The trace is read.") {
+      TraceReader reader{trace};
+      TraceRecord record;
+
+      THEN("All records are read in order.") {
+        REQUIRE(reader.Next(record));
+        CHECK(record.kind == TraceRecordKind::kSchema);
+        CHECK(record.tokens == SerializeSchema(MakeParameters()));
+        REQUIRE(reader.Next(record));
+        CHECK(record.kind == TraceRecordKind::kArguments);
+        CHECK(record.tokens
+              == std::vector<std::string>{"command", "--key", "1"});
+        REQUIRE(reader.Next(record));
+        CHECK(record.kind == TraceRecordKind::kFile);
+        CHECK(record.tokens
+              == std::vector<std::string>{"key=1", "", long_token});
+        REQUIRE(reader.Next(record));
+        CHECK(record.tokens.empty());
+        CHECK_FALSE(reader.Next(record));
+      }
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by TraceReader.",
+         "[TraceReader][exceptions]") {
+
+  THEN("Missing headers cause exception.") {
+    std::stringstream empty, other{"APCX\x01"}, version{"APCT\x02"};
+    CHECK_THROWS_AS(TraceReader{empty}, exceptions::TraceFormatError);
+    CHECK_THROWS_AS(TraceReader{other}, exceptions::TraceFormatError);
+    CHECK_THROWS_AS(TraceReader{version}, exceptions::TraceFormatError);
+  }
+
+  THEN("Truncated records cause exception.") {
+    std::stringstream trace;
+    TraceWriter writer{trace};
+    writer.Write(TraceRecordKind::kArguments, {"command", "argument"});
+    std::string bytes{trace.str()};
+    std::stringstream truncated{bytes.substr(0, bytes.size() - 1)};
+    TraceReader reader{truncated};
+    TraceRecord record;
+    CHECK_THROWS_AS(reader.Next(record), exceptions::TraceFormatError);
+  }
+
+  THEN("Malformed token counts and lengths cause exception.") {
+    TraceRecord record;
+    // A token length of 2^63 followed by a few bytes.
+    std::stringstream length{std::string{"APCT\x01\x00\x01", 7}
+                             + "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x01"
+                             + "abc"};
+    TraceReader length_reader{length};
+    CHECK_THROWS_WITH(length_reader.Next(record), "Truncated trace record.");
+    // A token count of 2^63 followed by one empty token.
+    std::stringstream count{std::string{"APCT\x01\x00", 6}
+                            + "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x01"
+                            + std::string(1, '\0')};
+    TraceReader count_reader{count};
+    CHECK_THROWS_WITH(count_reader.Next(record), "Truncated trace record.");
+    // A length varint longer than 64 bits.
+    std::stringstream overflow{std::string{"APCT\x01\x00\x01", 7}
+                               + std::string(10, '\xff') + "\x01"};
+    TraceReader overflow_reader{overflow};
+    CHECK_THROWS_AS(overflow_reader.Next(record),
+                    exceptions::TraceFormatError);
+  }
+}
+
+SCENARIO("Test correctness of SerializeSchema and DeserializeSchema.",
+         "[SerializeSchema][DeserializeSchema][correctness]") {
+
+  GIVEN("A `ParameterMap` object.") {
+    ParameterMap parameter_map{MakeParameters()};
+
+    WHEN("It is serialized and deserialized.") {
+      ParameterMap result{DeserializeSchema(SerializeSchema(parameter_map))};
+
+      THEN("The configurations are the same.") {
+        REQUIRE(result.size() == parameter_map.size());
+        for (ParameterMap::size_type id = 0; id < result.size(); ++id) {
+          CHECK(result.GetConfiguration(id)
+                == parameter_map.GetConfiguration(id));
+        }
+      }
+
+      THEN("Arguments are converted to strings.") {
+        ArgumentMap argument_map{std::move(result)};
+        argument_map.AddArgument("k", "42");
+        CHECK(argument_map.GetValue<std::string>("key") == "42");
+      }
+    }
+  }
+
+  GIVEN("A `ParameterMap` object with provided help text.") {
+    int num_calls{0};
+    ParameterMap parameter_map;
+    parameter_map(Parameter<bool>::Flag({"flag"})
+                      .Description([&num_calls]() {
+                        ++num_calls;
+                        return std::string{"Flag."};
+                      }));
+
+    THEN("The text is left out without calling its provider.") {
+      ParameterMap result{DeserializeSchema(SerializeSchema(parameter_map))};
+      CHECK(num_calls == 0);
+      CHECK(result.GetConfiguration(0).description().empty());
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by SerializeSchema.",
+         "[SerializeSchema][exceptions]") {
+
+  GIVEN("A `ParameterMap` object with a subcommand.") {
+    ParameterMap parameter_map{MakeParameters()};
+    parameter_map.AddSubcommand("build", []() {return MakeParameters();});
+
+    THEN("Capturing its schema causes exception.") {
+      CHECK_THROWS_WITH(SerializeSchema(parameter_map),
+                        "Unable to capture schema with 1 subcommand(s):"
+                        " traces cannot represent subcommands.");
+      std::stringstream trace;
+      TraceWriter writer{trace};
+      CHECK_THROWS_AS(writer.WriteSchema(parameter_map),
+                      exceptions::TraceFormatError);
+    }
+  }
+}
+
+SCENARIO("Test exceptions thrown by DeserializeSchema.",
+         "[DeserializeSchema][exceptions]") {
+
+  THEN("Malformed schemas cause exception.") {
+    std::vector<std::string> tokens{SerializeSchema(MakeParameters())};
+    CHECK_THROWS_AS(DeserializeSchema({tokens.begin(), tokens.end() - 1}),
+                    exceptions::TraceFormatError);
+    tokens[0] = "unknown";
+    CHECK_THROWS_AS(DeserializeSchema(tokens), exceptions::TraceFormatError);
+    tokens[0] = "positional";
+    tokens[1] = "x";
+    CHECK_THROWS_AS(DeserializeSchema(tokens), exceptions::TraceFormatError);
+    CHECK_THROWS_AS(DeserializeSchema({"keyword", "0", "0", "0", "", "", "0",
+                                       "0"}),
+                    exceptions::TraceFormatError);
+  }
+}
+
+SCENARIO("Test capturing inputs of ParseArgs and ParseFile.",
+         "[ParseArgs][ParseFile][TraceWriter][correctness]") {
+
+  GIVEN("An `ArgumentMap` object with a trace writer.") {
+    std::stringstream trace;
+    TraceWriter writer{trace};
+    ArgumentMap argument_map{MakeParameters()};
+    argument_map.SetTraceWriter(&writer);
+    REQUIRE(argument_map.trace_writer() == &writer);
+
+    WHEN("Inputs are parsed, including invalid ones.") {
+      std::array<const char*, 3> argv{"command", "-f", "7"};
+      std::array<const char*, 2> invalid_argv{"command", "--unknown"};
+      std::stringstream config{"# comment\nkey=1 2\n"};
+      ParseArgs(argv.size(), argv.data(), argument_map);
+      CHECK_THROWS_AS(
+          ParseArgs(invalid_argv.size(), invalid_argv.data(), argument_map),
+          exceptions::ArgumentParsingError);
+      ParseFile(config, argument_map);
+
+      THEN("All inputs are captured.") {
+        TraceReader reader{trace};
+        TraceRecord record;
+        REQUIRE(reader.Next(record));
+        CHECK(record.kind == TraceRecordKind::kArguments);
+        CHECK(record.tokens == std::vector<std::string>{"command", "-f", "7"});
+        REQUIRE(reader.Next(record));
+        CHECK(record.tokens
+              == std::vector<std::string>{"command", "--unknown"});
+        REQUIRE(reader.Next(record));
+        CHECK(record.kind == TraceRecordKind::kFile);
+        CHECK(record.tokens
+              == std::vector<std::string>{"# comment", "key=1 2"});
+        CHECK_FALSE(reader.Next(record));
+      }
+    }
+
+    WHEN("Writing the trace fails.") {
+      // Without a buffer, every write fails.
+      struct FailingBuffer : std::streambuf {} failing_buffer;
+      trace.std::ios::rdbuf(&failing_buffer);
+      trace.exceptions(std::ios::badbit);
+      std::array<const char*, 3> argv{"command", "-f", "7"};
+      std::stringstream config{"key=1 2\n"};
+
+      THEN("Inputs are still parsed.") {
+        CHECK_NOTHROW(ParseArgs(argv.size(), argv.data(), argument_map));
+        CHECK_NOTHROW(ParseFile(config, argument_map));
+        CHECK(argument_map.GetValue<int>("pos") == 7);
+        CHECK(argument_map.GetAllValues<int>("key")
+              == std::vector<int>{1, 2});
+      }
+    }
+  }
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace arg_parse_convert